@@ -0,0 +1,89 @@
+#include <benchmark/benchmark.h>
+#include "ConcurrentArray.h"
+#include "ThreadPool.h"
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace oop;
+
+// Arguments {samples per producer, producers}
+static void ProducerCounts(benchmark::internal::Benchmark* b) {
+    int maxThreads = static_cast<int>(ThreadPool::defaultThreadCount());
+    for (int producers = 1; producers < 2 * maxThreads; producers *= 2) {
+        b->Args({1 << 18, std::min(producers, maxThreads)});
+    }
+}
+
+static void reportThroughput(benchmark::State& state) {
+    state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(1));
+    state.counters["producers"] = static_cast<double>(state.range(1));
+}
+
+// Starts the producers, each calling push(value) for its share of the samples, and waits for them
+template<typename Push>
+static void runProducers(int producers, int samples, Push push) {
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([=] {
+            for (int i = 0; i < samples; i++) push(p * samples + i);
+        });
+    }
+    for (std::thread& t : threads) t.join();
+}
+
+// The baseline: every producer appends to one DynamicArray under a mutex
+static void BM_MutexDynamicArrayPush(benchmark::State& state) {
+    int samples = static_cast<int>(state.range(0));
+    int producers = static_cast<int>(state.range(1));
+    for (auto _ : state) {
+        DynamicArray<int> a;
+        std::mutex mutex;
+        runProducers(producers, samples, [&](int value) {
+            std::lock_guard<std::mutex> lock(mutex);
+            a.push_back(value);
+        });
+        benchmark::DoNotOptimize(a.data());
+    }
+    reportThroughput(state);
+}
+BENCHMARK(BM_MutexDynamicArrayPush)->Apply(ProducerCounts)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+static void BM_ConcurrentArrayPush(benchmark::State& state) {
+    int samples = static_cast<int>(state.range(0));
+    int producers = static_cast<int>(state.range(1));
+    for (auto _ : state) {
+        ConcurrentArray<int> a;
+        runProducers(producers, samples, [&](int value) { a.push_back(value); });
+        benchmark::DoNotOptimize(a.size());
+    }
+    reportThroughput(state);
+}
+BENCHMARK(BM_ConcurrentArrayPush)->Apply(ProducerCounts)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// Same, with the segments allocated up front so that producers never race to allocate one
+static void BM_ConcurrentArrayPushReserved(benchmark::State& state) {
+    int samples = static_cast<int>(state.range(0));
+    int producers = static_cast<int>(state.range(1));
+    for (auto _ : state) {
+        ConcurrentArray<int> a(static_cast<std::size_t>(samples) * producers);
+        runProducers(producers, samples, [&](int value) { a.push_back(value); });
+        benchmark::DoNotOptimize(a.size());
+    }
+    reportThroughput(state);
+}
+BENCHMARK(BM_ConcurrentArrayPushReserved)->Apply(ProducerCounts)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+static void BM_ConcurrentArraySnapshot(benchmark::State& state) {
+    ConcurrentArray<int> a;
+    for (int i = 0; i < state.range(0); i++) a.push_back(i);
+    for (auto _ : state) {
+        DynamicArray<int> copy = a.snapshot();
+        benchmark::DoNotOptimize(copy.data());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(int));
+}
+BENCHMARK(BM_ConcurrentArraySnapshot)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
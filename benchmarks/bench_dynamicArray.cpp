@@ -0,0 +1,206 @@
+#include <benchmark/benchmark.h>
+#include "DynamicArray.h"
+
+#include <cstdint>
+#include <ostream>
+#include <streambuf>
+#include <utility>
+#include <vector>
+
+using namespace oop;
+
+// The same benchmarks run for the three array classes, from 16 elements (inline, cache resident) to 10^8 (400 MB)
+static void ArraySizes(benchmark::internal::Benchmark* b) {
+    b->RangeMultiplier(100)->Range(16, 100'000'000)->Unit(benchmark::kMicrosecond);
+}
+
+// Stream buffer that only counts characters, so operator<< is measured without growing a string
+class CountingBuffer : public std::streambuf {
+public:
+    std::size_t count = 0;
+
+protected:
+    int_type overflow(int_type c) override {
+        count++;
+        return c;
+    }
+
+    std::streamsize xsputn(const char*, std::streamsize n) override {
+        count += static_cast<std::size_t>(n);
+        return n;
+    }
+};
+
+// std::vector<int> has neither operator+ nor operator<<; these are the straightforward equivalents
+static std::vector<int> concat(const std::vector<int>& a, const std::vector<int>& b) {
+    std::vector<int> result;
+    result.reserve(a.size() + b.size());
+    result.insert(result.end(), a.begin(), a.end());
+    result.insert(result.end(), b.begin(), b.end());
+    return result;
+}
+
+template<typename A>
+static A concat(const A& a, const A& b) {
+    return A(a + b);
+}
+
+static std::ostream& print(std::ostream& os, const std::vector<int>& v) {
+    os << "[";
+    for (std::size_t i = 0; i < v.size(); i++) {
+        os << v[i];
+        if (i != v.size() - 1) os << ", ";
+    }
+    return os << "]";
+}
+
+template<typename A>
+static std::ostream& print(std::ostream& os, const A& a) {
+    return os << a;
+}
+
+template<typename A>
+static A makeArray(std::size_t n) {
+    A a(static_cast<int>(n));
+    for (std::size_t i = 0; i < n; i++) a[i] = static_cast<int>(i);
+    return a;
+}
+
+template<>
+DynamicArray<int> makeArray<DynamicArray<int>>(std::size_t n) {
+    DynamicArray<int> a(n, defaultInit);
+    for (std::size_t i = 0; i < n; i++) a[i] = static_cast<int>(i);
+    return a;
+}
+
+static void reportElements(benchmark::State& state) {
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(int));
+}
+
+template<typename A>
+static void BM_Construct(benchmark::State& state) {
+    for (auto _ : state) {
+        A a(static_cast<int>(state.range(0)));
+        benchmark::DoNotOptimize(a.data());
+    }
+    reportElements(state);
+}
+BENCHMARK_TEMPLATE(BM_Construct, DynamicArray<int>)->Apply(ArraySizes);
+BENCHMARK_TEMPLATE(BM_Construct, DynamicArrayVector)->Apply(ArraySizes);
+BENCHMARK_TEMPLATE(BM_Construct, std::vector<int>)->Apply(ArraySizes);
+
+template<typename A>
+static void BM_Copy(benchmark::State& state) {
+    A source = makeArray<A>(state.range(0));
+    for (auto _ : state) {
+        A copy(source);
+        benchmark::DoNotOptimize(copy.data());
+    }
+    reportElements(state);
+}
+BENCHMARK_TEMPLATE(BM_Copy, DynamicArray<int>)->Apply(ArraySizes);
+BENCHMARK_TEMPLATE(BM_Copy, DynamicArrayVector)->Apply(ArraySizes);
+BENCHMARK_TEMPLATE(BM_Copy, std::vector<int>)->Apply(ArraySizes);
+
+// A move there and back, which should cost the same at every size
+template<typename A>
+static void BM_Move(benchmark::State& state) {
+    A a = makeArray<A>(state.range(0));
+    for (auto _ : state) {
+        A b(std::move(a));
+        benchmark::DoNotOptimize(b.data());
+        a = std::move(b);
+        benchmark::DoNotOptimize(a.data());
+    }
+}
+BENCHMARK_TEMPLATE(BM_Move, DynamicArray<int>)->Apply(ArraySizes);
+BENCHMARK_TEMPLATE(BM_Move, DynamicArrayVector)->Apply(ArraySizes);
+BENCHMARK_TEMPLATE(BM_Move, std::vector<int>)->Apply(ArraySizes);
+
+// Concatenation of two arrays of range(0) / 2 elements
+template<typename A>
+static void BM_Concat(benchmark::State& state) {
+    A a = makeArray<A>(state.range(0) / 2);
+    A b = makeArray<A>(state.range(0) / 2);
+    for (auto _ : state) {
+        A c = concat(a, b);
+        benchmark::DoNotOptimize(c.data());
+    }
+    reportElements(state);
+}
+BENCHMARK_TEMPLATE(BM_Concat, DynamicArray<int>)->Apply(ArraySizes);
+BENCHMARK_TEMPLATE(BM_Concat, DynamicArrayVector)->Apply(ArraySizes);
+BENCHMARK_TEMPLATE(BM_Concat, std::vector<int>)->Apply(ArraySizes);
+
+// operator[] in order
+template<typename A>
+static void BM_IndexSequential(benchmark::State& state) {
+    A a = makeArray<A>(state.range(0));
+    int n = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        std::int64_t total = 0;
+        for (int i = 0; i < n; i++) total += a[i];
+        benchmark::DoNotOptimize(total);
+    }
+    reportElements(state);
+}
+BENCHMARK_TEMPLATE(BM_IndexSequential, DynamicArray<int>)->Apply(ArraySizes);
+BENCHMARK_TEMPLATE(BM_IndexSequential, DynamicArrayVector)->Apply(ArraySizes);
+BENCHMARK_TEMPLATE(BM_IndexSequential, std::vector<int>)->Apply(ArraySizes);
+
+// operator[] touching one element per 64-byte cache line
+template<typename A>
+static void BM_IndexStrided(benchmark::State& state) {
+    A a = makeArray<A>(state.range(0));
+    int n = static_cast<int>(state.range(0));
+    constexpr int stride = 64 / sizeof(int);
+    for (auto _ : state) {
+        std::int64_t total = 0;
+        for (int i = 0; i < n; i += stride) total += a[i];
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * ((state.range(0) + stride - 1) / stride));
+}
+BENCHMARK_TEMPLATE(BM_IndexStrided, DynamicArray<int>)->Apply(ArraySizes);
+BENCHMARK_TEMPLATE(BM_IndexStrided, DynamicArrayVector)->Apply(ArraySizes);
+BENCHMARK_TEMPLATE(BM_IndexStrided, std::vector<int>)->Apply(ArraySizes);
+
+// operator[] at pseudo-random positions: xorshift indices mapped to [0, n) with a multiply-shift
+template<typename A>
+static void BM_IndexRandom(benchmark::State& state) {
+    A a = makeArray<A>(state.range(0));
+    std::uint64_t n = static_cast<std::uint64_t>(state.range(0));
+    for (auto _ : state) {
+        std::uint32_t x = 2463534242u;
+        std::int64_t total = 0;
+        for (std::uint64_t i = 0; i < n; i++) {
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            total += a[static_cast<int>((std::uint64_t{x} * n) >> 32)];
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    reportElements(state);
+}
+BENCHMARK_TEMPLATE(BM_IndexRandom, DynamicArray<int>)->Apply(ArraySizes);
+BENCHMARK_TEMPLATE(BM_IndexRandom, DynamicArrayVector)->Apply(ArraySizes);
+BENCHMARK_TEMPLATE(BM_IndexRandom, std::vector<int>)->Apply(ArraySizes);
+
+template<typename A>
+static void BM_StreamOut(benchmark::State& state) {
+    A a = makeArray<A>(state.range(0));
+    CountingBuffer buffer;
+    std::ostream os(&buffer);
+    for (auto _ : state) {
+        print(os, a);
+    }
+    benchmark::DoNotOptimize(buffer.count);
+    reportElements(state);
+}
+BENCHMARK_TEMPLATE(BM_StreamOut, DynamicArray<int>)->Apply(ArraySizes);
+BENCHMARK_TEMPLATE(BM_StreamOut, DynamicArrayVector)->Apply(ArraySizes);
+BENCHMARK_TEMPLATE(BM_StreamOut, std::vector<int>)->Apply(ArraySizes);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,92 @@
+#include <benchmark/benchmark.h>
+#include "ParallelAlgorithms.h"
+
+#include <random>
+
+using namespace oop;
+
+// Arguments {elements, threads}: threads counts the calling thread, so 1 thread is the serial baseline
+static void ThreadCounts(benchmark::internal::Benchmark* b) {
+    int maxThreads = static_cast<int>(ThreadPool::defaultThreadCount());
+    for (int size : {1 << 22, 1 << 27}) {
+        for (int threads = 1; threads < 2 * maxThreads; threads *= 2) {
+            b->Args({size, std::min(threads, maxThreads)});
+        }
+    }
+}
+
+static DynamicArray<int> randomArray(std::size_t n) {
+    std::mt19937 rng(1);
+    DynamicArray<int> a(n, defaultInit);
+    for (int& value : a) {
+        value = static_cast<int>(rng());
+    }
+    return a;
+}
+
+static void reportThroughput(benchmark::State& state, std::size_t bytesPerElement) {
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * state.range(0) * bytesPerElement);
+    state.counters["threads"] = static_cast<double>(state.range(1));
+}
+
+static void BM_ParallelFill(benchmark::State& state) {
+    ThreadPool pool(static_cast<unsigned>(state.range(1) - 1));
+    DynamicArray<int> a(state.range(0), defaultInit);
+    for (auto _ : state) {
+        parallel::fill(a, 42, pool);
+        benchmark::ClobberMemory();
+    }
+    reportThroughput(state, sizeof(int));
+}
+BENCHMARK(BM_ParallelFill)->Apply(ThreadCounts)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+static void BM_ParallelCopy(benchmark::State& state) {
+    ThreadPool pool(static_cast<unsigned>(state.range(1) - 1));
+    DynamicArray<int> a(state.range(0), 1);
+    DynamicArray<int> b(state.range(0), defaultInit);
+    for (auto _ : state) {
+        parallel::copy(a, b, pool);
+        benchmark::ClobberMemory();
+    }
+    reportThroughput(state, 2 * sizeof(int));
+}
+BENCHMARK(BM_ParallelCopy)->Apply(ThreadCounts)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+static void BM_ParallelTransform(benchmark::State& state) {
+    ThreadPool pool(static_cast<unsigned>(state.range(1) - 1));
+    DynamicArray<int> a = randomArray(state.range(0));
+    DynamicArray<int> b(state.range(0), defaultInit);
+    for (auto _ : state) {
+        parallel::transform(a, b, [](int x) { return x * 3 + 1; }, pool);
+        benchmark::ClobberMemory();
+    }
+    reportThroughput(state, 2 * sizeof(int));
+}
+BENCHMARK(BM_ParallelTransform)->Apply(ThreadCounts)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+static void BM_ParallelSum(benchmark::State& state) {
+    ThreadPool pool(static_cast<unsigned>(state.range(1) - 1));
+    DynamicArray<int> a = randomArray(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(parallel::sum(a, pool));
+    }
+    reportThroughput(state, sizeof(int));
+}
+BENCHMARK(BM_ParallelSum)->Apply(ThreadCounts)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+static void BM_ParallelSort(benchmark::State& state) {
+    ThreadPool pool(static_cast<unsigned>(state.range(1) - 1));
+    DynamicArray<int> original = randomArray(state.range(0));
+    DynamicArray<int> a(state.range(0), defaultInit);
+    for (auto _ : state) {
+        state.PauseTiming();
+        parallel::copy(original, a, pool);
+        state.ResumeTiming();
+        parallel::sort(a, std::less<>(), pool);
+    }
+    reportThroughput(state, sizeof(int));
+}
+BENCHMARK(BM_ParallelSort)->Apply(ThreadCounts)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
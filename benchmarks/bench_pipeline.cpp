@@ -0,0 +1,87 @@
+#include <benchmark/benchmark.h>
+#include "Pipeline.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace oop;
+
+static constexpr std::size_t studentCount = 1'000'000;
+
+static const std::vector<CourseCatalog::Id>& courseIds() {
+    static const std::vector<CourseCatalog::Id> ids = [] {
+        std::vector<CourseCatalog::Id> result;
+        for (int year = 2020; year < 2025; year++) {
+            result.push_back(CourseCatalog::global().intern("Math", year));
+            result.push_back(CourseCatalog::global().intern("Physics", year));
+        }
+        return result;
+    }();
+    return ids;
+}
+
+// Arguments {threads}: threads counts the calling thread, so 1 thread runs every stage in turn on one core
+static void ThreadCounts(benchmark::internal::Benchmark* b) {
+    int maxThreads = static_cast<int>(ThreadPool::defaultThreadCount());
+    for (int threads = 1; threads < 2 * maxThreads; threads *= 2) {
+        b->Arg(std::min(threads, maxThreads));
+    }
+}
+
+// The nightly job as it was: one full pass over memory per step
+static void BM_SeparatePasses(benchmark::State& state) {
+    for (auto _ : state) {
+        std::vector<StudentRecord> records;
+        records.reserve(studentCount);
+        Random random(42);
+        for (std::size_t i = 0; i < studentCount; i++) {
+            records.push_back(StudentRecord{"Student", random.getInt(18, 25), random.getDouble(0.0, 10.0)});
+        }
+        std::vector<Student> students;
+        students.reserve(records.size());
+        for (const StudentRecord& r : records) {
+            if (Student::isValidName(r.name) && Student::isValidAge(r.age) && Student::isValidGrade(r.grade)) {
+                students.emplace_back(r.name, r.age, r.grade);
+            }
+        }
+        for (Student& s : students) {
+            s.enroll(courseIds()[random.getInt(0, static_cast<int>(courseIds().size()) - 1)]);
+            s.enroll(courseIds()[random.getInt(0, static_cast<int>(courseIds().size()) - 1)]);
+        }
+        GradeSummary summary;
+        for (const Student& s : students) {
+            summary.count++;
+            summary.sum += s.getGrade();
+            summary.enrollments += s.getCourseIds().size();
+        }
+        benchmark::DoNotOptimize(summary.sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(studentCount));
+}
+BENCHMARK(BM_SeparatePasses)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// The same steps as overlapping stages; with more threads validation runs on several workers
+static void BM_Pipeline(benchmark::State& state) {
+    unsigned threads = static_cast<unsigned>(state.range(0));
+    std::size_t validators = std::max(1u, threads / 2);
+    ThreadPool pool(threads - 1);
+    for (auto _ : state) {
+        Pipeline pipeline(pool);
+        auto& raw = pipeline.channel<StudentRecord>(256);
+        auto& valid = pipeline.channel<Student>(256, validators);
+        auto& enrolled = pipeline.channel<Student>(256);
+        GradeSummary summary;
+        pipeline.add("generate", [&](StageStats& s) { return stages::generate(raw, studentCount, 42, s); });
+        for (std::size_t v = 0; v < validators; v++) {
+            pipeline.add("validate", [&](StageStats& s) { return stages::validate(raw, valid, s); });
+        }
+        pipeline.add("enroll", [&](StageStats& s) { return stages::enroll(valid, enrolled, courseIds(), 2, 7, s); });
+        pipeline.add("aggregate", [&](StageStats& s) { return stages::aggregate(enrolled, summary, s); });
+        pipeline.run();
+        benchmark::DoNotOptimize(summary.sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(studentCount));
+}
+BENCHMARK(BM_Pipeline)->Apply(ThreadCounts)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
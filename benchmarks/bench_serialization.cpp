@@ -0,0 +1,78 @@
+#include <benchmark/benchmark.h>
+#include "ArraySerialization.h"
+
+#include <random>
+#include <sstream>
+
+using namespace oop;
+
+static DynamicArray<int> randomArray(std::size_t n) {
+    std::mt19937 rng(1);
+    DynamicArray<int> a(n, defaultInit);
+    for (int& value : a) {
+        value = static_cast<int>(rng());
+    }
+    return a;
+}
+
+// Baseline: operator<< inserts one element and one separator at a time
+static void BM_StreamOperator(benchmark::State& state) {
+    DynamicArray<int> a = randomArray(state.range(0));
+    std::ostringstream os;
+    for (auto _ : state) {
+        os.str("");
+        os << a;
+        benchmark::DoNotOptimize(os.tellp());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StreamOperator)->Range(1 << 10, 1 << 22)->Unit(benchmark::kMicrosecond);
+
+static void BM_FormatterWrite(benchmark::State& state) {
+    DynamicArray<int> a = randomArray(state.range(0));
+    ArrayFormatter formatter;
+    std::ostringstream os;
+    for (auto _ : state) {
+        os.str("");
+        formatter.write(os, a);
+        benchmark::DoNotOptimize(os.tellp());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FormatterWrite)->Range(1 << 10, 1 << 22)->Unit(benchmark::kMicrosecond);
+
+static void BM_FormatterFormat(benchmark::State& state) {
+    DynamicArray<int> a = randomArray(state.range(0));
+    ArrayFormatter formatter;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(formatter.format(a).data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FormatterFormat)->Range(1 << 10, 1 << 22)->Unit(benchmark::kMicrosecond);
+
+static void BM_ParseArray(benchmark::State& state) {
+    std::string text = formatArray(randomArray(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(parseArray<int>(text).data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_ParseArray)->Range(1 << 10, 1 << 22)->Unit(benchmark::kMicrosecond);
+
+static void BM_BinarySaveLoad(benchmark::State& state) {
+    DynamicArray<int> a = randomArray(state.range(0));
+    std::stringstream ss;
+    for (auto _ : state) {
+        ss.str("");
+        ss.clear();
+        save(ss, a);
+        benchmark::DoNotOptimize(load<int>(ss).data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * state.range(0) * 2 * sizeof(int));
+}
+BENCHMARK(BM_BinarySaveLoad)->Range(1 << 10, 1 << 22)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
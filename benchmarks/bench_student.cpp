@@ -0,0 +1,125 @@
+#include <benchmark/benchmark.h>
+#include "GradeStats.h"
+#include "Student.h"
+
+#include <algorithm>
+#include <optional>
+#include <vector>
+
+using namespace oop;
+
+static std::vector<Student> randomStudents(std::size_t n) {
+    Random random(1);
+    std::vector<Student> students(n);
+    for (Student& student : students) student.randomize(random);
+    return students;
+}
+
+// Default construction draws a random name, age and grade
+static void BM_StudentDefaultConstruct(benchmark::State& state) {
+    for (auto _ : state) {
+        Student student;
+        benchmark::DoNotOptimize(&student);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StudentDefaultConstruct);
+
+// Construction from a name interns it; after the first call this is a lookup
+static void BM_StudentNamedConstruct(benchmark::State& state) {
+    for (auto _ : state) {
+        Student student("Alice", 20, 8.0);
+        benchmark::DoNotOptimize(&student);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StudentNamedConstruct);
+
+static void BM_StudentVectorConstruct(benchmark::State& state) {
+    for (auto _ : state) {
+        std::vector<Student> students(state.range(0));
+        benchmark::DoNotOptimize(students.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StudentVectorConstruct)->Range(16, 1 << 20)->Unit(benchmark::kMicrosecond);
+
+// getAge, getGrade and getName over an array of students
+static void BM_StudentGetters(benchmark::State& state) {
+    std::vector<Student> students = randomStudents(state.range(0));
+    for (auto _ : state) {
+        double total = 0;
+        std::size_t nameLength = 0;
+        for (const Student& student : students) {
+            total += student.getAge() + student.getGrade();
+            nameLength += student.getName().size();
+        }
+        benchmark::DoNotOptimize(total);
+        benchmark::DoNotOptimize(nameLength);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StudentGetters)->Range(16, 1 << 20)->Unit(benchmark::kMicrosecond);
+
+// compareGrade of every neighbour pair
+static void BM_CompareGrade(benchmark::State& state) {
+    std::vector<Student> students = randomStudents(state.range(0));
+    for (auto _ : state) {
+        std::size_t greater = 0;
+        for (std::size_t i = 1; i < students.size(); i++) greater += compareGrade(students[i - 1], students[i]);
+        benchmark::DoNotOptimize(greater);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CompareGrade)->Range(16, 1 << 20)->Unit(benchmark::kMicrosecond);
+
+// compareGrade as the comparator of a sort of student pointers
+static void BM_SortByGrade(benchmark::State& state) {
+    std::vector<Student> students = randomStudents(state.range(0));
+    std::vector<const Student*> order(students.size());
+    for (auto _ : state) {
+        state.PauseTiming();
+        for (std::size_t i = 0; i < students.size(); i++) order[i] = &students[i];
+        state.ResumeTiming();
+        std::sort(order.begin(), order.end(), [](const Student* a, const Student* b) { return compareGrade(*a, *b); });
+        benchmark::DoNotOptimize(order.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SortByGrade)->Range(1 << 10, 1 << 20)->Unit(benchmark::kMicrosecond);
+
+// setGrade with and without a GradeStats registered (argument 1 or 0)
+static void BM_SetGrade(benchmark::State& state) {
+    std::vector<Student> students = randomStudents(1 << 16);
+    std::optional<GradeStats> stats;
+    if (state.range(0) != 0) stats.emplace();
+    std::size_t i = 0;
+    for (auto _ : state) {
+        students[i & 0xFFFF].setGrade(static_cast<double>(i % 11));
+        i++;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SetGrade)->Arg(0)->Arg(1);
+
+// Mean and variance by scanning the students against a read of the incremental statistics
+static void BM_GradeVarianceScan(benchmark::State& state) {
+    std::vector<Student> students = randomStudents(state.range(0));
+    for (auto _ : state) {
+        GradeMoments moments;
+        for (const Student& student : students) moments.add(student.getGrade());
+        benchmark::DoNotOptimize(moments.variance());
+    }
+}
+BENCHMARK(BM_GradeVarianceScan)->Range(1 << 10, 1 << 20)->Unit(benchmark::kMicrosecond);
+
+static void BM_GradeStatsSnapshot(benchmark::State& state) {
+    GradeStats stats;
+    std::vector<Student> students = randomStudents(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(stats.snapshot().variance());
+    }
+}
+BENCHMARK(BM_GradeStatsSnapshot)->Range(1 << 10, 1 << 20)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+#include "StudentLoader.h"
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+
+using namespace oop;
+
+// About 64 MiB of name,age,grade rows with one bad row in a thousand, written once per run
+static const std::filesystem::path& csvFile() {
+    static const std::filesystem::path path = [] {
+        std::filesystem::path p = std::filesystem::temp_directory_path() / "oop_bench_students.csv";
+        std::ofstream file(p, std::ios::trunc);
+        std::mt19937 rng(1);
+        const char* names[] = {"Rodrigo", "Ricardo", "Andres", "Raul", "Maria", "Lucia"};
+        file << "name,age,grade\n";
+        for (int i = 0; i < 3'000'000; i++) {
+            file << names[rng() % 6] << i % 1000 << ',' << 18 + rng() % 10 << ',';
+            file << (i % 1000 == 0 ? std::string("n/a") : std::to_string((rng() % 1000) / 100.0)) << '\n';
+        }
+        return p;
+    }();
+    return path;
+}
+
+// Arguments {threads}: threads counts the calling thread, so 1 thread is the single-core rate
+static void ThreadCounts(benchmark::internal::Benchmark* b) {
+    int maxThreads = static_cast<int>(ThreadPool::defaultThreadCount());
+    for (int threads = 1; threads < 2 * maxThreads; threads *= 2) {
+        b->Arg(std::min(threads, maxThreads));
+    }
+}
+
+// Parsing and validation only: the rows are counted, not stored
+static void BM_LoadCsvColumns(benchmark::State& state) {
+    ThreadPool pool(static_cast<unsigned>(state.range(0) - 1));
+    StudentLoader loader(csvFile());
+    for (auto _ : state) {
+        std::size_t rows = 0;
+        RejectionReport report = loader.forEachBatch([&](const StudentColumns& batch) { rows += batch.size(); }, pool);
+        benchmark::DoNotOptimize(rows);
+        benchmark::DoNotOptimize(report.rejected());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(loader.bytes()));
+}
+BENCHMARK(BM_LoadCsvColumns)->Apply(ThreadCounts)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+static void BM_LoadCsvTable(benchmark::State& state) {
+    ThreadPool pool(static_cast<unsigned>(state.range(0) - 1));
+    StudentLoader loader(csvFile());
+    for (auto _ : state) {
+        StudentTable table;
+        loader.load(table, pool);
+        benchmark::DoNotOptimize(table.getAges().data());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(loader.bytes()));
+}
+BENCHMARK(BM_LoadCsvTable)->Apply(ThreadCounts)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+static void BM_LoadCsvStudents(benchmark::State& state) {
+    ThreadPool pool(static_cast<unsigned>(state.range(0) - 1));
+    StudentLoader loader(csvFile());
+    for (auto _ : state) {
+        std::vector<Student> students;
+        loader.load(students, pool);
+        benchmark::DoNotOptimize(students.data());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(loader.bytes()));
+}
+BENCHMARK(BM_LoadCsvStudents)->Arg(1)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,102 @@
+#include <benchmark/benchmark.h>
+#include "StudentTable.h"
+
+#include <fstream>
+#include <random>
+#include <vector>
+
+using namespace oop;
+
+static std::vector<Student> randomStudents(std::size_t n) {
+    std::mt19937 rng(1);
+    const char* names[] = {"Rodrigo", "Ricardo", "Andres", "Raul"};
+    std::vector<Student> students;
+    students.reserve(n);
+    for (std::size_t i = 0; i < n; i++) {
+        students.emplace_back(names[rng() % 4], 18 + static_cast<int>(rng() % 8), (rng() % 1001) / 100.0);
+    }
+    return students;
+}
+
+// Baseline: average grade over an array of Student objects
+static void BM_StudentVectorAverage(benchmark::State& state) {
+    std::vector<Student> students = randomStudents(state.range(0));
+    for (auto _ : state) {
+        double total = 0;
+        for (const Student& student : students) total += student.getGrade();
+        benchmark::DoNotOptimize(total / students.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StudentVectorAverage)->Range(1 << 16, 1 << 22)->Unit(benchmark::kMicrosecond);
+
+static void BM_StudentTableAverage(benchmark::State& state) {
+    StudentTable table(randomStudents(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(table.averageGrade());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StudentTableAverage)->Range(1 << 16, 1 << 22)->Unit(benchmark::kMicrosecond);
+
+// Baseline: count of students aged 20 to 23 over an array of Student objects
+static void BM_StudentVectorAgeRange(benchmark::State& state) {
+    std::vector<Student> students = randomStudents(state.range(0));
+    for (auto _ : state) {
+        std::size_t count = 0;
+        for (const Student& student : students) count += student.getAge() >= 20 && student.getAge() <= 23;
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StudentVectorAgeRange)->Range(1 << 16, 1 << 22)->Unit(benchmark::kMicrosecond);
+
+static void BM_StudentTableAgeRange(benchmark::State& state) {
+    StudentTable table(randomStudents(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(table.countAgeInRange(20, 23));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StudentTableAgeRange)->Range(1 << 16, 1 << 22)->Unit(benchmark::kMicrosecond);
+
+// A million age updates, one in ten invalid, with diagnostics going to /dev/null
+static void updates(std::size_t n, std::size_t rows, std::vector<std::size_t>& indices, std::vector<int>& ages) {
+    std::mt19937 rng(2);
+    for (std::size_t i = 0; i < n; i++) {
+        indices.push_back(rng() % rows);
+        ages.push_back(i % 10 == 0 ? -1 : 18 + static_cast<int>(rng() % 8));
+    }
+}
+
+// Arguments {flush each message, messages per second (0 for no limit)}
+static void BM_StudentTableSetAgeOneByOne(benchmark::State& state) {
+    StudentTable table(randomStudents(1 << 16));
+    std::vector<std::size_t> indices;
+    std::vector<int> ages;
+    updates(1'000'000, table.size(), indices, ages);
+    std::ofstream devNull("/dev/null");
+    DiagnosticsSink::global().configure(devNull, state.range(0) != 0, static_cast<std::size_t>(state.range(1)));
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < indices.size(); i++) table[indices[i]].setAge(ages[i]);
+        benchmark::DoNotOptimize(table.getAges().data());
+    }
+    DiagnosticsSink::global().configure(std::cerr, true);
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(indices.size()));
+}
+BENCHMARK(BM_StudentTableSetAgeOneByOne)->Args({1, 0})->Args({0, 0})->Args({0, 100})->Unit(benchmark::kMillisecond);
+
+static void BM_StudentTableSetAgesBatch(benchmark::State& state) {
+    StudentTable table(randomStudents(1 << 16));
+    std::vector<std::size_t> indices;
+    std::vector<int> ages;
+    updates(1'000'000, table.size(), indices, ages);
+    for (auto _ : state) {
+        UpdateReport report = table.setAges(indices, ages);
+        benchmark::DoNotOptimize(report.refused());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(indices.size()));
+}
+BENCHMARK(BM_StudentTableSetAgesBatch)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
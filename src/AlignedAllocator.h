@@ -0,0 +1,66 @@
+/**
+ * @file AlignedAllocator.h
+ * @brief Declaration of the AlignedAllocator class, the default allocator of DynamicArray.
+ */
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+namespace oop{
+
+    /**
+     * @brief Alignment of the heap memory of DynamicArray: one cache line, enough for aligned AVX-512 loads.
+     */
+    inline constexpr std::size_t cacheLineSize = 64;
+
+    /**
+     * @class AlignedAllocator
+     * @brief Standard allocator that returns memory aligned to Alignment bytes.
+     * @tparam T Type of the allocated elements.
+     * @tparam Alignment Alignment of every allocation (at least alignof(T)).
+     */
+    template<typename T, std::size_t Alignment = cacheLineSize>
+    class AlignedAllocator{
+    public:
+        using value_type = T;
+        using is_always_equal = std::true_type;
+
+        static constexpr std::size_t alignment = Alignment < alignof(T) ? alignof(T) : Alignment;
+
+        static_assert((Alignment & (Alignment - 1)) == 0, "alignment must be a power of two");
+
+        template<typename U>
+        struct rebind{
+            using other = AlignedAllocator<U, Alignment>;
+        };
+
+        AlignedAllocator() = default;
+
+        template<typename U>
+        AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+        /**
+         * @brief Allocates uninitialized memory for n elements.
+         * @param n Number of elements.
+         * @return Pointer aligned to alignment bytes.
+         */
+        T* allocate(std::size_t n){
+            return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{alignment}));
+        }
+
+        /**
+         * @brief Releases memory returned by allocate().
+         * @param p Pointer returned by allocate().
+         * @param n Number of elements passed to allocate().
+         */
+        void deallocate(T* p, std::size_t n) noexcept {
+            ::operator delete(p, n * sizeof(T), std::align_val_t{alignment});
+        }
+
+        template<typename U>
+        bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+    };
+
+}
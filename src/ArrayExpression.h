@@ -0,0 +1,208 @@
+/**
+ * @file ArrayExpression.h
+ * @brief Lazy concatenation expressions used by operator+ of the dynamic array classes.
+ */
+#pragma once
+
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace oop{
+
+    /**
+     * @brief Marks the types that can be concatenated with operator+.
+     *
+     * Array classes opt in by specializing this variable to true. A concat operand has a value_type,
+     * a size() and either contiguous storage (data()) or a forEachSegment(f) member.
+     */
+    template<typename T>
+    inline constexpr bool isConcatOperand = false;
+
+    /**
+     * @brief Marks the lazy expression nodes, which only become arrays when they are materialized.
+     */
+    template<typename T>
+    inline constexpr bool isLazyExpression = false;
+
+    /**
+     * @brief Any type that can appear as an operand of operator+.
+     */
+    template<typename T>
+    concept ArrayExpression = isConcatOperand<std::remove_cvref_t<T>>;
+
+    /**
+     * @brief A lazy expression node (the result of operator+ before it is assigned to an array).
+     */
+    template<typename T>
+    concept LazyArrayExpression = isLazyExpression<std::remove_cvref_t<T>>;
+
+    /**
+     * @brief Two array expressions with the same element type, which operator+ can concatenate.
+     *
+     * Overloads of operator+ for particular operands (such as two StaticArray) add their own requirement
+     * to this concept, so that they are more constrained than the lazy operator+ and win overload resolution.
+     */
+    template<typename L, typename R>
+    concept ConcatenableExpressions = ArrayExpression<L> && ArrayExpression<R>
+        && std::is_same_v<typename std::remove_cvref_t<L>::value_type, typename std::remove_cvref_t<R>::value_type>;
+
+    namespace detail{
+
+        // Calls f(first, last) for every contiguous run of elements of e, in order
+        template<typename E, typename F>
+        void forEachSegment(const E& e, F&& f){
+            if constexpr (requires { e.forEachSegment(f); }){
+                e.forEachSegment(f);
+            } else {
+                f(e.data(), e.data() + e.size());
+            }
+        }
+
+        // Reads element i of e without requiring a const operator[] on the leaves
+        template<typename E>
+        decltype(auto) elementAt(const E& e, std::size_t i){
+            if constexpr (requires { e.data(); }){
+                return e.data()[i];
+            } else {
+                return e[i];
+            }
+        }
+
+        // Operands that are lvalues are referenced, temporaries are moved into the node so they cannot dangle
+        template<typename E>
+        using ExpressionStorage = std::conditional_t<std::is_lvalue_reference_v<E>,
+                                                     const std::remove_reference_t<E>&,
+                                                     std::remove_cvref_t<E>>;
+    }
+
+    /**
+     * @class ConcatExpr
+     * @brief Lazy concatenation of two array expressions returned by operator+.
+     * @tparam L Left operand (a reference for lvalues, a value for temporaries).
+     * @tparam R Right operand (a reference for lvalues, a value for temporaries).
+     *
+     * No memory is allocated while a chain such as a + b + c + d is built: the node only remembers its
+     * operands. Assigning it to an array allocates once at the exact final size, and iterating or
+     * streaming it reads the operands directly.
+     */
+    template<typename L, typename R>
+    class ConcatExpr{
+    public:
+        using value_type = typename std::remove_cvref_t<L>::value_type;
+        using size_type = std::size_t;
+
+    private:
+        L left; /**< first operand of the concatenation. */
+        R right; /**< second operand of the concatenation. */
+
+    public:
+        /**
+         * @class const_iterator
+         * @brief Read-only iterator over the elements of the concatenation.
+         */
+        class const_iterator{
+            const ConcatExpr* expr = nullptr;
+            size_type index = 0;
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = typename ConcatExpr::value_type;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const value_type*;
+            using reference = const value_type&;
+
+            const_iterator() = default;
+            const_iterator(const ConcatExpr* expr, size_type index) : expr(expr), index(index){}
+
+            reference operator*() const { return (*expr)[index]; }
+            const_iterator& operator++(){ ++index; return *this; }
+            const_iterator operator++(int){ const_iterator old = *this; ++index; return old; }
+            bool operator==(const const_iterator& other) const { return index == other.index; }
+        };
+
+        /**
+         * @brief Constructor that takes both operands of the concatenation
+         * @param left First operand.
+         * @param right Second operand.
+         */
+        template<typename A, typename B>
+        ConcatExpr(A&& left, B&& right) : left(std::forward<A>(left)), right(std::forward<B>(right)){}
+
+        /**
+         * @brief Returns the size of the concatenation.
+         * @return The sum of the sizes of both operands.
+         */
+        size_type size() const {
+            return static_cast<size_type>(left.size()) + static_cast<size_type>(right.size());
+        }
+
+        /**
+         * @brief Reads the element at index without materializing the concatenation.
+         * @param index Index of the element.
+         * @return Const reference to the element inside the operand that holds it.
+         */
+        const value_type& operator[](size_type index) const {
+            size_type leftSize = left.size();
+            return index < leftSize ? detail::elementAt(left, index) : detail::elementAt(right, index - leftSize);
+        }
+
+        /**
+         * @brief Calls f(first, last) for every contiguous run of elements, left to right.
+         * @param f Callable taking two const value_type pointers.
+         */
+        template<typename F>
+        void forEachSegment(F&& f) const {
+            detail::forEachSegment(left, f);
+            detail::forEachSegment(right, f);
+        }
+
+        /** @brief Iterator to the first element. */
+        const_iterator begin() const { return const_iterator(this, 0); }
+        /** @brief Iterator past the last element. */
+        const_iterator end() const { return const_iterator(this, size()); }
+
+        /**
+         * @brief Streams the concatenation in the same [a, b, c] form as the arrays, without materializing it.
+         * @param os Output stream object.
+         * @param expr Concatenation to be printed.
+         * @return Output stream object.
+         */
+        friend std::ostream& operator<<(std::ostream& os, const ConcatExpr& expr) {
+            os << "[";
+            bool first = true;
+            expr.forEachSegment([&](const value_type* it, const value_type* last){
+                for(; it != last; ++it){
+                    if (!first){
+                        os << ", ";
+                    }
+                    os << *it;
+                    first = false;
+                }
+            });
+            os << "]";
+            return os;
+        }
+    };
+
+    template<typename L, typename R>
+    inline constexpr bool isConcatOperand<ConcatExpr<L, R>> = true;
+
+    template<typename L, typename R>
+    inline constexpr bool isLazyExpression<ConcatExpr<L, R>> = true;
+
+    /**
+     * @brief Addition operator to concatenate two arrays lazily
+     * @param left The first array expression.
+     * @param right The second array expression.
+     * @return A ConcatExpr that is turned into an array with a single allocation when assigned.
+     */
+    template<typename L, typename R>
+        requires ConcatenableExpressions<L, R>
+    ConcatExpr<detail::ExpressionStorage<L>, detail::ExpressionStorage<R>> operator+(L&& left, R&& right){
+        return {std::forward<L>(left), std::forward<R>(right)};
+    }
+
+}
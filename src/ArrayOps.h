@@ -0,0 +1,688 @@
+/**
+ * @file ArrayOps.h
+ * @brief Vectorized reductions and element-wise arithmetic over DynamicArray and DynamicArrayVector.
+ *
+ * Arrays of int use SSE2 or AVX2 kernels chosen at runtime from the features of the CPU, with a scalar
+ * fallback on other processors and compilers. Arrays of other arithmetic types use plain loops.
+ */
+#pragma once
+
+#include "DynamicArray.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define OOP_SIMD_X86 1
+#include <immintrin.h>
+#define OOP_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define OOP_SIMD_X86 0
+#endif
+
+namespace oop{
+
+    /**
+     * @namespace oop::simd
+     * @brief Kernels over contiguous int32 buffers and the runtime selection between them.
+     */
+    namespace simd{
+
+        /**
+         * @brief Instruction sets the kernels are implemented for.
+         */
+        enum class Isa { Scalar, Sse2, Avx2 };
+
+        /**
+         * @struct Int32Kernels
+         * @brief Table of kernels over int32 buffers for one instruction set.
+         */
+        struct Int32Kernels{
+            Isa isa;
+            std::int64_t (*sum)(const std::int32_t* a, std::size_t n);
+            std::int32_t (*min)(const std::int32_t* a, std::size_t n);
+            std::int32_t (*max)(const std::int32_t* a, std::size_t n);
+            std::int64_t (*dot)(const std::int32_t* a, const std::int32_t* b, std::size_t n);
+            std::size_t (*count)(const std::int32_t* a, std::size_t n, std::int32_t value);
+            void (*add)(const std::int32_t* a, const std::int32_t* b, std::int32_t* out, std::size_t n);
+            void (*subtract)(const std::int32_t* a, const std::int32_t* b, std::int32_t* out, std::size_t n);
+            void (*multiply)(const std::int32_t* a, const std::int32_t* b, std::int32_t* out, std::size_t n);
+            void (*addScalar)(const std::int32_t* a, std::int32_t value, std::int32_t* out, std::size_t n);
+            void (*subtractScalar)(const std::int32_t* a, std::int32_t value, std::int32_t* out, std::size_t n);
+            void (*multiplyScalar)(const std::int32_t* a, std::int32_t value, std::int32_t* out, std::size_t n);
+            void (*fill)(std::int32_t* out, std::size_t n, std::int32_t value);
+        };
+
+        namespace scalar{
+
+            // Integer overflow wraps like the SIMD instructions do, so the arithmetic is done unsigned
+            inline std::int32_t wrap(std::uint32_t value){ return static_cast<std::int32_t>(value); }
+
+            inline std::int64_t sum(const std::int32_t* a, std::size_t n){
+                std::int64_t total = 0;
+                for(std::size_t i = 0; i < n; i++) total += a[i];
+                return total;
+            }
+
+            inline std::int32_t min(const std::int32_t* a, std::size_t n){
+                std::int32_t result = std::numeric_limits<std::int32_t>::max();
+                for(std::size_t i = 0; i < n; i++) result = a[i] < result ? a[i] : result;
+                return result;
+            }
+
+            inline std::int32_t max(const std::int32_t* a, std::size_t n){
+                std::int32_t result = std::numeric_limits<std::int32_t>::min();
+                for(std::size_t i = 0; i < n; i++) result = a[i] > result ? a[i] : result;
+                return result;
+            }
+
+            inline std::int64_t dot(const std::int32_t* a, const std::int32_t* b, std::size_t n){
+                std::int64_t total = 0;
+                for(std::size_t i = 0; i < n; i++) total += std::int64_t{a[i]} * b[i];
+                return total;
+            }
+
+            inline std::size_t count(const std::int32_t* a, std::size_t n, std::int32_t value){
+                std::size_t total = 0;
+                for(std::size_t i = 0; i < n; i++) total += a[i] == value;
+                return total;
+            }
+
+            inline void add(const std::int32_t* a, const std::int32_t* b, std::int32_t* out, std::size_t n){
+                for(std::size_t i = 0; i < n; i++) out[i] = wrap(std::uint32_t(a[i]) + std::uint32_t(b[i]));
+            }
+
+            inline void subtract(const std::int32_t* a, const std::int32_t* b, std::int32_t* out, std::size_t n){
+                for(std::size_t i = 0; i < n; i++) out[i] = wrap(std::uint32_t(a[i]) - std::uint32_t(b[i]));
+            }
+
+            inline void multiply(const std::int32_t* a, const std::int32_t* b, std::int32_t* out, std::size_t n){
+                for(std::size_t i = 0; i < n; i++) out[i] = wrap(std::uint32_t(a[i]) * std::uint32_t(b[i]));
+            }
+
+            inline void addScalar(const std::int32_t* a, std::int32_t value, std::int32_t* out, std::size_t n){
+                for(std::size_t i = 0; i < n; i++) out[i] = wrap(std::uint32_t(a[i]) + std::uint32_t(value));
+            }
+
+            inline void subtractScalar(const std::int32_t* a, std::int32_t value, std::int32_t* out, std::size_t n){
+                for(std::size_t i = 0; i < n; i++) out[i] = wrap(std::uint32_t(a[i]) - std::uint32_t(value));
+            }
+
+            inline void multiplyScalar(const std::int32_t* a, std::int32_t value, std::int32_t* out, std::size_t n){
+                for(std::size_t i = 0; i < n; i++) out[i] = wrap(std::uint32_t(a[i]) * std::uint32_t(value));
+            }
+
+            inline void fill(std::int32_t* out, std::size_t n, std::int32_t value){
+                for(std::size_t i = 0; i < n; i++) out[i] = value;
+            }
+
+            inline constexpr Int32Kernels kernels{Isa::Scalar, sum, min, max, dot, count, add, subtract, multiply,
+                                                  addScalar, subtractScalar, multiplyScalar, fill};
+        }
+
+#if OOP_SIMD_X86
+        // Number of leading elements to process one by one so that p + result is aligned to Width bytes
+        template<std::size_t Width>
+        std::size_t headLength(const void* p, std::size_t n){
+            std::size_t misalignment = reinterpret_cast<std::uintptr_t>(p) % Width;
+            std::size_t head = misalignment == 0 ? 0 : (Width - misalignment) / sizeof(std::int32_t);
+            return (reinterpret_cast<std::uintptr_t>(p) % sizeof(std::int32_t)) != 0 ? n : std::min(head, n);
+        }
+
+        namespace sse2{
+
+            // Sign-extends the four int32 lanes of v and adds them to the two int64 lanes of acc
+            inline __m128i addWidened(__m128i acc, __m128i v){
+                __m128i sign = _mm_srai_epi32(v, 31);
+                acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(v, sign));
+                return _mm_add_epi64(acc, _mm_unpackhi_epi32(v, sign));
+            }
+
+            inline std::int64_t horizontalSum64(__m128i v){
+                alignas(16) std::int64_t lanes[2];
+                _mm_store_si128(reinterpret_cast<__m128i*>(lanes), v);
+                return lanes[0] + lanes[1];
+            }
+
+            // SSE2 has no signed 32-bit min/max, so they are built from a compare and a select
+            inline __m128i select(__m128i mask, __m128i a, __m128i b){
+                return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+            }
+
+            // Low 32 bits of the lane-wise product (pmulld is SSE4.1)
+            inline __m128i mullo(__m128i a, __m128i b){
+                __m128i even = _mm_mul_epu32(a, b);
+                __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+                return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                                          _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+            }
+
+            // Signed 64-bit products of the even lanes, from the unsigned multiply and a sign correction
+            inline __m128i mulEvenSigned(__m128i a, __m128i b){
+                __m128i product = _mm_mul_epu32(a, b);
+                __m128i correction = _mm_add_epi32(_mm_and_si128(_mm_srai_epi32(a, 31), b),
+                                                   _mm_and_si128(_mm_srai_epi32(b, 31), a));
+                return _mm_sub_epi64(product, _mm_slli_epi64(correction, 32));
+            }
+
+            inline std::int64_t sum(const std::int32_t* a, std::size_t n){
+                std::size_t i = headLength<16>(a, n);
+                std::int64_t total = scalar::sum(a, i);
+                __m128i acc0 = _mm_setzero_si128(), acc1 = _mm_setzero_si128();
+                for(; i + 8 <= n; i += 8){
+                    acc0 = addWidened(acc0, _mm_load_si128(reinterpret_cast<const __m128i*>(a + i)));
+                    acc1 = addWidened(acc1, _mm_load_si128(reinterpret_cast<const __m128i*>(a + i + 4)));
+                }
+                return total + horizontalSum64(_mm_add_epi64(acc0, acc1)) + scalar::sum(a + i, n - i);
+            }
+
+            inline std::int32_t min(const std::int32_t* a, std::size_t n){
+                std::size_t i = headLength<16>(a, n);
+                std::int32_t result = scalar::min(a, i);
+                __m128i acc = _mm_set1_epi32(std::numeric_limits<std::int32_t>::max());
+                for(; i + 4 <= n; i += 4){
+                    __m128i v = _mm_load_si128(reinterpret_cast<const __m128i*>(a + i));
+                    acc = select(_mm_cmplt_epi32(v, acc), v, acc);
+                }
+                alignas(16) std::int32_t lanes[4];
+                _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+                return std::min({result, scalar::min(lanes, 4), scalar::min(a + i, n - i)});
+            }
+
+            inline std::int32_t max(const std::int32_t* a, std::size_t n){
+                std::size_t i = headLength<16>(a, n);
+                std::int32_t result = scalar::max(a, i);
+                __m128i acc = _mm_set1_epi32(std::numeric_limits<std::int32_t>::min());
+                for(; i + 4 <= n; i += 4){
+                    __m128i v = _mm_load_si128(reinterpret_cast<const __m128i*>(a + i));
+                    acc = select(_mm_cmpgt_epi32(v, acc), v, acc);
+                }
+                alignas(16) std::int32_t lanes[4];
+                _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+                return std::max({result, scalar::max(lanes, 4), scalar::max(a + i, n - i)});
+            }
+
+            inline std::int64_t dot(const std::int32_t* a, const std::int32_t* b, std::size_t n){
+                std::size_t i = headLength<16>(a, n);
+                std::int64_t total = scalar::dot(a, b, i);
+                __m128i acc = _mm_setzero_si128();
+                for(; i + 4 <= n; i += 4){
+                    __m128i va = _mm_load_si128(reinterpret_cast<const __m128i*>(a + i));
+                    __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+                    acc = _mm_add_epi64(acc, mulEvenSigned(va, vb));
+                    acc = _mm_add_epi64(acc, mulEvenSigned(_mm_srli_epi64(va, 32), _mm_srli_epi64(vb, 32)));
+                }
+                return total + horizontalSum64(acc) + scalar::dot(a + i, b + i, n - i);
+            }
+
+            inline std::size_t count(const std::int32_t* a, std::size_t n, std::int32_t value){
+                std::size_t i = headLength<16>(a, n);
+                std::size_t total = scalar::count(a, i, value);
+                __m128i target = _mm_set1_epi32(value);
+                while(i + 4 <= n){
+                    // Lane counters are flushed before they can overflow
+                    std::size_t blockEnd = std::min(n - (n - i) % 4, i + 4 * std::size_t{1 << 30});
+                    __m128i acc = _mm_setzero_si128();
+                    for(; i < blockEnd; i += 4){
+                        __m128i v = _mm_load_si128(reinterpret_cast<const __m128i*>(a + i));
+                        acc = _mm_sub_epi32(acc, _mm_cmpeq_epi32(v, target));
+                    }
+                    alignas(16) std::uint32_t lanes[4];
+                    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+                    total += std::size_t{lanes[0]} + lanes[1] + lanes[2] + lanes[3];
+                }
+                return total + scalar::count(a + i, n - i, value);
+            }
+
+            // Applies op to 4 lanes at a time, with aligned stores to out
+            template<typename Op, typename ScalarOp>
+            void binary(const std::int32_t* a, const std::int32_t* b, std::int32_t* out, std::size_t n, Op op, ScalarOp tail){
+                std::size_t i = headLength<16>(out, n);
+                tail(a, b, out, i);
+                for(; i + 4 <= n; i += 4){
+                    __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+                    __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+                    _mm_store_si128(reinterpret_cast<__m128i*>(out + i), op(va, vb));
+                }
+                tail(a + i, b + i, out + i, n - i);
+            }
+
+            template<typename Op, typename ScalarOp>
+            void withScalar(const std::int32_t* a, std::int32_t value, std::int32_t* out, std::size_t n, Op op, ScalarOp tail){
+                std::size_t i = headLength<16>(out, n);
+                tail(a, value, out, i);
+                __m128i vb = _mm_set1_epi32(value);
+                for(; i + 4 <= n; i += 4){
+                    __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+                    _mm_store_si128(reinterpret_cast<__m128i*>(out + i), op(va, vb));
+                }
+                tail(a + i, value, out + i, n - i);
+            }
+
+            inline void add(const std::int32_t* a, const std::int32_t* b, std::int32_t* out, std::size_t n){
+                binary(a, b, out, n, [](__m128i x, __m128i y){ return _mm_add_epi32(x, y); }, scalar::add);
+            }
+
+            inline void subtract(const std::int32_t* a, const std::int32_t* b, std::int32_t* out, std::size_t n){
+                binary(a, b, out, n, [](__m128i x, __m128i y){ return _mm_sub_epi32(x, y); }, scalar::subtract);
+            }
+
+            inline void multiply(const std::int32_t* a, const std::int32_t* b, std::int32_t* out, std::size_t n){
+                binary(a, b, out, n, [](__m128i x, __m128i y){ return mullo(x, y); }, scalar::multiply);
+            }
+
+            inline void addScalar(const std::int32_t* a, std::int32_t value, std::int32_t* out, std::size_t n){
+                withScalar(a, value, out, n, [](__m128i x, __m128i y){ return _mm_add_epi32(x, y); }, scalar::addScalar);
+            }
+
+            inline void subtractScalar(const std::int32_t* a, std::int32_t value, std::int32_t* out, std::size_t n){
+                withScalar(a, value, out, n, [](__m128i x, __m128i y){ return _mm_sub_epi32(x, y); }, scalar::subtractScalar);
+            }
+
+            inline void multiplyScalar(const std::int32_t* a, std::int32_t value, std::int32_t* out, std::size_t n){
+                withScalar(a, value, out, n, [](__m128i x, __m128i y){ return mullo(x, y); }, scalar::multiplyScalar);
+            }
+
+            inline void fill(std::int32_t* out, std::size_t n, std::int32_t value){
+                std::size_t i = headLength<16>(out, n);
+                scalar::fill(out, i, value);
+                __m128i v = _mm_set1_epi32(value);
+                for(; i + 4 <= n; i += 4){
+                    _mm_store_si128(reinterpret_cast<__m128i*>(out + i), v);
+                }
+                scalar::fill(out + i, n - i, value);
+            }
+
+            inline constexpr Int32Kernels kernels{Isa::Sse2, sum, min, max, dot, count, add, subtract, multiply,
+                                                  addScalar, subtractScalar, multiplyScalar, fill};
+        }
+
+        namespace avx2{
+
+            OOP_TARGET_AVX2 inline std::int64_t horizontalSum64(__m256i v){
+                alignas(32) std::int64_t lanes[4];
+                _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), v);
+                return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+            }
+
+            OOP_TARGET_AVX2 inline __m256i addWidened(__m256i acc, __m256i v){
+                acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+                return _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+            }
+
+            OOP_TARGET_AVX2 inline std::int64_t sum(const std::int32_t* a, std::size_t n){
+                std::size_t i = headLength<32>(a, n);
+                std::int64_t total = scalar::sum(a, i);
+                __m256i acc0 = _mm256_setzero_si256(), acc1 = _mm256_setzero_si256();
+                for(; i + 16 <= n; i += 16){
+                    acc0 = addWidened(acc0, _mm256_load_si256(reinterpret_cast<const __m256i*>(a + i)));
+                    acc1 = addWidened(acc1, _mm256_load_si256(reinterpret_cast<const __m256i*>(a + i + 8)));
+                }
+                return total + horizontalSum64(_mm256_add_epi64(acc0, acc1)) + scalar::sum(a + i, n - i);
+            }
+
+            OOP_TARGET_AVX2 inline std::int32_t min(const std::int32_t* a, std::size_t n){
+                std::size_t i = headLength<32>(a, n);
+                std::int32_t result = scalar::min(a, i);
+                __m256i acc = _mm256_set1_epi32(std::numeric_limits<std::int32_t>::max());
+                for(; i + 8 <= n; i += 8){
+                    acc = _mm256_min_epi32(acc, _mm256_load_si256(reinterpret_cast<const __m256i*>(a + i)));
+                }
+                alignas(32) std::int32_t lanes[8];
+                _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+                return std::min({result, scalar::min(lanes, 8), scalar::min(a + i, n - i)});
+            }
+
+            OOP_TARGET_AVX2 inline std::int32_t max(const std::int32_t* a, std::size_t n){
+                std::size_t i = headLength<32>(a, n);
+                std::int32_t result = scalar::max(a, i);
+                __m256i acc = _mm256_set1_epi32(std::numeric_limits<std::int32_t>::min());
+                for(; i + 8 <= n; i += 8){
+                    acc = _mm256_max_epi32(acc, _mm256_load_si256(reinterpret_cast<const __m256i*>(a + i)));
+                }
+                alignas(32) std::int32_t lanes[8];
+                _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+                return std::max({result, scalar::max(lanes, 8), scalar::max(a + i, n - i)});
+            }
+
+            OOP_TARGET_AVX2 inline std::int64_t dot(const std::int32_t* a, const std::int32_t* b, std::size_t n){
+                std::size_t i = headLength<32>(a, n);
+                std::int64_t total = scalar::dot(a, b, i);
+                __m256i acc = _mm256_setzero_si256();
+                for(; i + 8 <= n; i += 8){
+                    __m256i va = _mm256_load_si256(reinterpret_cast<const __m256i*>(a + i));
+                    __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+                    acc = _mm256_add_epi64(acc, _mm256_mul_epi32(va, vb));
+                    acc = _mm256_add_epi64(acc, _mm256_mul_epi32(_mm256_srli_epi64(va, 32), _mm256_srli_epi64(vb, 32)));
+                }
+                return total + horizontalSum64(acc) + scalar::dot(a + i, b + i, n - i);
+            }
+
+            OOP_TARGET_AVX2 inline std::size_t count(const std::int32_t* a, std::size_t n, std::int32_t value){
+                std::size_t i = headLength<32>(a, n);
+                std::size_t total = scalar::count(a, i, value);
+                __m256i target = _mm256_set1_epi32(value);
+                while(i + 8 <= n){
+                    std::size_t blockEnd = std::min(n - (n - i) % 8, i + 8 * std::size_t{1 << 30});
+                    __m256i acc = _mm256_setzero_si256();
+                    for(; i < blockEnd; i += 8){
+                        __m256i v = _mm256_load_si256(reinterpret_cast<const __m256i*>(a + i));
+                        acc = _mm256_sub_epi32(acc, _mm256_cmpeq_epi32(v, target));
+                    }
+                    alignas(32) std::uint32_t lanes[8];
+                    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+                    for(std::uint32_t lane : lanes) total += lane;
+                }
+                return total + scalar::count(a + i, n - i, value);
+            }
+
+            // The element-wise kernels are spelled out because lambdas do not inherit the target attribute
+#define OOP_AVX2_BINARY(name, expression)                                                                        \
+            OOP_TARGET_AVX2 inline void name(const std::int32_t* a, const std::int32_t* b, std::int32_t* out,       \
+                                             std::size_t n){                                                        \
+                std::size_t i = headLength<32>(out, n);                                                             \
+                scalar::name(a, b, out, i);                                                                         \
+                for(; i + 8 <= n; i += 8){                                                                          \
+                    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));                        \
+                    __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));                        \
+                    _mm256_store_si256(reinterpret_cast<__m256i*>(out + i), expression);                            \
+                }                                                                                                   \
+                scalar::name(a + i, b + i, out + i, n - i);                                                         \
+            }
+
+#define OOP_AVX2_SCALAR(name, expression)                                                                        \
+            OOP_TARGET_AVX2 inline void name(const std::int32_t* a, std::int32_t value, std::int32_t* out,          \
+                                             std::size_t n){                                                        \
+                std::size_t i = headLength<32>(out, n);                                                             \
+                scalar::name(a, value, out, i);                                                                     \
+                __m256i y = _mm256_set1_epi32(value);                                                               \
+                for(; i + 8 <= n; i += 8){                                                                          \
+                    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));                        \
+                    _mm256_store_si256(reinterpret_cast<__m256i*>(out + i), expression);                            \
+                }                                                                                                   \
+                scalar::name(a + i, value, out + i, n - i);                                                         \
+            }
+
+            OOP_AVX2_BINARY(add, _mm256_add_epi32(x, y))
+            OOP_AVX2_BINARY(subtract, _mm256_sub_epi32(x, y))
+            OOP_AVX2_BINARY(multiply, _mm256_mullo_epi32(x, y))
+            OOP_AVX2_SCALAR(addScalar, _mm256_add_epi32(x, y))
+            OOP_AVX2_SCALAR(subtractScalar, _mm256_sub_epi32(x, y))
+            OOP_AVX2_SCALAR(multiplyScalar, _mm256_mullo_epi32(x, y))
+
+#undef OOP_AVX2_BINARY
+#undef OOP_AVX2_SCALAR
+
+            OOP_TARGET_AVX2 inline void fill(std::int32_t* out, std::size_t n, std::int32_t value){
+                std::size_t i = headLength<32>(out, n);
+                scalar::fill(out, i, value);
+                __m256i v = _mm256_set1_epi32(value);
+                for(; i + 8 <= n; i += 8){
+                    _mm256_store_si256(reinterpret_cast<__m256i*>(out + i), v);
+                }
+                scalar::fill(out + i, n - i, value);
+            }
+
+            inline constexpr Int32Kernels kernels{Isa::Avx2, sum, min, max, dot, count, add, subtract, multiply,
+                                                  addScalar, subtractScalar, multiplyScalar, fill};
+        }
+#endif
+
+        /**
+         * @brief Best instruction set supported by the CPU the program runs on.
+         * @return Isa::Avx2, Isa::Sse2 or Isa::Scalar.
+         */
+        inline Isa detectIsa(){
+#if OOP_SIMD_X86
+            if (__builtin_cpu_supports("avx2")) return Isa::Avx2;
+            if (__builtin_cpu_supports("sse2")) return Isa::Sse2;
+#endif
+            return Isa::Scalar;
+        }
+
+        /**
+         * @brief Kernels implemented with the given instruction set (it must be supported by the CPU).
+         * @param isa Instruction set of the kernels.
+         * @return Table of kernels, the scalar ones if isa was not compiled in.
+         */
+        inline const Int32Kernels& kernelsFor(Isa isa){
+#if OOP_SIMD_X86
+            if (isa == Isa::Avx2) return avx2::kernels;
+            if (isa == Isa::Sse2) return sse2::kernels;
+#endif
+            (void)isa;
+            return scalar::kernels;
+        }
+
+        /**
+         * @brief Kernels for the best instruction set of this CPU, detected on the first call.
+         * @return Table of kernels.
+         */
+        inline const Int32Kernels& kernels(){
+            static const Int32Kernels& selected = kernelsFor(detectIsa());
+            return selected;
+        }
+    }
+
+    namespace detail{
+
+        // Arrays whose elements can go through the int32 kernels
+        template<typename A>
+        concept Int32Array = std::is_same_v<std::remove_cv_t<typename A::value_type>, std::int32_t>;
+
+        // Result type of sum() and dot(): integers are accumulated in 64 bits
+        template<typename T>
+        using AccumulatorType = std::conditional_t<std::is_integral_v<T>, std::int64_t, T>;
+
+        template<typename A>
+        void requireSameSize(const A& a, const A& b){
+            if (a.size() != b.size()){
+                throw std::invalid_argument("element-wise operation on arrays of different sizes");
+            }
+        }
+
+        // Result array of the same type as a, with uninitialized elements that are overwritten by the caller
+        template<typename A>
+        A uninitializedLike(const A& a){
+            if constexpr (std::is_constructible_v<A, std::size_t, DefaultInitTag>){
+                return A(a.size(), defaultInit);
+            } else {
+                return A(a.size());
+            }
+        }
+    }
+
+    /**
+     * @brief Sum of the elements of an array (integers are added in 64 bits).
+     * @param a DynamicArray or DynamicArrayVector.
+     * @return Sum of all the elements, 0 for an empty array.
+     */
+    template<typename A>
+    detail::AccumulatorType<typename A::value_type> sum(const A& a){
+        if constexpr (detail::Int32Array<A>){
+            return simd::kernels().sum(a.data(), a.size());
+        } else {
+            detail::AccumulatorType<typename A::value_type> total{};
+            for(const auto& value : a) total += value;
+            return total;
+        }
+    }
+
+    /**
+     * @brief Smallest element of an array.
+     * @param a DynamicArray or DynamicArrayVector.
+     * @return The smallest element, or the largest value of the type for an empty array.
+     */
+    template<typename A>
+    typename A::value_type min(const A& a){
+        if constexpr (detail::Int32Array<A>){
+            return simd::kernels().min(a.data(), a.size());
+        } else {
+            typename A::value_type result = std::numeric_limits<typename A::value_type>::max();
+            for(const auto& value : a) result = value < result ? value : result;
+            return result;
+        }
+    }
+
+    /**
+     * @brief Largest element of an array.
+     * @param a DynamicArray or DynamicArrayVector.
+     * @return The largest element, or the lowest value of the type for an empty array.
+     */
+    template<typename A>
+    typename A::value_type max(const A& a){
+        if constexpr (detail::Int32Array<A>){
+            return simd::kernels().max(a.data(), a.size());
+        } else {
+            typename A::value_type result = std::numeric_limits<typename A::value_type>::lowest();
+            for(const auto& value : a) result = value > result ? value : result;
+            return result;
+        }
+    }
+
+    /**
+     * @brief Dot product of two arrays of the same size (integers are accumulated in 64 bits).
+     * @param a First array.
+     * @param b Second array.
+     * @return Sum of a[i] * b[i].
+     */
+    template<typename A>
+    detail::AccumulatorType<typename A::value_type> dot(const A& a, const A& b){
+        detail::requireSameSize(a, b);
+        if constexpr (detail::Int32Array<A>){
+            return simd::kernels().dot(a.data(), b.data(), a.size());
+        } else {
+            detail::AccumulatorType<typename A::value_type> total{};
+            for(std::size_t i = 0; i < static_cast<std::size_t>(a.size()); i++) total += a.data()[i] * b.data()[i];
+            return total;
+        }
+    }
+
+    /**
+     * @brief Counts the elements equal to value.
+     * @param a DynamicArray or DynamicArrayVector.
+     * @param value Value to look for.
+     * @return Number of elements equal to value.
+     */
+    template<typename A>
+    std::size_t count_if(const A& a, const typename A::value_type& value){
+        if constexpr (detail::Int32Array<A>){
+            return simd::kernels().count(a.data(), a.size(), value);
+        } else {
+            return static_cast<std::size_t>(std::count(a.begin(), a.end(), value));
+        }
+    }
+
+    /**
+     * @brief Sets every element of the array to value.
+     * @param a DynamicArray or DynamicArrayVector.
+     * @param value New value of the elements.
+     */
+    template<typename A>
+    void fill(A& a, const typename A::value_type& value){
+        if constexpr (detail::Int32Array<A>){
+            simd::kernels().fill(a.data(), a.size(), value);
+        } else {
+            std::fill(a.begin(), a.end(), value);
+        }
+    }
+
+    namespace detail{
+
+        // Shared body of the element-wise operations: kernel for int arrays, op for the others
+        template<typename A, typename Kernel, typename Op>
+        A elementWise(const A& a, const A& b, Kernel kernel, Op op){
+            requireSameSize(a, b);
+            A result = uninitializedLike(a);
+            if constexpr (Int32Array<A>){
+                (simd::kernels().*kernel)(a.data(), b.data(), result.data(), a.size());
+            } else {
+                for(std::size_t i = 0; i < static_cast<std::size_t>(a.size()); i++) result.data()[i] = op(a.data()[i], b.data()[i]);
+            }
+            return result;
+        }
+
+        template<typename A, typename Kernel, typename Op>
+        A elementWise(const A& a, const typename A::value_type& value, Kernel kernel, Op op){
+            A result = uninitializedLike(a);
+            if constexpr (Int32Array<A>){
+                (simd::kernels().*kernel)(a.data(), value, result.data(), a.size());
+            } else {
+                for(std::size_t i = 0; i < static_cast<std::size_t>(a.size()); i++) result.data()[i] = op(a.data()[i], value);
+            }
+            return result;
+        }
+    }
+
+    /**
+     * @brief Element-wise sum of two arrays of the same size (a + b concatenates, so this is a named function).
+     * @param a First array.
+     * @param b Second array.
+     * @return Array with a[i] + b[i].
+     */
+    template<typename A>
+    A add(const A& a, const A& b){
+        return detail::elementWise(a, b, &simd::Int32Kernels::add, std::plus<>());
+    }
+
+    /**
+     * @brief Adds value to every element of an array.
+     * @param a Array.
+     * @param value Value to add.
+     * @return Array with a[i] + value.
+     */
+    template<typename A>
+    A add(const A& a, const typename A::value_type& value){
+        return detail::elementWise(a, value, &simd::Int32Kernels::addScalar, std::plus<>());
+    }
+
+    /**
+     * @brief Element-wise difference of two arrays of the same size.
+     * @param a First array.
+     * @param b Second array.
+     * @return Array with a[i] - b[i].
+     */
+    template<typename A>
+    A subtract(const A& a, const A& b){
+        return detail::elementWise(a, b, &simd::Int32Kernels::subtract, std::minus<>());
+    }
+
+    /**
+     * @brief Subtracts value from every element of an array.
+     * @param a Array.
+     * @param value Value to subtract.
+     * @return Array with a[i] - value.
+     */
+    template<typename A>
+    A subtract(const A& a, const typename A::value_type& value){
+        return detail::elementWise(a, value, &simd::Int32Kernels::subtractScalar, std::minus<>());
+    }
+
+    /**
+     * @brief Element-wise product of two arrays of the same size.
+     * @param a First array.
+     * @param b Second array.
+     * @return Array with a[i] * b[i].
+     */
+    template<typename A>
+    A multiply(const A& a, const A& b){
+        return detail::elementWise(a, b, &simd::Int32Kernels::multiply, std::multiplies<>());
+    }
+
+    /**
+     * @brief Multiplies every element of an array by value.
+     * @param a Array.
+     * @param value Factor.
+     * @return Array with a[i] * value.
+     */
+    template<typename A>
+    A multiply(const A& a, const typename A::value_type& value){
+        return detail::elementWise(a, value, &simd::Int32Kernels::multiplyScalar, std::multiplies<>());
+    }
+
+}
@@ -0,0 +1,414 @@
+/**
+ * @file ArraySerialization.h
+ * @brief Fast text formatting, text parsing and a binary file format for DynamicArray and DynamicArrayVector.
+ *
+ * The text form is the one written by operator<< ("[1, 2, 3]"), produced with std::to_chars into a reusable
+ * buffer instead of one formatted stream insertion per element. The binary form is a 16-byte header followed
+ * by the raw elements, written and read with a single stream call each.
+ */
+#pragma once
+
+#include "DynamicArray.h"
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+namespace oop{
+
+    /**
+     * @brief Element types that can be formatted, parsed and stored in the binary format.
+     */
+    template<typename T>
+    concept SerializableElement = std::is_arithmetic_v<T> && !std::is_same_v<T, bool> &&
+                                  (std::is_integral_v<T> || std::is_same_v<T, float> || std::is_same_v<T, double>);
+
+    /**
+     * @brief Contiguous arrays (DynamicArray, DynamicArrayVector) of serializable elements.
+     */
+    template<typename A>
+    concept SerializableArray = SerializableElement<typename A::value_type> && requires(const A& a){
+        { a.data() } -> std::convertible_to<const typename A::value_type*>;
+        a.size();
+    };
+
+    namespace detail{
+
+        // Upper bound of the characters std::to_chars writes for one value of T
+        template<typename T>
+        constexpr std::size_t maxFormattedLength(){
+            if constexpr (std::is_integral_v<T>){
+                return std::numeric_limits<T>::digits10 + 2; // sign and the partial last digit
+            } else {
+                return 32; // shortest round-trip form of a double is at most 24 characters
+            }
+        }
+
+        template<typename T>
+        char* formatElement(char* out, T value){
+            return std::to_chars(out, out + maxFormattedLength<T>(), value).ptr;
+        }
+    }
+
+    /**
+     * @class ArrayFormatter
+     * @brief Writes arrays in the "[a, b, c]" form of operator<< using std::to_chars and a buffer kept between calls.
+     *
+     * Integers are written exactly as operator<< writes them. Floating point values are written in the shortest
+     * form that parses back to the same value, so they round-trip through parseArray(). Not thread-safe: use one
+     * formatter per thread.
+     */
+    class ArrayFormatter{
+    private:
+        std::string buffer; /**< characters of the last formatted array, reused by the next call. */
+
+        static constexpr std::size_t blockSize = 64 * 1024; /**< bytes handed to the stream at a time by write(). */
+
+    public:
+        /**
+         * @brief Formats the whole array into the internal buffer.
+         * @param a Array to be formatted.
+         * @return View of the text, valid until the next call on this formatter.
+         */
+        template<SerializableArray A>
+        std::string_view format(const A& a){
+            using T = typename A::value_type;
+            std::size_t n = static_cast<std::size_t>(a.size());
+            const T* data = a.data();
+            buffer.resize(2 + n * (detail::maxFormattedLength<T>() + 2));
+            char* out = buffer.data();
+            *out++ = '[';
+            for(std::size_t i = 0; i < n; i++){
+                if (i != 0){
+                    *out++ = ',';
+                    *out++ = ' ';
+                }
+                out = detail::formatElement(out, data[i]);
+            }
+            *out++ = ']';
+            buffer.resize(static_cast<std::size_t>(out - buffer.data()));
+            return buffer;
+        }
+
+        /**
+         * @brief Writes the array to a stream in blocks, so memory use does not grow with the array.
+         * @param os Stream receiving the text.
+         * @param a Array to be written.
+         * @return The stream.
+         */
+        template<SerializableArray A>
+        std::ostream& write(std::ostream& os, const A& a){
+            using T = typename A::value_type;
+            constexpr std::size_t maxElement = detail::maxFormattedLength<T>() + 2;
+            std::size_t n = static_cast<std::size_t>(a.size());
+            const T* data = a.data();
+            buffer.resize(blockSize + maxElement + 1);
+            char* begin = buffer.data();
+            char* flushAt = begin + blockSize;
+            char* out = begin;
+            *out++ = '[';
+            for(std::size_t i = 0; i < n; i++){
+                if (i != 0){
+                    *out++ = ',';
+                    *out++ = ' ';
+                }
+                out = detail::formatElement(out, data[i]);
+                if (out >= flushAt){
+                    os.write(begin, out - begin);
+                    out = begin;
+                }
+            }
+            *out++ = ']';
+            os.write(begin, out - begin);
+            return os;
+        }
+    };
+
+    /**
+     * @brief Formats an array into a new string, the same text operator<< writes.
+     * @param a Array to be formatted.
+     * @return The text of the array.
+     */
+    template<SerializableArray A>
+    std::string formatArray(const A& a){
+        ArrayFormatter formatter;
+        return std::string(formatter.format(a));
+    }
+
+    /**
+     * @brief Parses the "[a, b, c]" text form written by operator<< and ArrayFormatter.
+     * @tparam T Type of the elements.
+     * @param text Text of the array; whitespace around brackets, commas and values is ignored.
+     * @return Array with the parsed elements.
+     * @throws std::invalid_argument if the text is not a well-formed array of T.
+     */
+    template<SerializableElement T>
+    DynamicArray<T> parseArray(std::string_view text){
+        const char* p = text.data();
+        const char* end = text.data() + text.size();
+        auto fail = [&](const char* what){
+            throw std::invalid_argument(std::string("parseArray: ") + what + " at offset " +
+                                        std::to_string(p - text.data()));
+        };
+        auto skipSpaces = [&]{
+            while(p != end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')) p++;
+        };
+
+        DynamicArray<T> result;
+        skipSpaces();
+        if (p == end || *p != '[') fail("expected '['");
+        p++;
+        skipSpaces();
+        if (p != end && *p == ']'){
+            p++;
+        } else {
+            result.reserve(static_cast<std::size_t>(std::count(p, end, ',')) + 1);
+            while(true){
+                skipSpaces();
+                T value;
+                auto [next, error] = std::from_chars(p, end, value);
+                if (error == std::errc::result_out_of_range) fail("value out of range");
+                if (error != std::errc()) fail("expected a number");
+                p = next;
+                result.push_back(value);
+                skipSpaces();
+                if (p == end) fail("expected ',' or ']'");
+                if (*p == ']'){
+                    p++;
+                    break;
+                }
+                if (*p != ',') fail("expected ',' or ']'");
+                p++;
+            }
+        }
+        skipSpaces();
+        if (p != end) fail("unexpected characters after ']'");
+        return result;
+    }
+
+    /**
+     * @brief Reads one array in text form from a stream (everything up to the closing ']').
+     * @tparam T Type of the elements.
+     * @param is Stream positioned at the array.
+     * @return Array with the parsed elements.
+     * @throws std::invalid_argument if the text is not a well-formed array of T.
+     */
+    template<SerializableElement T>
+    DynamicArray<T> readArray(std::istream& is){
+        std::string text;
+        std::getline(is, text, ']');
+        if (!is) throw std::invalid_argument("readArray: missing ']'");
+        text += ']';
+        return parseArray<T>(text);
+    }
+
+    /**
+     * @namespace oop::binary
+     * @brief Layout of the binary array format.
+     *
+     * Header (16 bytes, integers little-endian): magic "OOPA", format version, element type code, element
+     * size in bytes, byte order of the payload (1 little, 2 big) and the element count as a 64-bit integer.
+     * The payload follows with the elements in the byte order of the machine that wrote it; load() swaps
+     * them when the file comes from a machine of the other byte order.
+     */
+    namespace binary{
+
+        inline constexpr char magic[4] = {'O', 'O', 'P', 'A'};
+        inline constexpr std::uint8_t version = 1;
+        inline constexpr std::size_t headerSize = 16;
+
+        /**
+         * @brief Codes stored in the header for the element type.
+         */
+        enum class ElementType : std::uint8_t { Int8 = 1, UInt8, Int16, UInt16, Int32, UInt32, Int64, UInt64, Float32, Float64 };
+
+        enum class ByteOrder : std::uint8_t { Little = 1, Big = 2 };
+
+        inline constexpr ByteOrder nativeOrder = std::endian::native == std::endian::little ? ByteOrder::Little : ByteOrder::Big;
+
+        /**
+         * @brief Type code of T.
+         */
+        template<SerializableElement T>
+        constexpr ElementType elementTypeOf(){
+            if constexpr (std::is_floating_point_v<T>){
+                return sizeof(T) == 4 ? ElementType::Float32 : ElementType::Float64;
+            } else {
+                constexpr int log2Size = sizeof(T) == 1 ? 0 : sizeof(T) == 2 ? 1 : sizeof(T) == 4 ? 2 : 3;
+                return static_cast<ElementType>(1 + 2 * log2Size + (std::is_signed_v<T> ? 0 : 1));
+            }
+        }
+
+        /**
+         * @brief Header of a binary array.
+         */
+        struct Header{
+            ElementType type;
+            std::uint8_t elementSize;
+            ByteOrder order;
+            std::uint64_t count;
+        };
+
+        inline void encodeHeader(const Header& header, unsigned char* out){
+            std::memcpy(out, magic, sizeof(magic));
+            out[4] = version;
+            out[5] = static_cast<unsigned char>(header.type);
+            out[6] = header.elementSize;
+            out[7] = static_cast<unsigned char>(header.order);
+            for(int i = 0; i < 8; i++) out[8 + i] = static_cast<unsigned char>(header.count >> (8 * i));
+        }
+
+        /**
+         * @brief Decodes and validates a header.
+         * @throws std::runtime_error if the bytes are not a header this version can read.
+         */
+        inline Header decodeHeader(const unsigned char* in){
+            if (std::memcmp(in, magic, sizeof(magic)) != 0) throw std::runtime_error("binary array: bad magic number");
+            if (in[4] != version) throw std::runtime_error("binary array: unsupported version " + std::to_string(in[4]));
+            Header header{static_cast<ElementType>(in[5]), in[6], static_cast<ByteOrder>(in[7]), 0};
+            if (header.order != ByteOrder::Little && header.order != ByteOrder::Big){
+                throw std::runtime_error("binary array: bad byte order");
+            }
+            for(int i = 0; i < 8; i++) header.count |= static_cast<std::uint64_t>(in[8 + i]) << (8 * i);
+            return header;
+        }
+
+        // Reverses the bytes of every element, for payloads written with the other byte order
+        template<typename T>
+        void swapBytes(T* data, std::size_t n){
+            for(std::size_t i = 0; i < n; i++){
+                auto* bytes = reinterpret_cast<unsigned char*>(data + i);
+                std::reverse(bytes, bytes + sizeof(T));
+            }
+        }
+    }
+
+    /**
+     * @brief Writes an array in the binary format: the header, then the payload with one write.
+     * @param os Binary stream receiving the array.
+     * @param a Array to be saved.
+     * @throws std::runtime_error if the stream fails.
+     */
+    template<SerializableArray A>
+    void save(std::ostream& os, const A& a){
+        using T = typename A::value_type;
+        unsigned char header[binary::headerSize];
+        std::uint64_t count = static_cast<std::uint64_t>(a.size());
+        binary::encodeHeader({binary::elementTypeOf<T>(), sizeof(T), binary::nativeOrder, count}, header);
+        os.write(reinterpret_cast<const char*>(header), sizeof(header));
+        os.write(reinterpret_cast<const char*>(a.data()), static_cast<std::streamsize>(count * sizeof(T)));
+        if (!os) throw std::runtime_error("save: write failed");
+    }
+
+    /**
+     * @brief Saves an array to a file in the binary format, replacing the file.
+     * @param path File to be written.
+     * @param a Array to be saved.
+     * @throws std::runtime_error if the file cannot be written.
+     */
+    template<SerializableArray A>
+    void save(const std::filesystem::path& path, const A& a){
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file) throw std::runtime_error("save: cannot open " + path.string());
+        save(file, a);
+    }
+
+    namespace binary{
+
+        /** @brief Bytes of payload read before the array grows, so a corrupt count cannot allocate more than the data. */
+        inline constexpr std::size_t payloadChunk = std::size_t{1} << 20;
+
+        // Reads and checks the header of an array of T
+        template<SerializableElement T>
+        Header readHeader(std::istream& is){
+            unsigned char bytes[headerSize];
+            if (!is.read(reinterpret_cast<char*>(bytes), sizeof(bytes))) throw std::runtime_error("load: missing header");
+            Header header = decodeHeader(bytes);
+            if (header.type != elementTypeOf<T>() || header.elementSize != sizeof(T)){
+                throw std::runtime_error("load: the array was saved with another element type");
+            }
+            if (header.count > std::numeric_limits<std::size_t>::max() / sizeof(T)){
+                throw std::runtime_error("load: element count too large");
+            }
+            return header;
+        }
+
+        // Reads the payload, allocating at most firstElements before data arrives and then doubling with it
+        template<SerializableElement T>
+        DynamicArray<T> readPayload(std::istream& is, const Header& header, std::size_t firstElements){
+            std::size_t count = static_cast<std::size_t>(header.count);
+            DynamicArray<T> result(std::min(count, std::max<std::size_t>(firstElements, 1)), defaultInit);
+            std::size_t loaded = 0;
+            while(true){
+                std::size_t missing = result.size() - loaded;
+                if (!is.read(reinterpret_cast<char*>(result.data() + loaded), static_cast<std::streamsize>(missing * sizeof(T)))){
+                    throw std::runtime_error("load: payload shorter than the element count");
+                }
+                loaded = result.size();
+                if (loaded == count) break;
+                DynamicArray<T> larger(std::min(count, 2 * loaded), defaultInit);
+                std::copy_n(result.data(), loaded, larger.data());
+                result = std::move(larger);
+            }
+            if (header.order != nativeOrder){
+                swapBytes(result.data(), count);
+            }
+            return result;
+        }
+    }
+
+    /**
+     * @brief Reads an array written by save(): the header, then the payload.
+     *
+     * The count of the header is not trusted: the array starts at binary::payloadChunk bytes and doubles as
+     * the payload is read, so a corrupt count fails with the missing payload instead of a huge allocation.
+     * @tparam T Type of the elements; must be the type the array was saved with.
+     * @param is Binary stream positioned at the header.
+     * @return The loaded array.
+     * @throws std::runtime_error if the header is invalid, the element type differs or the stream ends early.
+     */
+    template<SerializableElement T>
+    DynamicArray<T> load(std::istream& is){
+        binary::Header header = binary::readHeader<T>(is);
+        return binary::readPayload<T>(is, header, binary::payloadChunk / sizeof(T));
+    }
+
+    /**
+     * @brief Loads an array from a file written by save().
+     *
+     * The count of the header is checked against the size of the file, then the payload is read with one
+     * allocation and one read (or in growing chunks like load(std::istream&) if the size is unknown).
+     * @tparam T Type of the elements; must be the type the array was saved with.
+     * @param path File to be read.
+     * @return The loaded array.
+     * @throws std::runtime_error if the file cannot be read or is not a valid array of T.
+     */
+    template<SerializableElement T>
+    DynamicArray<T> load(const std::filesystem::path& path){
+        std::ifstream file(path, std::ios::binary);
+        if (!file) throw std::runtime_error("load: cannot open " + path.string());
+        binary::Header header = binary::readHeader<T>(file);
+        std::error_code error;
+        std::uintmax_t bytes = std::filesystem::file_size(path, error);
+        if (!error && (bytes - binary::headerSize) / sizeof(T) < header.count){
+            throw std::runtime_error("load: payload shorter than the element count");
+        }
+        std::size_t first = error ? binary::payloadChunk / sizeof(T) : static_cast<std::size_t>(header.count);
+        return binary::readPayload<T>(file, header, first);
+    }
+
+}
@@ -0,0 +1,511 @@
+/**
+ * @file ArrayView.h
+ * @brief Non-owning views over contiguous arrays (ArrayView, StridedView) and the copy-on-write SharedArray.
+ */
+#pragma once
+
+#include "ArrayExpression.h"
+#include "DynamicArray.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace oop{
+
+    template<typename T>
+    class StridedView;
+
+    /**
+     * @class ArrayView
+     * @brief Pointer and size referring to elements owned by someone else (a DynamicArray, a std::vector...).
+     * @tparam T Element type; ArrayView<const T> gives read-only access.
+     *
+     * Copying a view copies two words, never the elements, so stages of a pipeline can take an ArrayView
+     * instead of an array. The view must not outlive the elements, and growing the array it refers to
+     * invalidates it. It converts to and from std::span and can be an operand of operator+.
+     */
+    template<typename T>
+    class ArrayView{
+    public:
+        using element_type = T;
+        using value_type = std::remove_cv_t<T>;
+        using size_type = std::size_t;
+        using reference = T&;
+        using iterator = T*;
+        using const_iterator = const T*;
+
+        /** @brief Value of len in subview() that extends the view to the end. */
+        static constexpr size_type npos = static_cast<size_type>(-1);
+
+    private:
+        T* ptr = nullptr; /**< first element of the view. */
+        size_type len = 0; /**< number of elements in the view. */
+
+    public:
+        ArrayView() = default;
+
+        /**
+         * @brief Constructor from a pointer and a number of elements.
+         * @param data First element.
+         * @param size Number of elements.
+         */
+        ArrayView(T* data, size_type size) : ptr(data), len(size){}
+
+        /**
+         * @brief Constructor from any contiguous range: DynamicArray, DynamicArrayVector, std::vector, std::span...
+         * @param range Range whose elements are viewed; a const range gives an ArrayView<const T>.
+         */
+        template<typename R>
+            requires (!std::is_same_v<std::remove_cvref_t<R>, ArrayView>)
+                  && std::ranges::contiguous_range<R> && std::ranges::sized_range<R>
+                  && std::is_convertible_v<std::remove_reference_t<std::ranges::range_reference_t<R>>(*)[], T(*)[]>
+        ArrayView(R&& range) : ptr(std::ranges::data(range)), len(std::ranges::size(range)){}
+
+        /**
+         * @brief A view of mutable elements is also a read-only view.
+         */
+        template<typename U>
+            requires (!std::is_same_v<U, T>) && std::is_convertible_v<U(*)[], T(*)[]>
+        ArrayView(const ArrayView<U>& other) : ptr(other.data()), len(other.size()){}
+
+        /** @brief Returns the view as a std::span. */
+        operator std::span<T>() const { return std::span<T>(ptr, len); }
+
+        size_type size() const { return len; }
+        bool empty() const { return len == 0; }
+        T* data() const { return ptr; }
+
+        /**
+         * @brief Access to an element; const views only give const references.
+         * @param index Index of the element (not checked).
+         * @return Reference to the element.
+         */
+        T& operator[](size_type index) const { return ptr[index]; }
+
+        /**
+         * @brief Checked access to an element.
+         * @param index Index of the element.
+         * @return Reference to the element.
+         * @throws std::out_of_range if index is not smaller than size().
+         */
+        T& at(size_type index) const {
+            if (index >= len) throw std::out_of_range("ArrayView::at: index out of range");
+            return ptr[index];
+        }
+
+        T& front() const { return ptr[0]; }
+        T& back() const { return ptr[len - 1]; }
+
+        /** @brief Iterator to the first element. */
+        iterator begin() const { return ptr; }
+        /** @brief Iterator past the last element. */
+        iterator end() const { return ptr + len; }
+
+        /**
+         * @brief View of part of this view, without copying.
+         * @param offset Index of the first element of the subview.
+         * @param count Number of elements (npos or too many: up to the end).
+         * @return The subview.
+         * @throws std::out_of_range if offset is larger than size().
+         */
+        ArrayView subview(size_type offset, size_type count = npos) const {
+            if (offset > len) throw std::out_of_range("ArrayView::subview: offset out of range");
+            return ArrayView(ptr + offset, std::min(count, len - offset));
+        }
+
+        /** @brief View of the first count elements (at most size()). */
+        ArrayView first(size_type count) const { return subview(0, count); }
+
+        /** @brief View of the last count elements (at most size()). */
+        ArrayView last(size_type count) const { return subview(len - std::min(count, len)); }
+
+        /**
+         * @brief View of every step-th element, starting with the first.
+         * @param step Distance between two viewed elements.
+         * @return The strided view.
+         * @throws std::invalid_argument if step is 0.
+         */
+        StridedView<T> strided(size_type step) const;
+
+        /**
+         * @brief Copies the viewed elements into a new array.
+         * @return A DynamicArray holding a copy of the elements.
+         */
+        DynamicArray<value_type> toArray() const {
+            DynamicArray<value_type> copy;
+            copy.reserve(len);
+            for(const T& value : *this) copy.push_back(value);
+            return copy;
+        }
+
+        /**
+         * @brief Streams the view in the same [a, b, c] form as the arrays.
+         */
+        friend std::ostream& operator<<(std::ostream& os, const ArrayView& view) {
+            os << "[";
+            for(size_type i = 0; i < view.len; i++){
+                os << view.ptr[i];
+                if (i != view.len - 1) os << ", ";
+            }
+            return os << "]";
+        }
+    };
+
+    template<typename R>
+    ArrayView(R&&) -> ArrayView<std::remove_reference_t<std::ranges::range_reference_t<R>>>;
+
+    /**
+     * @class StridedView
+     * @brief View of every step-th element of a contiguous buffer, such as one column of a row-major matrix.
+     * @tparam T Element type; StridedView<const T> gives read-only access.
+     */
+    template<typename T>
+    class StridedView{
+    public:
+        using element_type = T;
+        using value_type = std::remove_cv_t<T>;
+        using size_type = std::size_t;
+
+    private:
+        T* ptr = nullptr; /**< first element of the view. */
+        size_type len = 0; /**< number of elements in the view. */
+        size_type step = 1; /**< distance between two elements of the view. */
+
+    public:
+        /**
+         * @class iterator
+         * @brief Random access iterator that advances by the stride.
+         *
+         * It keeps an index rather than a pointer, so the end iterator never points past the buffer.
+         */
+        class iterator{
+            T* p = nullptr;
+            std::ptrdiff_t index = 0;
+            std::ptrdiff_t step = 1;
+
+        public:
+            using iterator_concept = std::random_access_iterator_tag;
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = std::remove_cv_t<T>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = T*;
+            using reference = T&;
+
+            iterator() = default;
+            iterator(T* p, std::ptrdiff_t index, std::ptrdiff_t step) : p(p), index(index), step(step){}
+
+            T& operator*() const { return p[index * step]; }
+            T* operator->() const { return p + index * step; }
+            T& operator[](difference_type n) const { return p[(index + n) * step]; }
+            iterator& operator++(){ ++index; return *this; }
+            iterator operator++(int){ iterator old = *this; ++index; return old; }
+            iterator& operator--(){ --index; return *this; }
+            iterator operator--(int){ iterator old = *this; --index; return old; }
+            iterator& operator+=(difference_type n){ index += n; return *this; }
+            iterator& operator-=(difference_type n){ index -= n; return *this; }
+            friend iterator operator+(iterator it, difference_type n){ return it += n; }
+            friend iterator operator+(difference_type n, iterator it){ return it += n; }
+            friend iterator operator-(iterator it, difference_type n){ return it -= n; }
+            friend difference_type operator-(const iterator& a, const iterator& b){ return a.index - b.index; }
+            bool operator==(const iterator& other) const { return index == other.index; }
+            auto operator<=>(const iterator& other) const { return index <=> other.index; }
+        };
+
+        StridedView() = default;
+
+        /**
+         * @brief Constructor from a buffer, the number of viewed elements and the stride.
+         * @param data First viewed element.
+         * @param size Number of viewed elements.
+         * @param step Distance between two viewed elements.
+         * @throws std::invalid_argument if step is 0.
+         */
+        StridedView(T* data, size_type size, size_type step) : ptr(data), len(size), step(step){
+            if (step == 0) throw std::invalid_argument("StridedView: the stride must be positive");
+        }
+
+        /**
+         * @brief A view of mutable elements is also a read-only view.
+         */
+        template<typename U>
+            requires (!std::is_same_v<U, T>) && std::is_convertible_v<U(*)[], T(*)[]>
+        StridedView(const StridedView<U>& other) : ptr(other.base()), len(other.size()), step(other.stride()){}
+
+        size_type size() const { return len; }
+        bool empty() const { return len == 0; }
+        size_type stride() const { return step; }
+
+        /** @brief First viewed element (not called data() because the elements are not contiguous). */
+        T* base() const { return ptr; }
+
+        /**
+         * @brief Access to an element.
+         * @param index Index of the element in the view (not checked).
+         * @return Reference to the element.
+         */
+        T& operator[](size_type index) const { return ptr[index * step]; }
+
+        /** @brief Iterator to the first element. */
+        iterator begin() const { return iterator(ptr, 0, static_cast<std::ptrdiff_t>(step)); }
+        /** @brief Iterator past the last element. */
+        iterator end() const { return iterator(ptr, static_cast<std::ptrdiff_t>(len), static_cast<std::ptrdiff_t>(step)); }
+
+        /**
+         * @brief View of part of this view.
+         * @param offset Index in this view of the first element.
+         * @param count Number of elements (too many: up to the end).
+         * @return The subview, with the same stride.
+         * @throws std::out_of_range if offset is larger than size().
+         */
+        StridedView subview(size_type offset, size_type count = ArrayView<T>::npos) const {
+            if (offset > len) throw std::out_of_range("StridedView::subview: offset out of range");
+            return StridedView(ptr + offset * step, std::min(count, len - offset), step);
+        }
+
+        /**
+         * @brief Calls f(first, last) for every contiguous run of elements, so the view can be an operand of operator+.
+         * @param f Callable taking two const value_type pointers.
+         */
+        template<typename F>
+        void forEachSegment(F&& f) const {
+            if (step == 1){
+                if (len != 0) f(static_cast<const value_type*>(ptr), static_cast<const value_type*>(ptr + len));
+                return;
+            }
+            for(size_type i = 0; i < len; i++){
+                const value_type* p = ptr + i * step;
+                f(p, p + 1);
+            }
+        }
+
+        /**
+         * @brief Copies the viewed elements into a new array.
+         * @return A DynamicArray holding a copy of the elements.
+         */
+        DynamicArray<value_type> toArray() const {
+            DynamicArray<value_type> copy;
+            copy.reserve(len);
+            for(const T& value : *this) copy.push_back(value);
+            return copy;
+        }
+
+        /**
+         * @brief Streams the view in the same [a, b, c] form as the arrays.
+         */
+        friend std::ostream& operator<<(std::ostream& os, const StridedView& view) {
+            os << "[";
+            for(size_type i = 0; i < view.len; i++){
+                os << view[i];
+                if (i != view.len - 1) os << ", ";
+            }
+            return os << "]";
+        }
+    };
+
+    template<typename T>
+    StridedView<T> ArrayView<T>::strided(size_type step) const {
+        if (step == 0) throw std::invalid_argument("ArrayView::strided: the stride must be positive");
+        return StridedView<T>(ptr, (len + step - 1) / step, step);
+    }
+
+    template<typename T>
+    inline constexpr bool isConcatOperand<ArrayView<T>> = true;
+
+    template<typename T>
+    inline constexpr bool isConcatOperand<StridedView<T>> = true;
+
+    /**
+     * @class SharedArray
+     * @brief Array shared by its copies until one of them writes (copy-on-write).
+     * @tparam T Element type.
+     *
+     * Copying a SharedArray only increments a reference count, so a read-mostly array can be handed to many
+     * consumers without copying the elements. Reading goes through view() or operator[]; mutableArray() and set()
+     * first give this object its own copy if the buffer is shared. Different SharedArray objects sharing a
+     * buffer may be used from different threads; one object must not be used by two threads at once.
+     * A moved-from SharedArray is a valid empty array.
+     */
+    template<typename T>
+    class SharedArray{
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using Array = DynamicArray<T>;
+
+    private:
+        // The elements and the number of SharedArray objects holding them
+        struct Buffer{
+            std::atomic<long> owners{1};
+            Array elements;
+
+            template<typename... Args>
+            explicit Buffer(Args&&... args) : elements(std::forward<Args>(args)...){}
+        };
+
+        Buffer* buffer; /**< never null, shared by the copies of this object. */
+
+        void release() noexcept {
+            if (buffer->owners.fetch_sub(1, std::memory_order_acq_rel) == 1) delete buffer;
+        }
+
+        // The acquire load pairs with the release of the objects that let go of the buffer, so their reads
+        // happen before this object writes in place once it finds itself the only owner
+        bool shared() const { return buffer->owners.load(std::memory_order_acquire) > 1; }
+
+        // Gives this object its own buffer if it shares one
+        void detach(){
+            if (shared()){
+                Buffer* own = new Buffer(buffer->elements);
+                release();
+                buffer = own;
+            }
+        }
+
+    public:
+        /**
+         * @brief Constructor of an empty array.
+         */
+        SharedArray() : buffer(new Buffer()){}
+
+        /**
+         * @brief Constructor that takes over an array without copying it.
+         * @param elements Array to be shared.
+         */
+        explicit SharedArray(Array&& elements) : buffer(new Buffer(std::move(elements))){}
+
+        /**
+         * @brief Constructor that copies an array once, to share the copy.
+         * @param elements Array to be copied.
+         */
+        explicit SharedArray(const Array& elements) : buffer(new Buffer(elements)){}
+
+        /**
+         * @brief Copy constructor: shares the buffer of other.
+         * @param other Array to be shared.
+         */
+        SharedArray(const SharedArray& other) noexcept : buffer(other.buffer){
+            buffer->owners.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Move constructor: takes the buffer of other and leaves other empty, like take().
+         * @param other Array to be moved.
+         */
+        SharedArray(SharedArray&& other) : buffer(std::exchange(other.buffer, new Buffer())){}
+
+        /**
+         * @brief Copy assignment: shares the buffer of other and lets go of the current one.
+         * @param other Array to be shared.
+         * @return Reference to this array.
+         */
+        SharedArray& operator=(const SharedArray& other) noexcept {
+            other.buffer->owners.fetch_add(1, std::memory_order_relaxed); // first, in case of self-assignment
+            release();
+            buffer = other.buffer;
+            return *this;
+        }
+
+        /**
+         * @brief Move assignment: takes the buffer of other and leaves other empty, like take().
+         * @param other Array to be moved.
+         * @return Reference to this array.
+         */
+        SharedArray& operator=(SharedArray&& other){
+            if (this != &other){
+                Buffer* empty = new Buffer();
+                release();
+                buffer = std::exchange(other.buffer, empty);
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Destructor that frees the buffer if no other object shares it.
+         */
+        ~SharedArray(){
+            release();
+        }
+
+        size_type size() const { return buffer->elements.size(); }
+        bool empty() const { return buffer->elements.empty(); }
+
+        /**
+         * @brief Read access to an element; never copies.
+         * @param index Index of the element.
+         * @return Const reference to the element.
+         */
+        const T& operator[](size_type index) const { return buffer->elements[index]; }
+
+        /** @brief Pointer to the shared elements (read-only). */
+        const T* data() const { return buffer->elements.data(); }
+
+        /** @brief Read-only view of the elements; valid until this object is written to or destroyed. */
+        ArrayView<const T> view() const { return ArrayView<const T>(buffer->elements.data(), buffer->elements.size()); }
+
+        /** @brief Const iterator to the first element. */
+        const T* begin() const { return buffer->elements.data(); }
+        /** @brief Const iterator past the last element. */
+        const T* end() const { return buffer->elements.data() + buffer->elements.size(); }
+
+        /**
+         * @brief Writes one element, copying the buffer first if it is shared.
+         * @param index Index of the element.
+         * @param value New value.
+         */
+        void set(size_type index, const T& value){
+            detach();
+            buffer->elements[index] = value;
+        }
+
+        /**
+         * @brief Mutable access to the whole array, copying the buffer first if it is shared.
+         * @return Reference to an array owned by this object alone (until it is copied again).
+         */
+        Array& mutableArray(){
+            detach();
+            return buffer->elements;
+        }
+
+        /**
+         * @brief Returns the number of SharedArray objects sharing the buffer.
+         * @return 1 if this object owns its buffer alone.
+         */
+        long useCount() const { return buffer->owners.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Returns whether the buffer is shared with another SharedArray.
+         */
+        bool isShared() const { return shared(); }
+
+        /**
+         * @brief Moves the elements out if the buffer is not shared, otherwise copies them.
+         * @return The elements; this object is left empty.
+         */
+        Array take() &&{
+            Array result = shared() ? Array(buffer->elements) : std::move(buffer->elements);
+            Buffer* empty = new Buffer();
+            release();
+            buffer = empty;
+            return result;
+        }
+
+        /**
+         * @brief Streams the array in the same [a, b, c] form as DynamicArray.
+         */
+        friend std::ostream& operator<<(std::ostream& os, const SharedArray& shared) {
+            return os << shared.buffer->elements;
+        }
+    };
+
+    template<typename T>
+    inline constexpr bool isConcatOperand<SharedArray<T>> = true;
+
+}
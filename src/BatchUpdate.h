@@ -0,0 +1,164 @@
+/**
+ * @file BatchUpdate.h
+ * @brief Validation of batches of updates into error bitmasks, and batch setters for arrays of Student.
+ */
+#pragma once
+
+#include "Student.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace oop{
+
+    /**
+     * @struct UpdateReport
+     * @brief Outcome of a batch update: one bit per refused update and the number refused for each reason.
+     */
+    struct UpdateReport{
+        std::size_t updates = 0; /**< number of updates in the batch. */
+        std::size_t applied = 0; /**< number of updates written. */
+        std::size_t badIndices = 0; /**< updates refused because the index is past the end. */
+        std::size_t badValues = 0; /**< updates refused because the value is invalid (index in range). */
+        std::vector<std::uint64_t> errorMask; /**< bit i % 64 of word i / 64 is set if update i was refused. */
+
+        /** @brief Number of refused updates. */
+        std::size_t refused() const { return badIndices + badValues; }
+        /** @brief True if every update was applied. */
+        bool clean() const { return refused() == 0; }
+        /** @brief True if update i was refused. */
+        bool isRefused(std::size_t i) const { return (errorMask[i / 64] >> (i % 64)) & 1; }
+
+        /**
+         * @brief Positions of the refused updates in the batch.
+         * @return Positions in increasing order.
+         */
+        std::vector<std::size_t> refusedUpdates() const {
+            std::vector<std::size_t> positions;
+            positions.reserve(refused());
+            for(std::size_t w = 0; w < errorMask.size(); w++){
+                for(std::uint64_t word = errorMask[w]; word != 0; word &= word - 1){
+                    positions.push_back(w * 64 + static_cast<std::size_t>(std::countr_zero(word)));
+                }
+            }
+            return positions;
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const UpdateReport& report){
+            return os << report.applied << " of " << report.updates << " updates applied, "
+                      << report.badIndices << " bad indices, " << report.badValues << " invalid values";
+        }
+    };
+
+    /**
+     * @brief Validates and applies a batch block by block: each block of 64 updates gives one mask word, built
+     * without branching on the result, then the accepted updates of the block are written while they are in cache.
+     * @param updates Number of updates.
+     * @param badIndex Callable telling whether update i targets an index past the end.
+     * @param badValue Callable telling whether the value of update i is invalid.
+     * @param apply Callable writing update i, called in order for every accepted update.
+     * @return Report with the mask and the counts.
+     */
+    template<typename BadIndex, typename BadValue, typename Apply>
+    UpdateReport applyUpdates(std::size_t updates, BadIndex&& badIndex, BadValue&& badValue, Apply&& apply){
+        UpdateReport report;
+        report.updates = updates;
+        report.errorMask.resize((updates + 63) / 64);
+        for(std::size_t w = 0; w < report.errorMask.size(); w++){
+            std::size_t first = w * 64, last = std::min(updates, first + 64);
+            std::uint64_t indexBits = 0, valueBits = 0;
+            for(std::size_t i = first; i < last; i++){
+                indexBits |= static_cast<std::uint64_t>(badIndex(i)) << (i - first);
+                valueBits |= static_cast<std::uint64_t>(badValue(i)) << (i - first);
+            }
+            valueBits &= ~indexBits;
+            std::uint64_t refused = indexBits | valueBits;
+            report.errorMask[w] = refused;
+            report.badIndices += static_cast<std::size_t>(std::popcount(indexBits));
+            report.badValues += static_cast<std::size_t>(std::popcount(valueBits));
+
+            if (refused == 0){
+                for(std::size_t i = first; i < last; i++) apply(i);
+            } else {
+                for(std::uint64_t accepted = ~refused; accepted != 0; accepted &= accepted - 1){
+                    std::size_t i = first + static_cast<std::size_t>(std::countr_zero(accepted));
+                    if (i >= last) break;
+                    apply(i);
+                }
+            }
+        }
+        report.applied = updates - report.refused();
+        return report;
+    }
+
+    namespace detail{
+        inline void checkBatchSizes(std::size_t indices, std::size_t values, const char* what){
+            if (indices != values){
+                throw std::invalid_argument(std::string(what) + ": indices and values of different lengths");
+            }
+        }
+    }
+
+    /**
+     * @brief Sets the age of students[indices[i]] to ages[i] for every valid update, without writing diagnostics.
+     * @param students Students to update.
+     * @param indices Index of the student of each update; later updates of the same student win.
+     * @param ages New ages.
+     * @return Which updates were refused and why.
+     * @throws std::invalid_argument if indices and ages have different lengths.
+     */
+    inline UpdateReport setAges(std::span<Student> students, std::span<const std::size_t> indices, std::span<const int> ages){
+        detail::checkBatchSizes(indices.size(), ages.size(), "setAges");
+        UpdateReport report = applyUpdates(indices.size(),
+            [&](std::size_t i){ return indices[i] >= students.size(); },
+            [&](std::size_t i){ return !Student::isValidAge(ages[i]); },
+            [&](std::size_t i){ students[indices[i]].setAge(ages[i]); });
+        return report;
+    }
+
+    /**
+     * @brief Sets the grade of students[indices[i]] to grades[i] for every valid update, without writing diagnostics.
+     * Grade observers are notified of each applied update.
+     * @param students Students to update.
+     * @param indices Index of the student of each update; later updates of the same student win.
+     * @param grades New grades.
+     * @return Which updates were refused and why.
+     * @throws std::invalid_argument if indices and grades have different lengths.
+     */
+    inline UpdateReport setGrades(std::span<Student> students, std::span<const std::size_t> indices,
+                                  std::span<const double> grades){
+        detail::checkBatchSizes(indices.size(), grades.size(), "setGrades");
+        UpdateReport report = applyUpdates(indices.size(),
+            [&](std::size_t i){ return indices[i] >= students.size(); },
+            [&](std::size_t i){ return !Student::isValidGrade(grades[i]); },
+            [&](std::size_t i){ students[indices[i]].setGrade(grades[i]); });
+        return report;
+    }
+
+    /**
+     * @brief Sets the name of students[indices[i]] to names[i] for every valid update, without writing diagnostics.
+     * @param students Students to update.
+     * @param indices Index of the student of each update; later updates of the same student win.
+     * @param names New names.
+     * @return Which updates were refused and why.
+     * @throws std::invalid_argument if indices and names have different lengths.
+     */
+    inline UpdateReport setNames(std::span<Student> students, std::span<const std::size_t> indices,
+                                 std::span<const std::string_view> names){
+        detail::checkBatchSizes(indices.size(), names.size(), "setNames");
+        UpdateReport report = applyUpdates(indices.size(),
+            [&](std::size_t i){ return indices[i] >= students.size(); },
+            [&](std::size_t i){ return !Student::isValidName(names[i]); },
+            [&](std::size_t i){ students[indices[i]].setName(names[i]); });
+        return report;
+    }
+
+}
@@ -0,0 +1,264 @@
+/**
+ * @file CompactPerson.h
+ * @brief Declaration of CompactPerson, a Person with flat hobby storage, and PersonBatch, many people in one allocation.
+ */
+#pragma once
+
+#include "FlatStringList.h"
+#include "Person.h"
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iostream>
+#include <limits>
+#include <new>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace oop{
+
+    /**
+     * @class CompactPerson
+     * @brief Person whose hobbies live in a FlatStringList instead of a std::vector<std::string>.
+     *
+     * Like Person it relies on the compiler-generated copy and move operations (rule of zero), but a copy
+     * allocates at most three buffers (name, hobby characters, hobby offsets) whatever the number of hobbies.
+     */
+    class CompactPerson{
+    public:
+        std::string name;
+        int age = 0;
+        FlatStringList hobbies;
+
+        CompactPerson() = default;
+
+        CompactPerson(std::string name, int age, FlatStringList hobbies) :
+        name(std::move(name)), age(age), hobbies(std::move(hobbies)){}
+
+        CompactPerson(std::string name, int age, std::initializer_list<std::string_view> hobbies) :
+        name(std::move(name)), age(age), hobbies(hobbies){}
+
+        /**
+         * @brief Constructor that converts a Person, packing its hobbies.
+         * @param person Person to be converted.
+         */
+        explicit CompactPerson(const Person& person) :
+        name(person.name), age(person.age), hobbies(person.hobbies){}
+
+        /**
+         * @brief Constructor that converts a Person, taking over its name.
+         * @param person Person to be converted (its hobbies are copied into the flat list).
+         */
+        explicit CompactPerson(Person&& person) :
+        name(std::move(person.name)), age(person.age), hobbies(person.hobbies){}
+
+        /**
+         * @brief Converts back to a Person with one std::string per hobby.
+         * @return The equivalent Person.
+         */
+        Person toPerson() const {
+            return Person(name, age, hobbies.toVector());
+        }
+
+        void printHobbies() const {
+            std::cout<<"Hobbies:"<<std::endl;
+            for(std::string_view hobby : hobbies){
+                std::cout<<"- "<<hobby<<std::endl;
+            }
+        }
+    };
+
+    /**
+     * @class PersonBatch
+     * @brief Many people stored in a single buffer: fixed-size records, string end offsets and the characters.
+     *
+     * Building thousands of Person objects allocates a name and a hobby vector per person, plus one string
+     * per long hobby. A PersonBatch computes the space it needs up front (from a range of people, or from
+     * the counts given to the constructor) and makes one allocation for the whole batch. People are read
+     * back as PersonRef views and can be turned into Person objects on demand.
+     *
+     * The buffer holds only offsets, never pointers into itself, so the batch follows the rule of zero:
+     * its compiler-generated copy copies the buffer and its move takes it over, leaving an empty batch.
+     */
+    class PersonBatch{
+    public:
+        using size_type = std::size_t;
+        using Offset = StringListView::Offset;
+
+        /**
+         * @struct PersonRef
+         * @brief View of one person of a batch, valid while the batch is alive and not modified.
+         */
+        struct PersonRef{
+            std::string_view name;
+            int age;
+            StringListView hobbies;
+
+            /**
+             * @brief Copies the person out of the batch.
+             * @return An independent Person.
+             */
+            Person toPerson() const {
+                return Person(std::string(name), age, hobbies.toVector());
+            }
+        };
+
+    private:
+        // Sizes and fill levels, stored at the start of the buffer so that a moved-from batch is just empty
+        struct Header{
+            size_type people, peopleCapacity;
+            size_type strings, stringCapacity;
+            size_type characters, characterCapacity;
+        };
+
+        struct Record{
+            Offset firstString; /**< index of the name; the hobbies follow it. */
+            int age;
+        };
+
+        std::vector<std::byte> buffer; /**< Header, then Record[peopleCapacity], Offset[stringCapacity], characters. */
+
+        static constexpr size_type recordsAt = sizeof(Header);
+
+        Header& header(){ return *std::launder(reinterpret_cast<Header*>(buffer.data())); }
+        const Header& header() const { return *std::launder(reinterpret_cast<const Header*>(buffer.data())); }
+
+        const Record* records() const { return std::launder(reinterpret_cast<const Record*>(buffer.data() + recordsAt)); }
+        Record* records(){ return std::launder(reinterpret_cast<Record*>(buffer.data() + recordsAt)); }
+
+        size_type endsAt() const { return recordsAt + header().peopleCapacity * sizeof(Record); }
+        const Offset* ends() const { return std::launder(reinterpret_cast<const Offset*>(buffer.data() + endsAt())); }
+        Offset* ends(){ return std::launder(reinterpret_cast<Offset*>(buffer.data() + endsAt())); }
+
+        size_type charsAt() const { return endsAt() + header().stringCapacity * sizeof(Offset); }
+        const char* chars() const { return reinterpret_cast<const char*>(buffer.data() + charsAt()); }
+        char* chars(){ return reinterpret_cast<char*>(buffer.data() + charsAt()); }
+
+        void appendString(std::string_view text){
+            Header& h = header();
+            text.copy(chars() + h.characters, text.size());
+            h.characters += text.size();
+            ends()[h.strings++] = static_cast<Offset>(h.characters);
+        }
+
+    public:
+        PersonBatch() = default;
+
+        /**
+         * @brief Constructor that allocates room for a batch in one allocation.
+         * @param people Number of people the batch can hold.
+         * @param hobbies Total number of hobbies of those people.
+         * @param characters Total number of characters of their names and hobbies.
+         * @throws std::length_error if the characters do not fit 32-bit offsets.
+         */
+        PersonBatch(size_type people, size_type hobbies, size_type characters){
+            if (characters > std::numeric_limits<Offset>::max() || people + hobbies > std::numeric_limits<Offset>::max()){
+                throw std::length_error("PersonBatch: batch too large for 32-bit offsets");
+            }
+            static_assert(alignof(Record) <= alignof(Header) && alignof(Offset) <= alignof(Record));
+            buffer.resize(recordsAt + people * sizeof(Record) + (people + hobbies) * sizeof(Offset) + characters);
+            ::new (buffer.data()) Header{0, people, 0, people + hobbies, 0, characters};
+        }
+
+        /**
+         * @brief Builds a batch holding a copy of every person of a range, with exactly one allocation.
+         * @param people Range of Person, CompactPerson or anything with name, age and a range of hobbies.
+         * @return The batch.
+         */
+        template<typename Range>
+            requires std::ranges::forward_range<const Range&>
+        static PersonBatch from(const Range& people){
+            size_type count = 0, hobbies = 0, characters = 0;
+            for(const auto& person : people){
+                count++;
+                characters += person.name.size();
+                for(std::string_view hobby : person.hobbies){
+                    hobbies++;
+                    characters += hobby.size();
+                }
+            }
+            PersonBatch batch(count, hobbies, characters);
+            for(const auto& person : people) batch.add(person.name, person.age, person.hobbies);
+            return batch;
+        }
+
+        /**
+         * @brief Appends a person to the batch without allocating.
+         * @param name Name of the person.
+         * @param age Age of the person.
+         * @param hobbies Range of strings convertible to std::string_view.
+         * @throws std::length_error if the person does not fit in the room left; the batch is left unchanged.
+         */
+        template<typename Range>
+            requires std::convertible_to<std::ranges::range_reference_t<const Range&>, std::string_view>
+        void add(std::string_view name, int age, const Range& hobbies){
+            size_type strings = 1, characters = name.size();
+            for(std::string_view hobby : hobbies){
+                strings++;
+                characters += hobby.size();
+            }
+            const Header& h = buffer.empty() ? Header{} : header();
+            if (h.people == h.peopleCapacity || strings > h.stringCapacity - h.strings
+                || characters > h.characterCapacity - h.characters){
+                throw std::length_error("PersonBatch::add: batch is full");
+            }
+            Header& live = header();
+            records()[live.people] = Record{static_cast<Offset>(live.strings), age};
+            appendString(name);
+            for(std::string_view hobby : hobbies) appendString(hobby);
+            live.people++;
+        }
+
+        /**
+         * @brief Appends a person to the batch without allocating.
+         * @param name Name of the person.
+         * @param age Age of the person.
+         * @param hobbies Hobbies of the person.
+         */
+        void add(std::string_view name, int age, std::initializer_list<std::string_view> hobbies){
+            add<std::initializer_list<std::string_view>>(name, age, hobbies);
+        }
+
+        /** @brief Number of people in the batch. */
+        size_type size() const { return buffer.empty() ? 0 : header().people; }
+        /** @brief True if the batch holds nobody. */
+        bool empty() const { return size() == 0; }
+        /** @brief Number of people the batch can hold. */
+        size_type capacity() const { return buffer.empty() ? 0 : header().peopleCapacity; }
+        /** @brief Size in bytes of the single buffer of the batch. */
+        size_type bytes() const { return buffer.size(); }
+
+        /**
+         * @brief Returns a view of the person at index.
+         * @param index Index of the person (not checked).
+         * @return View of the name, age and hobbies of the person.
+         */
+        PersonRef operator[](size_type index) const {
+            const Header& h = header();
+            const Record& record = records()[index];
+            Offset last = index + 1 < h.people ? records()[index + 1].firstString : static_cast<Offset>(h.strings);
+            std::string_view name = StringListView(chars(), ends(), 0, h.strings)[record.firstString];
+            StringListView hobbies(chars(), ends() + record.firstString + 1, ends()[record.firstString],
+                                   last - record.firstString - 1);
+            return PersonRef{name, record.age, hobbies};
+        }
+
+        /**
+         * @brief Copies every person out of the batch.
+         * @return One Person per entry, in order.
+         */
+        std::vector<Person> toPeople() const {
+            std::vector<Person> people;
+            people.reserve(size());
+            for(size_type i = 0; i < size(); i++) people.push_back((*this)[i].toPerson());
+            return people;
+        }
+    };
+
+}
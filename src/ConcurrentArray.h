@@ -0,0 +1,303 @@
+/**
+ * @file ConcurrentArray.h
+ * @brief Declaration of the ConcurrentArray class, an append-only array that many threads push into without a lock.
+ */
+#pragma once
+
+#include "AlignedAllocator.h"
+#include "DynamicArray.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace oop{
+
+    /**
+     * @class ConcurrentArray
+     * @brief Append-only array whose push_back() can be called from many threads at once without a lock.
+     * @tparam T Type of the elements stored in the array.
+     * @tparam FirstSegmentSize Number of elements of the first segment, a power of two.
+     *
+     * A push_back() reserves its index with one atomic increment, so writers never wait for each other.
+     * The elements live in segments of FirstSegmentSize, 2 * FirstSegmentSize, 4 * FirstSegmentSize, ...
+     * elements that are allocated on first use and never move, so the index of an element gives its
+     * segment with a bit scan and published elements can be read while other threads keep appending.
+     * The thread that first needs a segment allocates it and installs it with a compare-and-swap; a thread
+     * that loses the race frees its own copy and uses the winner's.
+     *
+     * An element is published by setting its bit in the ready mask of its segment once it is constructed.
+     * Indices are handed out in order but elements may be published out of order: operator[] must only be
+     * used on published elements (isPublished(), tryGet()), and snapshot() copies the longest published
+     * prefix. Once the writers are joined every index is published, except the failed() ones whose
+     * push_back() threw: they stay holes that publishedPrefix() and snapshot() stop at.
+     */
+    template<typename T, std::size_t FirstSegmentSize = 1024>
+    class ConcurrentArray{
+        static_assert(std::has_single_bit(FirstSegmentSize), "the first segment size must be a power of two");
+
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+
+    private:
+        using Word = std::uint64_t;
+        using Alloc = AlignedAllocator<T>;
+        using AllocTraits = std::allocator_traits<Alloc>;
+
+        static constexpr int firstShift = std::countr_zero(FirstSegmentSize);
+        static constexpr size_type wordBits = 64;
+        /** Enough segments for 2^47 elements; the table itself is a few hundred bytes. */
+        static constexpr size_type maxSegments = 48 - firstShift;
+
+        struct Segment{
+            T* data;
+            std::unique_ptr<std::atomic<Word>[]> ready; /**< one bit per element, set once it is constructed. */
+        };
+
+        struct Location{
+            size_type segment;
+            size_type offset;
+        };
+
+        static constexpr size_type segmentSize(size_type segment){ return FirstSegmentSize << segment; }
+        static constexpr size_type segmentStart(size_type segment){ return (FirstSegmentSize << segment) - FirstSegmentSize; }
+
+        // Segment k holds the indices [FirstSegmentSize * (2^k - 1), FirstSegmentSize * (2^(k+1) - 1))
+        static Location locate(size_type index){
+            size_type segment = std::bit_width((index >> firstShift) + 1) - 1;
+            return {segment, index - segmentStart(segment)};
+        }
+
+        alignas(cacheLineSize) std::atomic<size_type> reserved{0}; /**< indices handed out to writers. */
+        std::atomic<size_type> abandoned{0}; /**< indices whose push_back() threw, never published. */
+        alignas(cacheLineSize) std::array<std::atomic<Segment*>, maxSegments> segments{};
+
+        static Segment* allocateSegment(size_type segment){
+            size_type n = segmentSize(segment);
+            Alloc alloc;
+            T* data = AllocTraits::allocate(alloc, n);
+            try {
+                return new Segment{data, std::unique_ptr<std::atomic<Word>[]>(new std::atomic<Word>[(n + wordBits - 1) / wordBits]())};
+            } catch (...) {
+                AllocTraits::deallocate(alloc, data, n);
+                throw;
+            }
+        }
+
+        static void freeSegment(Segment* s, size_type segment){
+            Alloc alloc;
+            AllocTraits::deallocate(alloc, s->data, segmentSize(segment));
+            delete s;
+        }
+
+        // Returns the segment, allocating and installing it if no thread did yet
+        Segment* segmentAt(size_type segment){
+            Segment* s = segments[segment].load(std::memory_order_acquire);
+            if (s != nullptr) return s;
+            Segment* fresh = allocateSegment(segment);
+            if (segments[segment].compare_exchange_strong(s, fresh, std::memory_order_acq_rel, std::memory_order_acquire)){
+                return fresh;
+            }
+            freeSegment(fresh, segment); // another thread installed it first; s now holds its segment
+            return s;
+        }
+
+        // Destroys the published elements and frees every segment
+        void release() noexcept {
+            size_type count = reserved.load(std::memory_order_acquire);
+            for(size_type k = 0; k < maxSegments; k++){
+                Segment* s = segments[k].load(std::memory_order_acquire);
+                if (s == nullptr) continue;
+                if constexpr (!std::is_trivially_destructible_v<T>){
+                    size_type start = segmentStart(k);
+                    for(size_type offset = 0; offset < segmentSize(k) && start + offset < count; offset++){
+                        if (readyBit(s, offset, std::memory_order_relaxed)) std::destroy_at(s->data + offset);
+                    }
+                }
+                freeSegment(s, k);
+            }
+        }
+
+        static bool readyBit(const Segment* s, size_type offset, std::memory_order order){
+            return (s->ready[offset / wordBits].load(order) >> (offset % wordBits)) & 1;
+        }
+
+    public:
+        /**
+         * @brief Constructor of an empty array; the first segment is allocated by the first push_back().
+         */
+        ConcurrentArray() = default;
+
+        /**
+         * @brief Constructor that allocates the segments for capacity elements up front.
+         * @param capacity Number of elements that can be pushed without allocating.
+         */
+        explicit ConcurrentArray(size_type capacity){
+            try {
+                reserve(capacity);
+            } catch (...) {
+                release();
+                throw;
+            }
+        }
+
+        ConcurrentArray(const ConcurrentArray&) = delete;
+        ConcurrentArray& operator=(const ConcurrentArray&) = delete;
+
+        /**
+         * @brief Destructor that destroys the published elements and frees the segments.
+         *
+         * No thread may be pushing or reading while the array is destroyed.
+         */
+        ~ConcurrentArray(){
+            release();
+        }
+
+        /**
+         * @brief Allocates the segments needed to hold capacity elements, so that writers do not race to allocate.
+         * @param capacity Minimum number of elements the array can hold without allocating.
+         * @throws std::length_error if capacity is beyond the largest segment.
+         */
+        void reserve(size_type capacity){
+            if (capacity == 0) return;
+            Location last = locate(capacity - 1);
+            if (last.segment >= maxSegments) throw std::length_error("ConcurrentArray::reserve: capacity too large");
+            for(size_type k = 0; k <= last.segment; k++) segmentAt(k);
+        }
+
+        /**
+         * @brief Constructs a new element at the next free index; safe to call from many threads.
+         * @param args Arguments forwarded to the constructor of the element.
+         * @return Index of the new element.
+         * @throws std::length_error if the array is full.
+         *
+         * If the array fills up under a concurrent push_back(), the segment cannot be allocated or the constructor
+         * of the element throws, the index stays unpublished, is counted by failed() and snapshot() stops before it.
+         */
+        template<typename... Args>
+        size_type emplace_back(Args&&... args){
+            if (locate(reserved.load(std::memory_order_relaxed)).segment >= maxSegments){
+                throw std::length_error("ConcurrentArray::push_back: array is full"); // no index is taken
+            }
+            size_type index = reserved.fetch_add(1, std::memory_order_relaxed);
+            Location at = locate(index);
+            Segment* s;
+            try {
+                if (at.segment >= maxSegments) throw std::length_error("ConcurrentArray::push_back: array is full");
+                s = segmentAt(at.segment);
+                std::construct_at(s->data + at.offset, std::forward<Args>(args)...);
+            } catch (...) {
+                abandoned.fetch_add(1, std::memory_order_relaxed);
+                throw;
+            }
+            s->ready[at.offset / wordBits].fetch_or(Word{1} << (at.offset % wordBits), std::memory_order_release);
+            return index;
+        }
+
+        /**
+         * @brief Appends a copy of value; safe to call from many threads.
+         * @param value Element to be appended.
+         * @return Index of the new element.
+         */
+        size_type push_back(const T& value){ return emplace_back(value); }
+
+        /**
+         * @brief Appends value by moving it; safe to call from many threads.
+         * @param value Element to be appended.
+         * @return Index of the new element.
+         */
+        size_type push_back(T&& value){ return emplace_back(std::move(value)); }
+
+        /**
+         * @brief Returns the number of indices handed out by push_back().
+         * @return The size of the array, failed() indices included; while writers run, some of these elements
+         * may not be published yet.
+         */
+        size_type size() const { return reserved.load(std::memory_order_acquire); }
+
+        /**
+         * @brief Returns the number of indices whose push_back() threw; they hold no element and are never published.
+         * @return The number of abandoned indices.
+         */
+        size_type failed() const { return abandoned.load(std::memory_order_acquire); }
+
+        /**
+         * @brief Checks whether the element at index has been constructed and can be read.
+         * @param index Index of the element.
+         * @return True if the element is published.
+         */
+        bool isPublished(size_type index) const {
+            if (index >= reserved.load(std::memory_order_acquire)) return false;
+            Location at = locate(index);
+            const Segment* s = segments[at.segment].load(std::memory_order_acquire);
+            return s != nullptr && readyBit(s, at.offset, std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Read access to a published element.
+         * @param index Index of a published element (not checked).
+         * @return Const reference to the element; it stays valid while the array is alive.
+         */
+        const T& operator[](size_type index) const {
+            Location at = locate(index);
+            return segments[at.segment].load(std::memory_order_acquire)->data[at.offset];
+        }
+
+        /**
+         * @brief Checked read access to an element that may still be written.
+         * @param index Index of the element.
+         * @return Pointer to the element, or nullptr if it is not published yet.
+         */
+        const T* tryGet(size_type index) const {
+            return isPublished(index) ? &(*this)[index] : nullptr;
+        }
+
+        /**
+         * @brief Returns the number of leading elements that are all published.
+         * @return The length of the longest published prefix.
+         */
+        size_type publishedPrefix() const {
+            size_type count = reserved.load(std::memory_order_acquire);
+            size_type prefix = 0;
+            for(size_type k = 0; prefix < count; k++){
+                const Segment* s = segments[k].load(std::memory_order_acquire);
+                if (s == nullptr) return prefix;
+                size_type inSegment = std::min(segmentSize(k), count - prefix);
+                for(size_type w = 0; w * wordBits < inSegment; w++){
+                    size_type bitsInWord = std::min(wordBits, inSegment - w * wordBits);
+                    size_type run = std::min<size_type>(std::countr_one(s->ready[w].load(std::memory_order_acquire)), bitsInWord);
+                    prefix += run;
+                    if (run < bitsInWord) return prefix;
+                }
+            }
+            return prefix;
+        }
+
+        /**
+         * @brief Copies the published prefix into a contiguous array; safe while other threads push.
+         * @return A DynamicArray holding the elements [0, publishedPrefix()) in order.
+         */
+        DynamicArray<T> snapshot() const {
+            size_type n = publishedPrefix();
+            DynamicArray<T> copy;
+            copy.reserve(n);
+            for(size_type k = 0, copied = 0; copied < n; k++){
+                const T* data = segments[k].load(std::memory_order_acquire)->data;
+                size_type take = std::min(segmentSize(k), n - copied);
+                for(size_type i = 0; i < take; i++) copy.push_back(data[i]);
+                copied += take;
+            }
+            return copy;
+        }
+    };
+
+}
@@ -0,0 +1,143 @@
+/**
+ * @file CourseCatalog.h
+ * @brief Declaration of the CourseCatalog class, which stores each course once and names it by a 32-bit ID.
+ */
+#pragma once
+
+#include "StringInterner.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace oop{
+
+    /**
+     * @class CourseCatalog
+     * @brief Dictionary of courses: each distinct (name, year) pair gets a dense 32-bit ID.
+     *
+     * Students enrolled in a course keep its ID instead of a copy of its name, and EnrollmentIndex uses the IDs
+     * as row numbers. intern() and find() may be called from several threads.
+     */
+    class CourseCatalog{
+    public:
+        using Id = std::uint32_t;
+
+        /**
+         * @struct CourseInfo
+         * @brief Name and year of a course; the name stays valid as long as the catalog lives.
+         */
+        struct CourseInfo{
+            std::string_view name;
+            int year;
+        };
+
+    private:
+        struct Record{
+            StringInterner::Id nameId;
+            int year;
+        };
+
+        StringInterner names; /**< course names, shared by every year of a course. */
+        std::vector<Record> records; /**< course of every ID. */
+        std::unordered_map<std::uint64_t, Id> lookup; /**< ID of every (name, year) pair. */
+        mutable std::shared_mutex mutex; /**< guards records and lookup. */
+
+        static std::uint64_t keyOf(StringInterner::Id nameId, int year){
+            return (std::uint64_t{nameId} << 32) | static_cast<std::uint32_t>(year);
+        }
+
+    public:
+        CourseCatalog() = default;
+
+        CourseCatalog(const CourseCatalog&) = delete;
+        CourseCatalog& operator=(const CourseCatalog&) = delete;
+
+        /**
+         * @brief Catalog used by Student::enroll().
+         * @return Reference to the global catalog.
+         */
+        static CourseCatalog& global(){
+            static CourseCatalog catalog;
+            return catalog;
+        }
+
+        /**
+         * @brief Returns the ID of a course, adding it first if it is new.
+         * @param name Name of the course.
+         * @param year Year of the course.
+         * @return The ID of the course, the same for every equal (name, year) pair.
+         * @throws std::length_error if every 32-bit ID is in use.
+         */
+        Id intern(std::string_view name, int year){
+            std::uint64_t key = keyOf(names.intern(name), year);
+            {
+                std::shared_lock<std::shared_mutex> lock(mutex);
+                auto found = lookup.find(key);
+                if (found != lookup.end()) return found->second;
+            }
+            std::unique_lock<std::shared_mutex> lock(mutex);
+            auto found = lookup.find(key);
+            if (found != lookup.end()) return found->second;
+
+            if (records.size() > std::numeric_limits<Id>::max()){
+                throw std::length_error("CourseCatalog: out of IDs");
+            }
+            Id id = static_cast<Id>(records.size());
+            records.push_back({static_cast<StringInterner::Id>(key >> 32), year});
+            try {
+                lookup.emplace(key, id);
+            } catch (...) {
+                records.pop_back();
+                throw;
+            }
+            return id;
+        }
+
+        /**
+         * @brief Looks up a course without adding it.
+         * @param name Name of the course.
+         * @param year Year of the course.
+         * @return Its ID, or no value if it was never interned.
+         */
+        std::optional<Id> find(std::string_view name, int year) const{
+            std::optional<StringInterner::Id> nameId = names.find(name);
+            if (!nameId) return std::nullopt;
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            auto found = lookup.find(keyOf(*nameId, year));
+            if (found == lookup.end()) return std::nullopt;
+            return found->second;
+        }
+
+        /**
+         * @brief Returns the course with the given ID.
+         * @param id ID returned by intern().
+         * @return Name and year of the course.
+         */
+        CourseInfo get(Id id) const{
+            Record record;
+            {
+                std::shared_lock<std::shared_mutex> lock(mutex);
+                record = records[id];
+            }
+            return {names.view(record.nameId), record.year};
+        }
+
+        /**
+         * @brief Returns the number of distinct courses.
+         * @return The number of IDs in use.
+         */
+        std::size_t size() const{
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            return records.size();
+        }
+    };
+
+}
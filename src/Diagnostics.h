@@ -0,0 +1,148 @@
+/**
+ * @file Diagnostics.h
+ * @brief Declaration of DiagnosticsSink, where the setters of Student and StudentTable report invalid values.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <string_view>
+
+namespace oop{
+
+    /**
+     * @class DiagnosticsSink
+     * @brief Thread-safe destination of diagnostic messages, optionally buffered and rate limited.
+     *
+     * By default every message is written to std::cerr and flushed, like std::endl. A program that may feed
+     * many invalid values can turn the flush off, so messages reach the stream in the buffered writes of the
+     * stream, and cap the number of messages written per second; the messages over the cap are counted and
+     * summed up in one line when the next second starts or on flush().
+     */
+    class DiagnosticsSink{
+    private:
+        std::mutex mutex;
+        std::ostream* out = &std::cerr;
+        bool flushEach = true;
+        std::size_t maxPerSecond = 0; /**< 0 means no limit. */
+
+        std::chrono::steady_clock::time_point windowStart{};
+        std::size_t inWindow = 0; /**< messages written in the current second. */
+        std::uint64_t pending = 0; /**< messages suppressed in the current second, not yet summed up. */
+        std::uint64_t written = 0;
+        std::uint64_t suppressedTotal = 0;
+
+        void writePending(){
+            if (pending > 0){
+                *out << "(" << pending << " more diagnostics suppressed)\n";
+                pending = 0;
+            }
+        }
+
+    public:
+        DiagnosticsSink() = default;
+
+        /**
+         * @brief Constructor of a sink writing to a given stream.
+         * @param out Stream the messages are written to, not owned.
+         * @param flushEach True to flush the stream after every message.
+         * @param maxPerSecond Maximum number of messages written per second, 0 for no limit.
+         */
+        DiagnosticsSink(std::ostream& out, bool flushEach, std::size_t maxPerSecond = 0) :
+        out(&out), flushEach(flushEach), maxPerSecond(maxPerSecond){}
+
+        /**
+         * @brief Destructor that writes the summary of the suppressed messages, if any, and flushes the stream.
+         *
+         * So the summary of the last second of global() still reaches std::cerr at exit. The stream must
+         * outlive the sink.
+         */
+        ~DiagnosticsSink(){
+            try {
+                writePending();
+                out->flush();
+            } catch (...) {
+                // a stream that throws must not end the program from a destructor
+            }
+        }
+
+        DiagnosticsSink(const DiagnosticsSink&) = delete;
+        DiagnosticsSink& operator=(const DiagnosticsSink&) = delete;
+
+        /**
+         * @brief Sink used by the setters of Student and StudentTable.
+         * @return Reference to the global sink.
+         */
+        static DiagnosticsSink& global(){
+            static DiagnosticsSink sink;
+            return sink;
+        }
+
+        /**
+         * @brief Changes where and how messages are written; the summary of suppressed messages is written first.
+         * @param newOut Stream the messages are written to, not owned.
+         * @param newFlushEach True to flush the stream after every message.
+         * @param newMaxPerSecond Maximum number of messages written per second, 0 for no limit.
+         */
+        void configure(std::ostream& newOut, bool newFlushEach, std::size_t newMaxPerSecond = 0){
+            std::lock_guard<std::mutex> lock(mutex);
+            writePending();
+            out->flush();
+            out = &newOut;
+            flushEach = newFlushEach;
+            maxPerSecond = newMaxPerSecond;
+            inWindow = 0;
+            windowStart = {};
+        }
+
+        /**
+         * @brief Writes a message on its own line, unless the limit of the current second was reached.
+         * @param message Text of the message.
+         */
+        void report(std::string_view message){
+            std::lock_guard<std::mutex> lock(mutex);
+            if (maxPerSecond > 0){
+                auto now = std::chrono::steady_clock::now();
+                if (now - windowStart >= std::chrono::seconds(1)){
+                    writePending();
+                    windowStart = now;
+                    inWindow = 0;
+                }
+                if (inWindow == maxPerSecond){
+                    pending++;
+                    suppressedTotal++;
+                    return;
+                }
+                inWindow++;
+            }
+            *out << message << '\n';
+            written++;
+            if (flushEach) out->flush();
+        }
+
+        /**
+         * @brief Writes the summary of the suppressed messages, if any, and flushes the stream.
+         */
+        void flush(){
+            std::lock_guard<std::mutex> lock(mutex);
+            writePending();
+            out->flush();
+        }
+
+        /** @brief Number of messages written so far. */
+        std::uint64_t reported(){
+            std::lock_guard<std::mutex> lock(mutex);
+            return written;
+        }
+
+        /** @brief Number of messages dropped by the rate limit so far. */
+        std::uint64_t suppressed(){
+            std::lock_guard<std::mutex> lock(mutex);
+            return suppressedTotal;
+        }
+    };
+
+}
@@ -1,10 +1,25 @@
 /**
  * @file DynamicArray.h
- * @brief Declaration of the DynamicArray and DynamicArrayVector classes for dynamic arrays management.
+ * @brief Declaration of the DynamicArray and DynamicArrayVector classes for dynamic arrays management, and of StaticArray.
  */
 #pragma once
 
+#include "AlignedAllocator.h"
+#include "ArrayExpression.h"
+#include "InstanceCounter.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <initializer_list>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 /**
@@ -13,19 +28,29 @@
  */
 namespace oop{
 
+    class DynamicArrayVector;
+
+    template<>
+    inline constexpr std::string_view instrument::probeName<DynamicArrayVector> = "DynamicArrayVector";
+
     /**
      * @class DynamicArrayVector
      * @brief A class that represents a dynamic array implemented using std::vector instead of raw pointers for memory management.
+     *
+     * Its lifecycle is counted by InstanceCounted, and in instrumented builds the vector reports its allocations.
      */
-    class DynamicArrayVector{
+    class DynamicArrayVector : public InstanceCounted<DynamicArrayVector>{
     private:
         
         int* ptr; // ptr to the memory allocated to the array
         int arrSize; // size of the array
 
-        std::vector<int> array;
+        using Storage = std::vector<int, instrument::TrackedAllocator<int, DynamicArrayVector>>;
+
+        Storage array;
 
     public:
+        using value_type = int;
     
         /**
          * @brief Constructor that takes int and initializes array with that size
@@ -39,6 +64,19 @@ namespace oop{
          */
         DynamicArrayVector(int size, int value) : array(size, value){}
 
+        /**
+         * @brief Constructor that materializes a concatenation (DynamicArrayVector c = a + b;)
+         * @param expr Lazy concatenation returned by operator+, copied with a single allocation of the final size
+         */
+        template<LazyArrayExpression E>
+            requires std::is_same_v<typename E::value_type, int>
+        DynamicArrayVector(const E& expr){
+            array.reserve(expr.size());
+            expr.forEachSegment([this](const int* first, const int* last){
+                array.insert(array.end(), first, last);
+            });
+        }
+
         /**
          * @brief size method returns the size of the dynamic array.
          * @return The size of the array.
@@ -58,21 +96,34 @@ namespace oop{
         }
 
         /**
-         * @brief Addition operator to concatenate two arrays
-         * @param other The second DynamicArrayVector to be concatenated.
-         * @return A new DynamicArrayVector containing elements from both arrays.
+         * @brief Overloading [] operator to read elements of a const array.
+         * @param index Index of the element to be accessed.
+         * @return Const reference to the element at the given index.
          */
-        DynamicArrayVector operator+(const DynamicArrayVector& other) const{
-            DynamicArrayVector result(0); // initialize new result array size 0
+        const int& operator[](int index) const {
+            return array[index];
+        }
 
-            // Insert the current array's elements into result
-            result.array.insert(result.array.begin(), array.begin(), array.end());
+        /**
+         * @brief Pointer to the first element of the underlying vector.
+         * @return Pointer to the elements of the array.
+         */
+        int* data() { return array.data(); }
 
-            // Insert the other array's elements into result
-            result.array.insert(result.array.end(), other.array.begin(), other.array.end());
+        /**
+         * @brief Pointer to the first element of the underlying vector.
+         * @return Const pointer to the elements of the array.
+         */
+        const int* data() const { return array.data(); }
 
-            return result;
-        }
+        /** @brief Iterator to the first element. */
+        Storage::iterator begin() { return array.begin(); }
+        /** @brief Iterator past the last element. */
+        Storage::iterator end() { return array.end(); }
+        /** @brief Const iterator to the first element. */
+        Storage::const_iterator begin() const { return array.begin(); }
+        /** @brief Const iterator past the last element. */
+        Storage::const_iterator end() const { return array.end(); }
 
         /**
          * @brief Operator overloading on ostream, implementing operator as a free function to access private variables
@@ -96,46 +147,517 @@ namespace oop{
     };
 
 
+    namespace detail{
+
+        // Uninitialized memory for N elements stored inside the array object
+        template<typename T, std::size_t N>
+        struct InlineStorage{
+            alignas(T) unsigned char bytes[N * sizeof(T)];
+
+            T* data() noexcept { return reinterpret_cast<T*>(bytes); }
+        };
+
+        // Without inline capacity no space is used at all
+        template<typename T>
+        struct InlineStorage<T, 0>{
+            T* data() noexcept { return nullptr; }
+        };
+    }
+
+    /**
+     * @brief Tag type selecting the constructor that leaves trivial elements uninitialized.
+     */
+    struct DefaultInitTag{
+        explicit DefaultInitTag() = default;
+    };
+
+    /**
+     * @brief Tag value for DynamicArray(size, defaultInit): elements are default-initialized like new int[size].
+     */
+    inline constexpr DefaultInitTag defaultInit{};
+
+    namespace detail{
+
+        // Every DynamicArray instantiation is counted under this one tag
+        struct DynamicArrayCounterTag{};
+    }
+
+    template<>
+    inline constexpr std::string_view instrument::probeName<detail::DynamicArrayCounterTag> = "DynamicArray";
+
+    /**
+     * @brief Default number of elements a DynamicArray stores inline: as many as fit in 64 bytes (16 ints).
+     */
+    template<typename T>
+    inline constexpr std::size_t defaultInlineCapacity = sizeof(T) <= 64 ? 64 / sizeof(T) : 0;
+
+    /**
+     * @class StaticArray
+     * @brief Array whose size N is part of its type, stored inside the object and usable in constant expressions.
+     * @tparam T Type of the elements stored in the array.
+     * @tparam N Number of elements.
+     *
+     * It has the operator[], size(), operator+ and operator<< of DynamicArray, but no heap memory and no
+     * runtime size: size() is a constant and concatenating a StaticArray<T, N> with a StaticArray<T, M>
+     * gives a StaticArray<T, N + M>. It is an aggregate (StaticArray<int, 3> a{1, 2, 3};) and every
+     * operation except operator<< is constexpr, so lookup tables can be computed at compile time (see
+     * makeStaticArray()). A DynamicArray can be constructed from it with a single copy of the elements.
+     */
+    template<typename T, std::size_t N>
+    struct StaticArray{
+        using value_type = T;
+        using size_type = std::size_t;
+        using reference = T&;
+        using const_reference = const T&;
+        using iterator = T*;
+        using const_iterator = const T*;
+
+        std::array<T, N> elements; /**< the elements; public only so that the array is an aggregate. */
+
+        /**
+         * @brief Returns the number of elements.
+         * @return N.
+         */
+        static constexpr size_type size() noexcept { return N; }
+
+        /**
+         * @brief Checks whether the array has no elements.
+         * @return True if N is 0.
+         */
+        static constexpr bool empty() noexcept { return N == 0; }
+
+        /**
+         * @brief Access to the element at index.
+         * @param index Index of the element (not checked).
+         * @return Reference to the element.
+         */
+        constexpr T& operator[](size_type index){ return elements[index]; }
+
+        /**
+         * @brief Read access to the element at index.
+         * @param index Index of the element (not checked).
+         * @return Const reference to the element.
+         */
+        constexpr const T& operator[](size_type index) const { return elements[index]; }
+
+        /**
+         * @brief Checked access to the element at index; in a constant expression an invalid index fails to compile.
+         * @param index Index of the element.
+         * @return Reference to the element.
+         * @throws std::out_of_range if index is not smaller than N.
+         */
+        constexpr T& at(size_type index){
+            if (index >= N) throw std::out_of_range("StaticArray::at: index out of range");
+            return elements[index];
+        }
+
+        /**
+         * @brief Checked read access to the element at index.
+         * @param index Index of the element.
+         * @return Const reference to the element.
+         * @throws std::out_of_range if index is not smaller than N.
+         */
+        constexpr const T& at(size_type index) const {
+            if (index >= N) throw std::out_of_range("StaticArray::at: index out of range");
+            return elements[index];
+        }
+
+        /** @brief Pointer to the first element. */
+        constexpr T* data() noexcept { return elements.data(); }
+        /** @brief Const pointer to the first element. */
+        constexpr const T* data() const noexcept { return elements.data(); }
+        /** @brief Iterator to the first element. */
+        constexpr T* begin() noexcept { return elements.data(); }
+        /** @brief Iterator past the last element. */
+        constexpr T* end() noexcept { return elements.data() + N; }
+        /** @brief Const iterator to the first element. */
+        constexpr const T* begin() const noexcept { return elements.data(); }
+        /** @brief Const iterator past the last element. */
+        constexpr const T* end() const noexcept { return elements.data() + N; }
+
+        /**
+         * @brief Assigns value to every element.
+         * @param value Value of the elements.
+         */
+        constexpr void fill(const T& value){
+            for(T& element : elements) element = value;
+        }
+
+        /**
+         * @brief Compares two arrays element by element.
+         */
+        friend constexpr bool operator==(const StaticArray&, const StaticArray&) = default;
+
+        /**
+         * @brief Operator overloading on ostream, in the same [a, b, c] form as DynamicArray.
+         * @param os Output stream object.
+         * @param other StaticArray to be printed.
+         * @return Output stream object.
+         */
+        friend std::ostream& operator<<(std::ostream& os, const StaticArray& other) {
+            os << "[";
+            for(size_type i = 0; i < N; i++){
+                os << other.elements[i];
+                if (i != N - 1){
+                    os << ", ";
+                }
+            }
+            os << "]";
+            return os;
+        }
+    };
+
+    /**
+     * @brief Deduces the type and size of a StaticArray from its elements (StaticArray a{1, 2, 3};)
+     */
+    template<typename T, typename... U>
+        requires (std::is_same_v<T, U> && ...)
+    StaticArray(T, U...) -> StaticArray<T, 1 + sizeof...(U)>;
+
+    namespace detail{
+
+        template<typename T>
+        inline constexpr bool isStaticArray = false;
+
+        template<typename T, std::size_t N>
+        inline constexpr bool isStaticArray<StaticArray<T, N>> = true;
+    }
+
+    template<typename T, std::size_t N>
+    inline constexpr bool isConcatOperand<StaticArray<T, N>> = true;
+
+    /**
+     * @brief Concatenates two StaticArray eagerly; the size of the result is computed at compile time.
+     * @param left The first array.
+     * @param right The second array.
+     * @return A StaticArray<T, N + M> holding the elements of left, then those of right.
+     *
+     * A StaticArray added to any other array expression goes through the lazy operator+ instead.
+     */
+    template<typename L, typename R>
+        requires ConcatenableExpressions<L, R>
+            && detail::isStaticArray<std::remove_cvref_t<L>> && detail::isStaticArray<std::remove_cvref_t<R>>
+    constexpr auto operator+(L&& left, R&& right){
+        constexpr std::size_t n = std::remove_cvref_t<L>::size();
+        constexpr std::size_t m = std::remove_cvref_t<R>::size();
+        StaticArray<typename std::remove_cvref_t<L>::value_type, n + m> result{};
+        for(std::size_t i = 0; i < n; i++) result[i] = std::forward<L>(left)[i];
+        for(std::size_t i = 0; i < m; i++) result[n + i] = std::forward<R>(right)[i];
+        return result;
+    }
+
+    /**
+     * @brief Builds a StaticArray<T, N> whose element i is f(i), at compile time when used in a constant expression.
+     * @tparam N Number of elements.
+     * @param f Callable taking the index (std::size_t) and returning the element.
+     * @return The array of the N values.
+     */
+    template<std::size_t N, typename F>
+    constexpr auto makeStaticArray(F&& f){
+        using T = std::remove_cvref_t<std::invoke_result_t<F&, std::size_t>>;
+        StaticArray<T, N> result{};
+        for(std::size_t i = 0; i < N; i++) result[i] = f(i);
+        return result;
+    }
+
     /**
      * @class DynamicArray
-     * @brief A class that represents a dynamic array implemented using raw pointers for memory management.
+     * @brief A class that represents a growable dynamic array implemented using raw pointers for memory management.
+     * @tparam T Type of the elements stored in the array (int by default).
+     * @tparam Alloc Allocator used to obtain and release the element storage (64-byte aligned by default).
+     * @tparam InlineCapacity Number of elements stored inside the object itself before the heap is used.
+     *
+     * The capacity of the array is kept separate from its size and grows geometrically, so appending
+     * N elements with push_back() costs amortized O(1) per element instead of one reallocation each.
+     * When the buffer is reallocated the elements are moved if T is nothrow-movable and copied otherwise.
+     *
+     * Arrays of up to InlineCapacity elements live in a small buffer inside the object and never call the
+     * allocator. Moving such an array moves its elements one by one instead of stealing a pointer.
+     *
+     * The lifecycle of all DynamicArray objects, whatever their element type, is reported by instanceStats().
      */
+    template<typename T = int, typename Alloc = AlignedAllocator<T>, std::size_t InlineCapacity = defaultInlineCapacity<T>>
+    class DynamicArray : public InstanceCounted<detail::DynamicArrayCounterTag>{
+    public:
+        using value_type = T;
+        using allocator_type = Alloc;
+        using size_type = std::size_t;
+        using reference = T&;
+        using const_reference = const T&;
+        using iterator = T*;
+        using const_iterator = const T*;
+
+        /** @brief Number of elements that fit in the inline buffer. */
+        static constexpr size_type inlineCapacity = InlineCapacity;
 
-    class DynamicArray{
     private:
-        int* ptr; /**< ptr to the memory allocated to the array. */
-        int arrSize; /**< size of the array. */
+        using AllocTraits = std::allocator_traits<Alloc>;
+        using Counted = InstanceCounted<detail::DynamicArrayCounterTag>;
+
+        [[no_unique_address]] Alloc alloc; /**< allocator that owns the heap memory of the array. */
+        [[no_unique_address]] detail::InlineStorage<T, InlineCapacity> storage; /**< inline buffer for small arrays. */
+        T* ptr = storage.data(); /**< ptr to the memory holding the array (the inline buffer or the heap). */
+        size_type arrSize = 0; /**< size of the array. */
+        size_type arrCapacity = InlineCapacity; /**< number of elements that fit in the current memory. */
+
+        static constexpr size_type minCapacity = 4; /**< smallest capacity allocated when growing. */
+
+        // Allocates uninitialized memory for n elements (nullptr for n == 0)
+        T* allocate(size_type n){
+            if (n == 0) return nullptr;
+            T* p = AllocTraits::allocate(alloc, n);
+            instrument::Probe<detail::DynamicArrayCounterTag>::allocated(n * sizeof(T));
+            return p;
+        }
+
+        // Returns memory obtained from allocate() to the allocator (the inline buffer is not returned)
+        void deallocate(T* p, size_type n){
+            if (p != nullptr && p != storage.data()){
+                instrument::Probe<detail::DynamicArrayCounterTag>::freed(n * sizeof(T));
+                AllocTraits::deallocate(alloc, p, n);
+            }
+        }
+
+        // Makes an empty array able to hold n elements, using the inline buffer when they fit
+        void acquire(size_type n){
+            if (n > InlineCapacity){
+                ptr = allocate(n);
+                arrCapacity = n;
+            }
+        }
+
+        // Destroys the elements in [first, last)
+        void destroy(T* first, T* last){
+            if constexpr (!std::is_trivially_destructible_v<T>){
+                for(; first != last; ++first){
+                    AllocTraits::destroy(alloc, first);
+                }
+            }
+        }
+
+        // Destroys every element and gives the memory back to the allocator
+        void release(){
+            destroy(ptr, ptr + arrSize);
+            deallocate(ptr, arrCapacity);
+            ptr = storage.data();
+            arrSize = 0;
+            arrCapacity = InlineCapacity;
+        }
+
+        // Constructs n elements at dest from the range starting at first, cleaning up if a constructor throws
+        template<typename InputIt>
+        void constructFrom(InputIt first, size_type n, T* dest){
+            using Source = std::remove_cvref_t<decltype(*first)>;
+            if constexpr (std::is_trivially_copyable_v<T> && std::is_same_v<Source, T> && std::is_pointer_v<InputIt>){
+                if (n != 0){
+                    std::memcpy(dest, first, n * sizeof(T));
+                }
+            } else {
+                size_type i = 0;
+                try {
+                    for(; i < n; ++i, ++first){
+                        AllocTraits::construct(alloc, dest + i, *first);
+                    }
+                } catch (...) {
+                    destroy(dest, dest + i);
+                    throw;
+                }
+            }
+        }
+
+        // Moves (or copies, when moving could throw) the current elements into dest
+        void relocateTo(T* dest){
+            if constexpr (!std::is_trivially_copyable_v<T>
+                          && (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>)){
+                constructFrom(std::make_move_iterator(ptr), arrSize, dest);
+            } else {
+                constructFrom(static_cast<const T*>(ptr), arrSize, dest);
+            }
+        }
+
+        // Replaces the storage with a buffer of newCapacity elements holding the current elements
+        // (the inline buffer when they fit and the elements are currently on the heap)
+        void reallocate(size_type newCapacity){
+            if (newCapacity <= InlineCapacity){
+                newCapacity = InlineCapacity;
+            }
+            T* newPtr = newCapacity == InlineCapacity ? storage.data() : allocate(newCapacity);
+            try {
+                relocateTo(newPtr);
+            } catch (...) {
+                deallocate(newPtr, newCapacity);
+                throw;
+            }
+            destroy(ptr, ptr + arrSize);
+            deallocate(ptr, arrCapacity);
+            ptr = newPtr;
+            arrCapacity = newCapacity;
+        }
+
+        // Capacity to grow to so that at least required elements fit
+        size_type growthCapacity(size_type required) const{
+            return std::max({required, arrCapacity * 2, minCapacity});
+        }
+
+        // Makes the contents equal to the n elements starting at first, reusing the buffer when it fits
+        template<typename InputIt>
+        void assignFrom(InputIt first, size_type n){
+            if (n > arrCapacity){
+                T* newPtr = allocate(n);
+                try {
+                    constructFrom(first, n, newPtr);
+                } catch (...) {
+                    deallocate(newPtr, n);
+                    throw;
+                }
+                release();
+                ptr = newPtr;
+                arrSize = n;
+                arrCapacity = n;
+                return;
+            }
+
+            size_type common = std::min(n, arrSize);
+            for(size_type i = 0; i < common; ++i, ++first){
+                ptr[i] = *first;
+            }
+            if (n > arrSize){
+                constructFrom(first, n - arrSize, ptr + arrSize);
+            } else {
+                destroy(ptr + n, ptr + arrSize);
+            }
+            arrSize = n;
+        }
+
+        // Checks whether the elements live in the inline buffer
+        bool isInline() const {
+            return InlineCapacity != 0 && arrCapacity == InlineCapacity;
+        }
+
+        // Takes over the contents of other, leaving it empty: heap buffers are stolen, inline elements are moved
+        void steal(DynamicArray& other) noexcept(std::is_nothrow_move_constructible_v<T>){
+            if (other.isInline()){
+                constructFrom(std::make_move_iterator(other.ptr), other.arrSize, ptr);
+                arrSize = other.arrSize;
+                other.clear();
+                return;
+            }
+            ptr = std::exchange(other.ptr, other.storage.data());
+            arrSize = std::exchange(other.arrSize, 0);
+            arrCapacity = std::exchange(other.arrCapacity, InlineCapacity);
+        }
 
     public:
+        /**
+         * @brief Default constructor that creates an empty array without allocating memory
+         */
+        DynamicArray() = default;
+
+        /**
+         * @brief Constructor that creates an empty array using the given allocator
+         * @param allocator Allocator used for the storage of the array
+         */
+        explicit DynamicArray(const std::type_identity_t<Alloc>& allocator) : alloc(allocator){}
+
         /**
          * @brief Constructor that takes int and initializes array with that size
          * @param size Size of the array to be initialized
+         * @param allocator Allocator used for the storage of the array
          */
         // Constructor that takes int and initializes array with that size
-        DynamicArray(int size) : arrSize(size){
-            ptr = new int[arrSize](); // allocates heap memory for an array of int filles with 0 with ()
+        DynamicArray(size_type size, const std::type_identity_t<Alloc>& allocator = Alloc()) : alloc(allocator){
+            acquire(size); // memory for size elements (inline if they fit), value-initialized below (0 for int)
+            for(; arrSize < size; ++arrSize){
+                AllocTraits::construct(alloc, ptr + arrSize);
+            }
         }
 
         /**
          * @brief Constructor that takes size and values to initialize
          * @param size Size of the array
          * @param value Value to initialize all elements in te array
+         * @param allocator Allocator used for the storage of the array
          * 
          */
         // Constructor that takes size and values to initialize
-        DynamicArray(int size, int value) : arrSize(size){
-            ptr = new int[arrSize];
-            for(int i=0; i < arrSize; i++){
-                ptr[i] = value;
+        DynamicArray(size_type size, const T& value, const std::type_identity_t<Alloc>& allocator = Alloc()) : alloc(allocator){
+            acquire(size);
+            for(; arrSize < size; ++arrSize){
+                AllocTraits::construct(alloc, ptr + arrSize, value);
+            }
+        }
+
+        /**
+         * @brief Constructor that default-initializes the elements, so ints are left uninitialized like new int[size]
+         * @param size Size of the array
+         * @param allocator Allocator used for the storage of the array
+         *
+         * Used when every element is about to be overwritten, e.g. by the element-wise operations.
+         */
+        DynamicArray(size_type size, DefaultInitTag, const std::type_identity_t<Alloc>& allocator = Alloc()) : alloc(allocator){
+            acquire(size);
+            if constexpr (std::is_trivially_default_constructible_v<T>){
+                arrSize = size;
+            } else {
+                for(; arrSize < size; ++arrSize){
+                    AllocTraits::construct(alloc, ptr + arrSize);
+                }
+            }
+        }
+
+        /**
+         * @brief Constructor that initializes the array with the elements of a list (DynamicArray a{1, 2, 3};)
+         * @param values Elements of the array
+         * @param allocator Allocator used for the storage of the array
+         */
+        DynamicArray(std::initializer_list<T> values, const std::type_identity_t<Alloc>& allocator = Alloc()) : alloc(allocator){
+            acquire(values.size());
+            constructFrom(values.begin(), values.size(), ptr);
+            arrSize = values.size();
+        }
+
+        /**
+         * @brief Constructor that copies a StaticArray (DynamicArray d = table;)
+         * @param values Array whose elements are copied
+         * @param allocator Allocator used for the storage of the array
+         *
+         * The memory is acquired once at size N (inline when N fits) and the elements are copied straight in.
+         */
+        template<std::size_t N>
+        DynamicArray(const StaticArray<T, N>& values, const std::type_identity_t<Alloc>& allocator = Alloc()) : alloc(allocator){
+            acquire(N);
+            constructFrom(values.data(), N, ptr);
+            arrSize = N;
+        }
+
+        /**
+         * @brief Constructor that materializes a concatenation (DynamicArray c = a + b + d;)
+         * @param expr Lazy concatenation returned by operator+
+         * @param allocator Allocator used for the storage of the array
+         *
+         * The memory is allocated once with the final size of the whole chain.
+         */
+        template<LazyArrayExpression E>
+            requires std::is_same_v<typename E::value_type, T>
+        DynamicArray(const E& expr, const std::type_identity_t<Alloc>& allocator = Alloc()) : alloc(allocator){
+            acquire(expr.size());
+            try {
+                expr.forEachSegment([this](const T* first, const T* last){
+                    constructFrom(first, static_cast<size_type>(last - first), ptr + arrSize);
+                    arrSize += static_cast<size_type>(last - first);
+                });
+            } catch (...) {
+                release();
+                throw;
             }
         }
 
         /**
-         * @brief Destructor to deallocate memory occupied by int array
+         * @brief Destructor to deallocate memory occupied by the array
          */
-        // Destructor to deallocate memory occupied by int array
+        // Destructor to deallocate memory occupied by the array
         ~DynamicArray(){
-            delete[] ptr;
+            release();
         }
 
         /**
@@ -143,11 +665,21 @@ namespace oop{
          * @param other Dynamic array to be copied
          */
         // Copy Constructor: makes object from copy of other object (DynamicArray obj2(obj1);)
-        DynamicArray(const DynamicArray& other) : arrSize(other.arrSize) {
-            ptr = new int[arrSize];
-            for(int i=0; i<arrSize; i++){
-                ptr[i] = other.ptr[i];
-            }
+        DynamicArray(const DynamicArray& other) : Counted(other), alloc(AllocTraits::select_on_container_copy_construction(other.alloc)) {
+            acquire(other.arrSize);
+            constructFrom(static_cast<const T*>(other.ptr), other.arrSize, ptr);
+            arrSize = other.arrSize;
+        }
+
+        /**
+         * @brief Copy constructor that uses the given allocator, e.g. when copied into a std::pmr container
+         * @param other Dynamic array to be copied
+         * @param allocator Allocator used for the storage of the copy
+         */
+        DynamicArray(const DynamicArray& other, const std::type_identity_t<Alloc>& allocator) : Counted(other), alloc(allocator) {
+            acquire(other.arrSize);
+            constructFrom(static_cast<const T*>(other.ptr), other.arrSize, ptr);
+            arrSize = other.arrSize;
         }
 
         /**
@@ -158,11 +690,14 @@ namespace oop{
         // Copy Assignment Operator: makes object from copy of other object using = (DynamicArray obj2 = obj1)
         DynamicArray& operator=(const DynamicArray& other){
             if (this != &other){
-                arrSize = other.arrSize;
-                ptr = new int[arrSize];
-                for(int i=0; i<arrSize; i++){
-                    ptr[i] = other.ptr[i];
-                }          
+                Counted::operator=(other);
+                if constexpr (AllocTraits::propagate_on_container_copy_assignment::value){
+                    if (alloc != other.alloc){
+                        release(); // memory must go back to the allocator that provided it
+                    }
+                    alloc = other.alloc;
+                }
+                assignFrom(static_cast<const T*>(other.ptr), other.arrSize);
             } 
             return *this;
         }
@@ -172,64 +707,227 @@ namespace oop{
          * @param other Dynamic array to be moved
          */
         // Move Constructor steals the data from the other object
-        DynamicArray(DynamicArray&& other) : ptr(other.ptr), arrSize(other.arrSize){
-            other.ptr = nullptr;
-            other.arrSize = 0;
+        DynamicArray(DynamicArray&& other) noexcept(InlineCapacity == 0 || std::is_nothrow_move_constructible_v<T>)
+            : Counted(std::move(other)), alloc(std::move(other.alloc)){
+            steal(other);
+        }
+
+        /**
+         * @brief Move constructor that uses the given allocator: the buffer is stolen only if both allocators are equal
+         * @param other Dynamic array to be moved
+         * @param allocator Allocator used for the storage of the new array
+         */
+        DynamicArray(DynamicArray&& other, const std::type_identity_t<Alloc>& allocator) : Counted(std::move(other)), alloc(allocator){
+            if (alloc == other.alloc){
+                steal(other);
+            } else {
+                acquire(other.arrSize);
+                constructFrom(std::make_move_iterator(other.ptr), other.arrSize, ptr);
+                arrSize = other.arrSize;
+                other.clear();
+            }
         }
+
         /**
          * @brief Move Assignment Operator
          * @param other dynamic array to be moved
          * @return reference to the modified Dynamic array
          */
         // Move Assignment Operator
-        DynamicArray& operator=(DynamicArray&& other) noexcept{
-            if (this!= &other) {
-                ptr = other.ptr;
-                arrSize = other.arrSize;
-                other.ptr = nullptr;
-                other.arrSize = 0;
+        DynamicArray& operator=(DynamicArray&& other) noexcept((AllocTraits::propagate_on_container_move_assignment::value
+                                                                || AllocTraits::is_always_equal::value)
+                                                               && (InlineCapacity == 0 || std::is_nothrow_move_constructible_v<T>)){
+            if (this != &other) {
+                Counted::operator=(std::move(other));
+                if (other.isInline()){
+                    // Inline elements cannot change owner, so they are moved into this array one by one
+                    assignFrom(std::make_move_iterator(other.ptr), other.arrSize);
+                    other.clear();
+                } else if constexpr (AllocTraits::propagate_on_container_move_assignment::value){
+                    release();
+                    alloc = std::move(other.alloc);
+                    steal(other);
+                } else {
+                    if (alloc == other.alloc){
+                        release();
+                        steal(other);
+                    } else {
+                        // Different allocators cannot share memory, so the elements are moved one by one
+                        assignFrom(std::make_move_iterator(other.ptr), other.arrSize);
+                        other.release();
+                    }
+                }
             }
             return *this;
         }
 
+        /**
+         * @brief Assignment from a concatenation (c = a + b;), which may reference this array
+         * @param expr Lazy concatenation returned by operator+
+         * @return reference to the modified array
+         */
+        template<LazyArrayExpression E>
+            requires std::is_same_v<typename E::value_type, T>
+        DynamicArray& operator=(const E& expr){
+            return *this = DynamicArray(expr, alloc);
+        }
+
         /**
          * @brief Returns the size of the dynamic array.
          * @return The size of the array.
          */
         // Method returns array size
-        int size() const {
+        size_type size() const {
             return arrSize;
         }
 
+        /**
+         * @brief Returns the number of elements the array can hold before it has to reallocate.
+         * @return The capacity of the array.
+         */
+        size_type capacity() const {
+            return arrCapacity;
+        }
+
+        /**
+         * @brief Checks whether the array has no elements.
+         * @return True if the size of the array is 0.
+         */
+        bool empty() const {
+            return arrSize == 0;
+        }
+
+        /**
+         * @brief Returns a copy of the allocator used by the array.
+         * @return The allocator of the array.
+         */
+        allocator_type get_allocator() const {
+            return alloc;
+        }
+
         /**
          * @brief Overloading [] operator to access elements at index or modify elements in the array.
          * @param index Index of the element to be accessed.
          * @return Reference to the element at the given index.
          */
         // Overloading [] operator to access elements at index
-        int& operator[](int index) {
+        T& operator[](size_type index) {
             return ptr[index]; // returns reference to the element at index
         }
 
         /**
-         * @brief Addition operator to concatenate two arrays
-         * @param other The second DynamicArray to be concatenated.
-         * @return A new DynamicArray containing elements from both arrays.
+         * @brief Overloading [] operator to read elements of a const array.
+         * @param index Index of the element to be accessed.
+         * @return Const reference to the element at the given index.
+         */
+        const T& operator[](size_type index) const {
+            return ptr[index];
+        }
+
+        /**
+         * @brief Pointer to the first element of the underlying storage.
+         * @return Pointer to the elements of the array (nullptr if nothing has been allocated).
+         */
+        T* data() { return ptr; }
+
+        /**
+         * @brief Pointer to the first element of the underlying storage.
+         * @return Const pointer to the elements of the array (nullptr if nothing has been allocated).
          */
-        // Addition operator to concatenate two arrays
-        DynamicArray operator+(const DynamicArray& other) const{
-            DynamicArray result(arrSize + other.arrSize); // creates new result array with size of the sum of both
+        const T* data() const { return ptr; }
+
+        /** @brief Iterator to the first element. */
+        iterator begin() { return ptr; }
+        /** @brief Iterator past the last element. */
+        iterator end() { return ptr + arrSize; }
+        /** @brief Const iterator to the first element. */
+        const_iterator begin() const { return ptr; }
+        /** @brief Const iterator past the last element. */
+        const_iterator end() const { return ptr + arrSize; }
 
-            // Copying elements from input arrays to result array in corresponding index
-            for(int i=0; i<arrSize; i++){
-                result.ptr[i] = ptr[i];
+        /**
+         * @brief Makes sure the array can hold at least newCapacity elements without reallocating.
+         * @param newCapacity Minimum capacity of the array.
+         */
+        void reserve(size_type newCapacity){
+            if (newCapacity > arrCapacity){
+                reallocate(newCapacity);
             }
+        }
 
-            for(int i=0; i<other.arrSize; i++){
-                result.ptr[arrSize + i] = other.ptr[i];
+        /**
+         * @brief Reduces the capacity of the array to its size, releasing the unused memory.
+         */
+        void shrink_to_fit(){
+            if (arrCapacity > arrSize && !isInline()){
+                reallocate(arrSize);
             }
+        }
 
-            return result;
+        /**
+         * @brief Constructs a new element in place at the end of the array, growing the storage if needed.
+         * @param args Arguments forwarded to the constructor of the element.
+         * @return Reference to the new element.
+         */
+        template<typename... Args>
+        T& emplace_back(Args&&... args){
+            if (arrSize < arrCapacity){
+                AllocTraits::construct(alloc, ptr + arrSize, std::forward<Args>(args)...);
+                return ptr[arrSize++];
+            }
+
+            size_type newCapacity = growthCapacity(arrSize + 1);
+            T* newPtr = allocate(newCapacity);
+            try {
+                // The new element is built first because args may refer to an element of this array
+                AllocTraits::construct(alloc, newPtr + arrSize, std::forward<Args>(args)...);
+            } catch (...) {
+                deallocate(newPtr, newCapacity);
+                throw;
+            }
+            try {
+                relocateTo(newPtr);
+            } catch (...) {
+                AllocTraits::destroy(alloc, newPtr + arrSize);
+                deallocate(newPtr, newCapacity);
+                throw;
+            }
+            destroy(ptr, ptr + arrSize);
+            deallocate(ptr, arrCapacity);
+            ptr = newPtr;
+            arrCapacity = newCapacity;
+            return ptr[arrSize++];
+        }
+
+        /**
+         * @brief Appends a copy of value to the end of the array.
+         * @param value Element to be appended.
+         */
+        void push_back(const T& value){
+            emplace_back(value);
+        }
+
+        /**
+         * @brief Appends value to the end of the array by moving it.
+         * @param value Element to be appended.
+         */
+        void push_back(T&& value){
+            emplace_back(std::move(value));
+        }
+
+        /**
+         * @brief Removes the last element of the array (the capacity is kept).
+         */
+        void pop_back(){
+            AllocTraits::destroy(alloc, ptr + --arrSize);
+        }
+
+        /**
+         * @brief Removes all the elements of the array (the capacity is kept).
+         */
+        void clear(){
+            destroy(ptr, ptr + arrSize);
+            arrSize = 0;
         }
 
         /**
@@ -241,7 +939,7 @@ namespace oop{
         // Operator overloading on ostream, implementing operator as a free function to access private variables
         friend std::ostream& operator<<(std::ostream& os, const DynamicArray& other) {
             os << "[";
-            for(int i=0; i<other.arrSize;i++){
+            for(size_type i=0; i<other.arrSize;i++){
                 os << other.ptr[i];
                 if (i!=other.arrSize - 1){
                     os << ", ";
@@ -255,4 +953,35 @@ namespace oop{
     };
 
 
+    /**
+     * @brief Deduces the element type when a concatenation is assigned to a DynamicArray (DynamicArray c = a + b;)
+     */
+    template<LazyArrayExpression E>
+    DynamicArray(const E&) -> DynamicArray<typename E::value_type>;
+
+    /**
+     * @brief Deduces the element type when a StaticArray is copied into a DynamicArray (DynamicArray d = table;)
+     */
+    template<typename T, std::size_t N>
+    DynamicArray(const StaticArray<T, N>&) -> DynamicArray<T>;
+
+    template<>
+    inline constexpr bool isConcatOperand<DynamicArrayVector> = true;
+
+    template<typename T, typename Alloc, std::size_t InlineCapacity>
+    inline constexpr bool isConcatOperand<DynamicArray<T, Alloc, InlineCapacity>> = true;
+
+    /**
+     * @namespace oop::pmr
+     * @brief Aliases of the array classes that take their memory from a std::pmr::memory_resource.
+     */
+    namespace pmr{
+
+        /**
+         * @brief DynamicArray whose heap memory comes from a memory resource (e.g. an ArenaResource).
+         */
+        template<typename T = int, std::size_t InlineCapacity = defaultInlineCapacity<T>>
+        using DynamicArray = oop::DynamicArray<T, std::pmr::polymorphic_allocator<T>, InlineCapacity>;
+    }
+
 }
\ No newline at end of file
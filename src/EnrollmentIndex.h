@@ -0,0 +1,231 @@
+/**
+ * @file EnrollmentIndex.h
+ * @brief Declaration of the EnrollmentIndex class, a two-way compressed sparse row index of enrollments.
+ */
+#pragma once
+
+#include "CourseCatalog.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace oop{
+
+    /**
+     * @class EnrollmentIndex
+     * @brief Immutable index of which students take which courses, built in bulk.
+     *
+     * Both directions are stored in compressed sparse row form: one offsets array and one flat array of IDs,
+     * sorted within each row. The courses of a student or the students of a course are a contiguous span,
+     * membership is a binary search, and co-enrollment queries are merges of two sorted rows. Courses are
+     * rows by their CourseCatalog ID; students are looked up in a sorted array of their IDs.
+     */
+    class EnrollmentIndex{
+    public:
+        using StudentId = std::uint32_t; /**< same as Student::Id. */
+        using CourseId = CourseCatalog::Id;
+
+        /**
+         * @struct Enrollment
+         * @brief One student taking one course.
+         */
+        struct Enrollment{
+            StudentId student;
+            CourseId course;
+        };
+
+    private:
+        std::vector<StudentId> studentIds;         /**< sorted IDs of the students with a course. */
+        std::vector<std::uint32_t> studentOffsets; /**< row i of the students is [offsets[i], offsets[i+1]). */
+        std::vector<CourseId> studentCourses;      /**< courses of every student, row after row. */
+        std::vector<std::uint32_t> courseOffsets;  /**< row c of the courses is [offsets[c], offsets[c+1]). */
+        std::vector<StudentId> courseStudents;     /**< students of every course, row after row. */
+
+        template<typename Id>
+        static std::span<const Id> row(const std::vector<std::uint32_t>& offsets, const std::vector<Id>& values, std::size_t r){
+            return std::span<const Id>(values.data() + offsets[r], offsets[r + 1] - offsets[r]);
+        }
+
+    public:
+        /**
+         * @brief Constructor of an empty index.
+         */
+        EnrollmentIndex() : studentOffsets(1, 0), courseOffsets(1, 0) {}
+
+        /**
+         * @brief Constructor that builds the index from a list of enrollments.
+         * @param enrollments Enrollments in any order; duplicates are kept once.
+         * @throws std::length_error if there are more than 2^32 - 1 enrollments.
+         */
+        explicit EnrollmentIndex(std::vector<Enrollment> enrollments){
+            std::sort(enrollments.begin(), enrollments.end(), [](const Enrollment& a, const Enrollment& b){
+                return a.student < b.student || (a.student == b.student && a.course < b.course);
+            });
+            enrollments.erase(std::unique(enrollments.begin(), enrollments.end(), [](const Enrollment& a, const Enrollment& b){
+                return a.student == b.student && a.course == b.course;
+            }), enrollments.end());
+            if (enrollments.size() > std::numeric_limits<std::uint32_t>::max()){
+                throw std::length_error("EnrollmentIndex: too many enrollments");
+            }
+
+            // Student rows follow the sort order directly
+            studentCourses.reserve(enrollments.size());
+            studentOffsets.push_back(0);
+            CourseId courseCount = 0;
+            for(std::size_t i = 0; i < enrollments.size(); i++){
+                if (i > 0 && enrollments[i].student != enrollments[i - 1].student){
+                    studentOffsets.push_back(static_cast<std::uint32_t>(i));
+                }
+                if (i == 0 || enrollments[i].student != enrollments[i - 1].student){
+                    studentIds.push_back(enrollments[i].student);
+                }
+                studentCourses.push_back(enrollments[i].course);
+                courseCount = std::max(courseCount, enrollments[i].course + 1);
+            }
+            if (!enrollments.empty()) studentOffsets.push_back(static_cast<std::uint32_t>(enrollments.size()));
+
+            // Course rows: count, prefix sum, then scatter; students arrive in ascending order
+            courseOffsets.assign(static_cast<std::size_t>(courseCount) + 1, 0);
+            for(const Enrollment& e : enrollments){
+                courseOffsets[e.course + 1]++;
+            }
+            for(std::size_t c = 0; c < courseCount; c++){
+                courseOffsets[c + 1] += courseOffsets[c];
+            }
+            courseStudents.resize(enrollments.size());
+            std::vector<std::uint32_t> next(courseOffsets.begin(), courseOffsets.end() - 1);
+            for(const Enrollment& e : enrollments){
+                courseStudents[next[e.course]++] = e.student;
+            }
+        }
+
+        /**
+         * @brief Builds the index from the courses the students are enrolled in.
+         * @param students Range of Student; each one is given an ID if it has none.
+         * @return The index.
+         */
+        template<typename Range>
+        static EnrollmentIndex fromStudents(const Range& students){
+            std::vector<Enrollment> enrollments;
+            for(const auto& student : students){
+                StudentId id = student.getId();
+                for(CourseId course : student.getCourseIds()){
+                    enrollments.push_back({id, course});
+                }
+            }
+            return EnrollmentIndex(std::move(enrollments));
+        }
+
+        /**
+         * @brief Returns the courses of a student.
+         * @param student ID of the student.
+         * @return Sorted course IDs, empty if the student is not in the index.
+         */
+        std::span<const CourseId> coursesOf(StudentId student) const{
+            auto found = std::lower_bound(studentIds.begin(), studentIds.end(), student);
+            if (found == studentIds.end() || *found != student) return {};
+            return row(studentOffsets, studentCourses, static_cast<std::size_t>(found - studentIds.begin()));
+        }
+
+        /**
+         * @brief Returns the students of a course.
+         * @param course ID of the course.
+         * @return Sorted student IDs, empty if nobody takes the course.
+         */
+        std::span<const StudentId> studentsIn(CourseId course) const{
+            if (course >= courseCount()) return {};
+            return row(courseOffsets, courseStudents, course);
+        }
+
+        /**
+         * @brief Returns whether a student takes a course.
+         * @param student ID of the student.
+         * @param course ID of the course.
+         * @return True if the enrollment is in the index.
+         */
+        bool isEnrolled(StudentId student, CourseId course) const{
+            std::span<const CourseId> courses = coursesOf(student);
+            return std::binary_search(courses.begin(), courses.end(), course);
+        }
+
+        /**
+         * @brief Returns the courses two students take together.
+         * @param a ID of the first student.
+         * @param b ID of the second student.
+         * @return Sorted IDs of the shared courses.
+         */
+        std::vector<CourseId> sharedCourses(StudentId a, StudentId b) const{
+            std::span<const CourseId> first = coursesOf(a), second = coursesOf(b);
+            std::vector<CourseId> result;
+            std::set_intersection(first.begin(), first.end(), second.begin(), second.end(), std::back_inserter(result));
+            return result;
+        }
+
+        /**
+         * @brief Returns how many students take both courses.
+         * @param a ID of the first course.
+         * @param b ID of the second course.
+         * @return Number of students enrolled in a and in b.
+         */
+        std::size_t countCoEnrolled(CourseId a, CourseId b) const{
+            std::span<const StudentId> first = studentsIn(a), second = studentsIn(b);
+            std::size_t count = 0;
+            auto i = first.begin();
+            auto j = second.begin();
+            while(i != first.end() && j != second.end()){
+                if (*i < *j) ++i;
+                else if (*j < *i) ++j;
+                else { count++; ++i; ++j; }
+            }
+            return count;
+        }
+
+        /**
+         * @brief Returns the students who share at least one course with a student.
+         * @param student ID of the student.
+         * @return Sorted IDs of the classmates, without the student.
+         */
+        std::vector<StudentId> classmatesOf(StudentId student) const{
+            std::vector<StudentId> result;
+            for(CourseId course : coursesOf(student)){
+                std::span<const StudentId> students = studentsIn(course);
+                result.insert(result.end(), students.begin(), students.end());
+            }
+            std::sort(result.begin(), result.end());
+            result.erase(std::unique(result.begin(), result.end()), result.end());
+            result.erase(std::remove(result.begin(), result.end(), student), result.end());
+            return result;
+        }
+
+        /**
+         * @brief Returns the number of students with at least one course.
+         * @return The number of student rows.
+         */
+        std::size_t studentCount() const{
+            return studentIds.size();
+        }
+
+        /**
+         * @brief Returns the number of course rows (the highest course ID in the index plus one).
+         * @return The number of course rows.
+         */
+        std::size_t courseCount() const{
+            return courseOffsets.size() - 1;
+        }
+
+        /**
+         * @brief Returns the number of distinct enrollments.
+         * @return The number of (student, course) pairs.
+         */
+        std::size_t size() const{
+            return studentCourses.size();
+        }
+    };
+
+}
@@ -0,0 +1,243 @@
+/**
+ * @file FlatStringList.h
+ * @brief Declaration of FlatStringList, a list of strings kept in one character buffer, and StringListView.
+ */
+#pragma once
+
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace oop{
+
+    /**
+     * @class StringListView
+     * @brief Non-owning view of consecutive strings stored back to back in a character buffer.
+     *
+     * String i spans [ends[i - 1], ends[i]) of chars, with an implicit 0 before the first one. The view
+     * is cheap to copy and is what FlatStringList and PersonBatch hand out.
+     */
+    class StringListView{
+    public:
+        using size_type = std::size_t;
+        using Offset = std::uint32_t;
+
+    private:
+        const char* chars = nullptr; /**< character buffer shared by the strings. */
+        const Offset* ends = nullptr; /**< end offset of every string in chars. */
+        Offset begin0 = 0; /**< start offset of the first string. */
+        size_type count = 0; /**< number of strings in the view. */
+
+    public:
+        class Iterator;
+
+        StringListView() = default;
+
+        /**
+         * @brief Constructor of a view of count strings.
+         * @param chars Character buffer holding the strings.
+         * @param ends End offset of each string in chars.
+         * @param begin0 Start offset of the first string.
+         * @param count Number of strings.
+         */
+        StringListView(const char* chars, const Offset* ends, Offset begin0, size_type count)
+            : chars(chars), ends(ends), begin0(begin0), count(count){}
+
+        /** @brief Number of strings. */
+        size_type size() const { return count; }
+        /** @brief True if there is no string. */
+        bool empty() const { return count == 0; }
+
+        /**
+         * @brief Returns the string at index.
+         * @param index Index of the string (not checked).
+         * @return View of the string inside the shared buffer.
+         */
+        std::string_view operator[](size_type index) const {
+            Offset first = index == 0 ? begin0 : ends[index - 1];
+            return std::string_view(chars + first, ends[index] - first);
+        }
+
+        /** @brief Iterator to the first string. */
+        Iterator begin() const;
+        /** @brief Iterator past the last string. */
+        Iterator end() const;
+
+        /**
+         * @brief Copies the strings out into separate std::string objects.
+         * @return The strings in order.
+         */
+        std::vector<std::string> toVector() const {
+            std::vector<std::string> out;
+            out.reserve(count);
+            for(size_type i = 0; i < count; i++) out.emplace_back((*this)[i]);
+            return out;
+        }
+    };
+
+    /**
+     * @class Iterator
+     * @brief Random access iterator yielding std::string_view by value.
+     */
+    class StringListView::Iterator{
+        StringListView list; // a copy, so the iterator does not depend on the view it came from
+        size_type index = 0;
+
+    public:
+        using iterator_concept = std::random_access_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::string_view;
+
+        Iterator() = default;
+        Iterator(const StringListView& list, size_type index) : list(list), index(index){}
+
+        std::string_view operator*() const { return list[index]; }
+        std::string_view operator[](difference_type n) const { return list[index + n]; }
+        Iterator& operator++(){ ++index; return *this; }
+        Iterator operator++(int){ Iterator old = *this; ++index; return old; }
+        Iterator& operator--(){ --index; return *this; }
+        Iterator operator--(int){ Iterator old = *this; --index; return old; }
+        Iterator& operator+=(difference_type n){ index += n; return *this; }
+        Iterator& operator-=(difference_type n){ index -= n; return *this; }
+        friend Iterator operator+(Iterator it, difference_type n){ return it += n; }
+        friend Iterator operator+(difference_type n, Iterator it){ return it += n; }
+        friend Iterator operator-(Iterator it, difference_type n){ return it -= n; }
+        friend difference_type operator-(const Iterator& a, const Iterator& b){
+            return static_cast<difference_type>(a.index) - static_cast<difference_type>(b.index);
+        }
+        bool operator==(const Iterator& other) const { return index == other.index; }
+        auto operator<=>(const Iterator& other) const { return index <=> other.index; }
+    };
+
+    inline StringListView::Iterator StringListView::begin() const { return Iterator(*this, 0); }
+
+    inline StringListView::Iterator StringListView::end() const { return Iterator(*this, count); }
+
+    /**
+     * @class FlatStringList
+     * @brief List of strings stored back to back in one character buffer, with an array of end offsets.
+     *
+     * A std::vector<std::string> allocates once per string that does not fit the small string buffer and
+     * copying it copies each string separately. FlatStringList always holds two buffers, so a copy costs
+     * two allocations whatever the number of strings, and reading the strings in order walks contiguous
+     * memory. Strings can only be appended; the compiler-generated copy and move operations are correct
+     * because the offsets do not point into the buffer.
+     */
+    class FlatStringList{
+    public:
+        using size_type = std::size_t;
+        using Offset = StringListView::Offset;
+
+    private:
+        std::string chars; /**< characters of every string, without separators. */
+        std::vector<Offset> ends; /**< end offset of each string in chars. */
+
+    public:
+        FlatStringList() = default;
+
+        /**
+         * @brief Constructor from a list of strings.
+         * @param values Strings of the list, in order.
+         */
+        FlatStringList(std::initializer_list<std::string_view> values){
+            size_type total = 0;
+            for(std::string_view value : values) total += value.size();
+            reserve(values.size(), total);
+            for(std::string_view value : values) push_back(value);
+        }
+
+        /**
+         * @brief Constructor from any range of strings, such as the hobbies of a Person.
+         * @param values Range whose elements convert to std::string_view.
+         */
+        template<typename Range>
+            requires std::convertible_to<std::ranges::range_reference_t<const Range&>, std::string_view>
+        explicit FlatStringList(const Range& values){
+            size_type total = 0, n = 0;
+            for(std::string_view value : values){ total += value.size(); n++; }
+            reserve(n, total);
+            for(std::string_view value : values) push_back(value);
+        }
+
+        /**
+         * @brief Reserves room for more strings and characters.
+         * @param strings Total number of strings the list will hold.
+         * @param characters Total number of characters of those strings.
+         */
+        void reserve(size_type strings, size_type characters){
+            ends.reserve(strings);
+            chars.reserve(characters);
+        }
+
+        /**
+         * @brief Appends a copy of value.
+         * @param value String to be appended.
+         * @throws std::length_error if the characters would no longer fit 32-bit offsets.
+         */
+        void push_back(std::string_view value){
+            if (value.size() > std::numeric_limits<Offset>::max() - chars.size()){
+                throw std::length_error("FlatStringList: more than 4 GiB of characters");
+            }
+            ends.push_back(static_cast<Offset>(chars.size() + value.size()));
+            try{
+                chars.append(value);
+            } catch(...){
+                ends.pop_back(); // so that a failure leaves chars and ends consistent
+                throw;
+            }
+        }
+
+        /** @brief Number of strings. */
+        size_type size() const { return ends.size(); }
+        /** @brief True if there is no string. */
+        bool empty() const { return ends.empty(); }
+        /** @brief Number of strings the list holds before its offsets are reallocated. */
+        size_type capacity() const { return ends.capacity(); }
+        /** @brief Total number of characters of the strings. */
+        size_type characters() const { return chars.size(); }
+
+        /**
+         * @brief Returns the string at index.
+         * @param index Index of the string (not checked).
+         * @return View of the string, valid until the next push_back().
+         */
+        std::string_view operator[](size_type index) const { return view()[index]; }
+
+        /**
+         * @brief Returns a view of all the strings.
+         * @return View valid until the next push_back().
+         */
+        StringListView view() const { return StringListView(chars.data(), ends.data(), 0, ends.size()); }
+
+        /** @brief Iterator to the first string. */
+        StringListView::Iterator begin() const { return view().begin(); }
+        /** @brief Iterator past the last string. */
+        StringListView::Iterator end() const { return view().end(); }
+
+        /**
+         * @brief Copies the strings out into separate std::string objects.
+         * @return The strings in order.
+         */
+        std::vector<std::string> toVector() const { return view().toVector(); }
+
+        /**
+         * @brief Compares the strings of two lists.
+         * @return True if both lists hold the same strings in the same order.
+         */
+        friend bool operator==(const FlatStringList& a, const FlatStringList& b){
+            return a.ends == b.ends && a.chars == b.chars;
+        }
+    };
+
+}
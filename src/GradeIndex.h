@@ -0,0 +1,285 @@
+/**
+ * @file GradeIndex.h
+ * @brief Declaration of the GradeIndex class, a ranking of students by grade kept up to date as grades change.
+ */
+#pragma once
+
+#include "GradeObserver.h"
+#include "Student.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace oop{
+
+    /**
+     * @class GradeIndex
+     * @brief Order-statistics index over the grades of a cohort of students.
+     *
+     * Grades in [0, 10] are split in buckets of 0.01, each holding its students sorted by grade, and a Fenwick
+     * tree counts the students per bucket. Rank, percentile and k-th grade queries cost O(log buckets) plus a
+     * binary search in one bucket, and top-K walks the buckets from the highest grade. The index registers
+     * itself as a GradeObserver, so Student::setGrade() and the destruction of a tracked student update it.
+     * All the members are thread-safe.
+     */
+    class GradeIndex final : public GradeObserver{
+    public:
+        /**
+         * @struct Entry
+         * @brief A tracked student and its grade.
+         */
+        struct Entry{
+            double grade;
+            Student::Id id;
+        };
+
+        /** @brief Number of buckets: grades 0.00 to 10.00 in steps of 0.01. */
+        static constexpr std::size_t bucketCount = 1001;
+
+    private:
+        static constexpr std::size_t treeSize = 1024; /**< bucketCount rounded up to a power of two. */
+
+        std::vector<std::vector<Entry>> buckets = std::vector<std::vector<Entry>>(bucketCount); /**< sorted by grade, highest first. */
+        std::vector<std::int64_t> tree = std::vector<std::int64_t>(treeSize + 1); /**< Fenwick tree of bucket sizes. */
+        std::unordered_map<Student::Id, double> grades; /**< grade of every tracked student. */
+        mutable std::mutex mutex; /**< guards everything above. */
+
+        static std::size_t bucketOf(double grade){
+            if (!(grade > 0.0)) return 0; // also catches NaN
+            return std::min(bucketCount - 1, static_cast<std::size_t>(grade * 100.0));
+        }
+
+        // Highest grade first, and the lowest ID first among equal grades
+        static bool before(const Entry& a, const Entry& b){
+            return a.grade > b.grade || (a.grade == b.grade && a.id < b.id);
+        }
+
+        void addToTree(std::size_t bucket, std::int64_t delta){
+            for(std::size_t i = bucket + 1; i <= treeSize; i += i & (~i + 1)){
+                tree[i] += delta;
+            }
+        }
+
+        // Number of students in buckets [0, bucket)
+        std::int64_t countBelowBucket(std::size_t bucket) const{
+            std::int64_t total = 0;
+            for(std::size_t i = bucket; i > 0; i -= i & (~i + 1)){
+                total += tree[i];
+            }
+            return total;
+        }
+
+        void insertEntry(Entry entry){
+            std::vector<Entry>& bucket = buckets[bucketOf(entry.grade)];
+            bucket.insert(std::upper_bound(bucket.begin(), bucket.end(), entry, before), entry);
+            addToTree(bucketOf(entry.grade), 1);
+        }
+
+        void eraseEntry(Entry entry){
+            std::vector<Entry>& bucket = buckets[bucketOf(entry.grade)];
+            auto found = std::lower_bound(bucket.begin(), bucket.end(), entry, before);
+            bucket.erase(found);
+            addToTree(bucketOf(entry.grade), -1);
+        }
+
+        // Number of tracked students with a grade strictly above grade
+        std::size_t countAboveLocked(double grade) const{
+            std::size_t bucket = bucketOf(grade);
+            std::int64_t above = static_cast<std::int64_t>(grades.size()) - countBelowBucket(bucket + 1);
+            const std::vector<Entry>& entries = buckets[bucket];
+            auto end = std::partition_point(entries.begin(), entries.end(), [&](const Entry& e){ return e.grade > grade; });
+            return static_cast<std::size_t>(above) + static_cast<std::size_t>(end - entries.begin());
+        }
+
+        // Entry with the given 0-based position counting from the lowest grade
+        const Entry& entryFromBottom(std::size_t position) const{
+            // Fenwick descent: the last bucket whose preceding buckets hold at most position students
+            std::size_t bucket = 0;
+            std::int64_t remaining = static_cast<std::int64_t>(position);
+            for(std::size_t step = treeSize; step > 0; step /= 2){
+                if (bucket + step <= treeSize && tree[bucket + step] <= remaining){
+                    bucket += step;
+                    remaining -= tree[bucket];
+                }
+            }
+            const std::vector<Entry>& entries = buckets[bucket];
+            return entries[entries.size() - 1 - static_cast<std::size_t>(remaining)];
+        }
+
+    public:
+        /**
+         * @brief Constructor that registers the index with GradeObserverRegistry.
+         */
+        GradeIndex(){
+            GradeObserverRegistry::add(this);
+        }
+
+        /**
+         * @brief Destructor that unregisters the index.
+         */
+        ~GradeIndex() override {
+            GradeObserverRegistry::remove(this);
+        }
+
+        GradeIndex(const GradeIndex&) = delete;
+        GradeIndex& operator=(const GradeIndex&) = delete;
+
+        /**
+         * @brief Starts tracking a student (or updates its grade if it is already tracked).
+         * @param student Student to be ranked; it is given an ID if it has none.
+         */
+        void insert(const Student& student){
+            Student::Id id = student.getId();
+            double grade = student.getGrade();
+            std::lock_guard<std::mutex> lock(mutex);
+            auto [found, inserted] = grades.try_emplace(id, grade);
+            if (!inserted){
+                eraseEntry({found->second, id});
+                found->second = grade;
+            }
+            insertEntry({grade, id});
+        }
+
+        /**
+         * @brief Stops tracking a student.
+         * @param student Student to be removed.
+         * @return True if the student was tracked.
+         */
+        bool erase(const Student& student){
+            if (!student.hasId()) return false;
+            std::lock_guard<std::mutex> lock(mutex);
+            auto found = grades.find(student.getId());
+            if (found == grades.end()) return false;
+            eraseEntry({found->second, found->first});
+            grades.erase(found);
+            return true;
+        }
+
+        /**
+         * @brief Returns whether a student is tracked.
+         * @param student Student to be looked up.
+         * @return True if the student is in the index.
+         */
+        bool contains(const Student& student) const{
+            if (!student.hasId()) return false;
+            std::lock_guard<std::mutex> lock(mutex);
+            return grades.count(student.getId()) != 0;
+        }
+
+        /**
+         * @brief Returns the number of tracked students.
+         * @return The size of the cohort.
+         */
+        std::size_t size() const{
+            std::lock_guard<std::mutex> lock(mutex);
+            return grades.size();
+        }
+
+        /**
+         * @brief Rank of a student: 1 plus the number of students with a higher grade (equal grades share a rank).
+         * @param student Tracked student.
+         * @return The rank, 1 for the best grade.
+         * @throws std::out_of_range if the student is not tracked.
+         */
+        std::size_t rankOf(const Student& student) const{
+            std::lock_guard<std::mutex> lock(mutex);
+            auto found = student.hasId() ? grades.find(student.getId()) : grades.end();
+            if (found == grades.end()) throw std::out_of_range("GradeIndex::rankOf: student not in the index");
+            return countAboveLocked(found->second) + 1;
+        }
+
+        /**
+         * @brief Percentile of a student: percentage of the cohort with a lower grade.
+         * @param student Tracked student.
+         * @return A value in [0, 100).
+         * @throws std::out_of_range if the student is not tracked.
+         */
+        double percentileOf(const Student& student) const{
+            std::lock_guard<std::mutex> lock(mutex);
+            auto found = student.hasId() ? grades.find(student.getId()) : grades.end();
+            if (found == grades.end()) throw std::out_of_range("GradeIndex::percentileOf: student not in the index");
+            double grade = found->second;
+            std::size_t bucket = bucketOf(grade);
+            const std::vector<Entry>& entries = buckets[bucket];
+            auto firstBelow = std::partition_point(entries.begin(), entries.end(), [&](const Entry& e){ return e.grade >= grade; });
+            std::size_t below = static_cast<std::size_t>(countBelowBucket(bucket)) + static_cast<std::size_t>(entries.end() - firstBelow);
+            return 100.0 * static_cast<double>(below) / static_cast<double>(grades.size());
+        }
+
+        /**
+         * @brief Number of tracked students with a grade strictly above grade.
+         * @param grade Threshold.
+         * @return Number of students.
+         */
+        std::size_t countAbove(double grade) const{
+            std::lock_guard<std::mutex> lock(mutex);
+            return countAboveLocked(grade);
+        }
+
+        /**
+         * @brief Grade of the student at the given rank when ties are ordered by ID.
+         * @param rank Position from the top, starting at 1.
+         * @return The grade at that position.
+         * @throws std::out_of_range if rank is 0 or larger than the cohort.
+         */
+        double gradeAtRank(std::size_t rank) const{
+            std::lock_guard<std::mutex> lock(mutex);
+            if (rank == 0 || rank > grades.size()) throw std::out_of_range("GradeIndex::gradeAtRank: no such rank");
+            return entryFromBottom(grades.size() - rank).grade;
+        }
+
+        /**
+         * @brief Smallest grade such that at least p percent of the cohort is at or below it (nearest rank).
+         * @param p Percentile in [0, 100].
+         * @return The grade.
+         * @throws std::out_of_range if the index is empty.
+         */
+        double gradeAtPercentile(double p) const{
+            std::lock_guard<std::mutex> lock(mutex);
+            if (grades.empty()) throw std::out_of_range("GradeIndex::gradeAtPercentile: empty index");
+            double clamped = std::clamp(p, 0.0, 100.0);
+            std::size_t position = static_cast<std::size_t>(std::ceil(clamped / 100.0 * static_cast<double>(grades.size())));
+            return entryFromBottom(position == 0 ? 0 : position - 1).grade;
+        }
+
+        /**
+         * @brief The k students with the highest grades, best first (ties ordered by ID).
+         * @param k Number of students requested.
+         * @return Up to k entries.
+         */
+        std::vector<Entry> topK(std::size_t k) const{
+            std::lock_guard<std::mutex> lock(mutex);
+            std::vector<Entry> result;
+            result.reserve(std::min(k, grades.size()));
+            for(std::size_t bucket = bucketCount; bucket-- > 0 && result.size() < k;){
+                for(const Entry& entry : buckets[bucket]){
+                    if (result.size() == k) break;
+                    result.push_back(entry);
+                }
+            }
+            return result;
+        }
+
+        void onGradeChanged(const Student& student, double oldGrade, double newGrade) override {
+            (void)oldGrade;
+            if (!student.hasId()) return;
+            std::lock_guard<std::mutex> lock(mutex);
+            auto found = grades.find(student.getId());
+            if (found == grades.end() || found->second == newGrade) return;
+            eraseEntry({found->second, found->first});
+            found->second = newGrade;
+            insertEntry({newGrade, found->first});
+        }
+
+        void onStudentRemoved(const Student& student) override {
+            erase(student);
+        }
+    };
+
+}
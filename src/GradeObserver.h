@@ -0,0 +1,117 @@
+/**
+ * @file GradeObserver.h
+ * @brief Declaration of the GradeObserver interface and of the registry that forwards Student lifecycle events to it.
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+namespace oop{
+
+    class Student;
+
+    /**
+     * @class GradeObserver
+     * @brief Interface of the objects notified when students are created, change grade or are destroyed.
+     *
+     * Observers are registered with GradeObserverRegistry and called on the thread that changed the student,
+     * so an observer used by several threads must synchronize itself. The callbacks must not throw.
+     */
+    class GradeObserver{
+    public:
+        virtual ~GradeObserver() = default;
+
+        /**
+         * @brief Called when a student is constructed or copied.
+         * @param student The new student.
+         */
+        virtual void onStudentAdded(const Student& student) { (void)student; }
+
+        /**
+         * @brief Called after the grade of a student changed.
+         * @param student The student, already holding newGrade.
+         * @param oldGrade Grade before the change.
+         * @param newGrade Grade after the change.
+         */
+        virtual void onGradeChanged(const Student& student, double oldGrade, double newGrade) {
+            (void)student; (void)oldGrade; (void)newGrade;
+        }
+
+        /**
+         * @brief Called when a student is destroyed or replaced by move assignment.
+         * @param student The student, still holding its last grade.
+         */
+        virtual void onStudentRemoved(const Student& student) { (void)student; }
+    };
+
+    /**
+     * @class GradeObserverRegistry
+     * @brief Process-wide list of GradeObserver objects that Student notifies.
+     *
+     * While no observer is registered each notification costs a single relaxed atomic load.
+     */
+    class GradeObserverRegistry{
+    private:
+        struct State{
+            std::shared_mutex mutex;
+            std::vector<GradeObserver*> observers;
+            std::atomic<std::size_t> count{0};
+        };
+
+        static State& state(){
+            static State instance;
+            return instance;
+        }
+
+        template<typename F>
+        static void notify(F&& f){
+            State& s = state();
+            if (s.count.load(std::memory_order_relaxed) == 0) return;
+            std::shared_lock<std::shared_mutex> lock(s.mutex);
+            for(GradeObserver* observer : s.observers){
+                f(*observer);
+            }
+        }
+
+    public:
+        /**
+         * @brief Starts notifying observer; it must be removed before it is destroyed.
+         * @param observer Observer to be added.
+         */
+        static void add(GradeObserver* observer){
+            State& s = state();
+            std::unique_lock<std::shared_mutex> lock(s.mutex);
+            s.observers.push_back(observer);
+            s.count.store(s.observers.size(), std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Stops notifying observer.
+         * @param observer Observer to be removed.
+         */
+        static void remove(GradeObserver* observer){
+            State& s = state();
+            std::unique_lock<std::shared_mutex> lock(s.mutex);
+            s.observers.erase(std::remove(s.observers.begin(), s.observers.end(), observer), s.observers.end());
+            s.count.store(s.observers.size(), std::memory_order_relaxed);
+        }
+
+        static void studentAdded(const Student& student){
+            notify([&](GradeObserver& observer){ observer.onStudentAdded(student); });
+        }
+
+        static void gradeChanged(const Student& student, double oldGrade, double newGrade){
+            notify([&](GradeObserver& observer){ observer.onGradeChanged(student, oldGrade, newGrade); });
+        }
+
+        static void studentRemoved(const Student& student){
+            notify([&](GradeObserver& observer){ observer.onStudentRemoved(student); });
+        }
+    };
+
+}
@@ -0,0 +1,245 @@
+/**
+ * @file GradeStats.h
+ * @brief Declaration of the GradeStats class, grade statistics of the live students kept up to date in O(1) per change.
+ */
+#pragma once
+
+#include "GradeObserver.h"
+#include "InstanceCounter.h"
+#include "Student.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <span>
+
+namespace oop{
+
+    /**
+     * @struct GradeMoments
+     * @brief Count, mean and sum of squared deviations of a set of grades, updated with Welford's algorithm.
+     */
+    struct GradeMoments{
+        std::int64_t count = 0;
+        double mean = 0;
+        double m2 = 0; /**< sum of the squared deviations from the mean. */
+
+        /** @brief Adds one grade. */
+        void add(double grade){
+            count++;
+            double delta = grade - mean;
+            mean += delta / static_cast<double>(count);
+            m2 += delta * (grade - mean);
+        }
+
+        /**
+         * @brief Adds the grades of other (the parallel form of Welford's algorithm).
+         * @param other Moments of another set of grades.
+         */
+        void merge(const GradeMoments& other){
+            if (other.count == 0) return;
+            if (count == 0){
+                *this = other;
+                return;
+            }
+            double n = static_cast<double>(count + other.count);
+            double delta = other.mean - mean;
+            mean += delta * static_cast<double>(other.count) / n;
+            m2 += other.m2 + delta * delta * static_cast<double>(count) * static_cast<double>(other.count) / n;
+            count += other.count;
+        }
+
+        /**
+         * @brief Removes the grades of other, which must all have been added to this set: the inverse of merge().
+         * @param other Moments of the grades to remove.
+         */
+        void subtract(const GradeMoments& other){
+            if (other.count == 0) return;
+            std::int64_t left = count - other.count;
+            if (left <= 0){
+                *this = GradeMoments{};
+                return;
+            }
+            double all = static_cast<double>(count), removed = static_cast<double>(other.count), kept = static_cast<double>(left);
+            double keptMean = (all * mean - removed * other.mean) / kept;
+            double delta = other.mean - keptMean;
+            m2 = std::max(0.0, m2 - other.m2 - delta * delta * kept * removed / all);
+            mean = keptMean;
+            count = left;
+        }
+
+        /** @brief Population variance, 0 if there is no grade. */
+        double variance() const { return count > 0 ? m2 / static_cast<double>(count) : 0.0; }
+    };
+
+    /**
+     * @class GradeStats
+     * @brief Count, sum, mean, variance and histogram of the grades of the live students, read without a scan.
+     *
+     * The statistics register themselves as a GradeObserver: constructing or copying a student adds its grade,
+     * Student::setGrade() replaces it and destroying the student removes it, each in O(1). Students that already
+     * existed when the statistics were created must be passed to track(), otherwise their later changes and
+     * destruction would be subtracted from grades that were never added.
+     *
+     * Each thread updates the partial aggregates of its own shard (the shard of its InstanceCounted counters),
+     * so concurrent producers do not contend on one lock; reads merge the shards. A student added on one thread
+     * and removed on another leaves an addition in one shard and a removal in the other, so every shard keeps
+     * the Welford moments of its additions and of its removals apart, and the merge subtracts the second from
+     * the first. A read taken while other threads change grades sees each shard at some point of its history.
+     */
+    class GradeStats final : public GradeObserver{
+    public:
+        /** @brief Number of histogram bins over [0, 10]. */
+        static constexpr std::size_t binCount = 20;
+        /** @brief Width of a histogram bin. */
+        static constexpr double binWidth = 10.0 / binCount;
+
+        /**
+         * @struct Snapshot
+         * @brief Statistics merged from every shard.
+         */
+        struct Snapshot{
+            std::int64_t count = 0;
+            double sum = 0;
+            GradeMoments moments;
+            std::array<std::int64_t, binCount> histogram{}; /**< bin b counts the grades in [b, b + 1) * binWidth; 10 is in the last one. */
+
+            /** @brief Mean grade, 0 if there is no student. */
+            double mean() const { return moments.mean; }
+            /** @brief Population variance of the grades. */
+            double variance() const { return moments.variance(); }
+            /** @brief Population standard deviation of the grades. */
+            double stddev() const { return std::sqrt(variance()); }
+
+            /**
+             * @brief Estimates a percentile from the histogram, interpolating linearly inside the bin.
+             * @param percent Percentile in [0, 100].
+             * @return Grade below which percent of the grades fall, 0 if there is no student.
+             */
+            double percentile(double percent) const {
+                if (count <= 0) return 0.0;
+                double rank = std::clamp(percent, 0.0, 100.0) / 100.0 * static_cast<double>(count);
+                double below = 0;
+                for(std::size_t b = 0; b < binCount; b++){
+                    double inBin = static_cast<double>(histogram[b]);
+                    if (inBin > 0 && below + inBin >= rank){
+                        return (static_cast<double>(b) + (rank - below) / inBin) * binWidth;
+                    }
+                    below += inBin;
+                }
+                return 10.0;
+            }
+        };
+
+    private:
+        struct alignas(64) Shard{
+            mutable std::mutex mutex;
+            GradeMoments added;
+            GradeMoments removed;
+            double sum = 0;
+            std::array<std::int64_t, binCount> histogram{};
+        };
+
+        std::array<Shard, counterShards> shards{};
+
+        static std::size_t binOf(double grade){
+            if (!(grade > 0.0)) return 0; // also catches NaN
+            return std::min(binCount - 1, static_cast<std::size_t>(grade / binWidth));
+        }
+
+        static void add(Shard& shard, double grade){
+            shard.added.add(grade);
+            shard.sum += grade;
+            shard.histogram[binOf(grade)]++;
+        }
+
+        static void remove(Shard& shard, double grade){
+            shard.removed.add(grade);
+            shard.sum -= grade;
+            shard.histogram[binOf(grade)]--;
+        }
+
+        Shard& local(){
+            return shards[detail::counterShardIndex()];
+        }
+
+    public:
+        /**
+         * @brief Constructor that registers the statistics with GradeObserverRegistry.
+         */
+        GradeStats(){
+            GradeObserverRegistry::add(this);
+        }
+
+        /**
+         * @brief Destructor that unregisters the statistics.
+         */
+        ~GradeStats() override {
+            GradeObserverRegistry::remove(this);
+        }
+
+        GradeStats(const GradeStats&) = delete;
+        GradeStats& operator=(const GradeStats&) = delete;
+
+        /**
+         * @brief Counts students that existed before the statistics were created.
+         * @param students Students to count; their later changes and destruction are then followed.
+         */
+        void track(std::span<const Student> students){
+            Shard& shard = local();
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            for(const Student& student : students) add(shard, student.getGrade());
+        }
+
+        void onStudentAdded(const Student& student) override {
+            Shard& shard = local();
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            add(shard, student.getGrade());
+        }
+
+        void onGradeChanged(const Student& student, double oldGrade, double newGrade) override {
+            (void)student;
+            Shard& shard = local();
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            remove(shard, oldGrade);
+            add(shard, newGrade);
+        }
+
+        void onStudentRemoved(const Student& student) override {
+            Shard& shard = local();
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            remove(shard, student.getGrade());
+        }
+
+        /**
+         * @brief Merges the partial aggregates of every shard.
+         * @return The statistics of the live students.
+         */
+        Snapshot snapshot() const {
+            GradeMoments added, removed;
+            Snapshot result;
+            for(const Shard& shard : shards){
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                added.merge(shard.added);
+                removed.merge(shard.removed);
+                result.sum += shard.sum;
+                for(std::size_t b = 0; b < binCount; b++) result.histogram[b] += shard.histogram[b];
+            }
+            added.subtract(removed);
+            result.moments = added;
+            result.count = added.count;
+            return result;
+        }
+
+        /** @brief Number of live students counted. */
+        std::int64_t count() const { return snapshot().count; }
+        /** @brief Mean grade of the live students. */
+        double mean() const { return snapshot().mean(); }
+        /** @brief Population variance of the grades of the live students. */
+        double variance() const { return snapshot().variance(); }
+    };
+
+}
@@ -0,0 +1,175 @@
+/**
+ * @file InstanceCounter.h
+ * @brief Sharded counters and the InstanceCounted base class that tracks how many objects of a class exist.
+ */
+#pragma once
+
+#include "Instrumentation.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace oop{
+
+    /**
+     * @brief Number of shards of every counter; threads are spread over them round-robin.
+     */
+    inline constexpr std::size_t counterShards = 64;
+
+    namespace detail{
+
+        // Shard of the calling thread, fixed the first time the thread touches a counter
+        inline std::size_t counterShardIndex(){
+            static std::atomic<std::size_t> nextShard{0};
+            thread_local std::size_t index = nextShard.fetch_add(1, std::memory_order_relaxed) % counterShards;
+            return index;
+        }
+    }
+
+    /**
+     * @class ShardedCounter
+     * @brief Counter whose increments go to a cache line of the calling thread and are added up on read.
+     *
+     * Each thread increments its own shard, so threads creating objects concurrently never write the same
+     * cache line and the increment stays an uncontended relaxed atomic. Reads add up every shard and are
+     * meant for metrics, not for synchronization.
+     */
+    class ShardedCounter{
+    private:
+        struct alignas(64) Shard{
+            std::atomic<std::int64_t> value{0};
+        };
+
+        std::array<Shard, counterShards> shards{};
+
+    public:
+        /**
+         * @brief Adds delta to the shard of the calling thread.
+         * @param delta Amount added (may be negative).
+         */
+        void add(std::int64_t delta = 1){
+            shards[detail::counterShardIndex()].value.fetch_add(delta, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Returns the sum of all the shards.
+         * @return The value of the counter.
+         */
+        std::int64_t read() const{
+            std::int64_t total = 0;
+            for(const Shard& shard : shards){
+                total += shard.value.load(std::memory_order_relaxed);
+            }
+            return total;
+        }
+    };
+
+    /**
+     * @struct InstanceStats
+     * @brief Lifecycle counts of the objects of one class.
+     */
+    struct InstanceStats{
+        std::int64_t live = 0;      /**< objects currently alive. */
+        std::int64_t created = 0;   /**< objects constructed, including copies and moves. */
+        std::int64_t copied = 0;    /**< copy constructions and copy assignments. */
+        std::int64_t moved = 0;     /**< move constructions and move assignments. */
+        std::int64_t destroyed = 0; /**< objects destroyed. */
+    };
+
+    /**
+     * @class InstanceCounters
+     * @brief The lifecycle counters of one class, with the four counts of a thread on one cache line.
+     */
+    class InstanceCounters{
+    private:
+        struct alignas(64) Shard{
+            std::atomic<std::int64_t> created{0};
+            std::atomic<std::int64_t> copied{0};
+            std::atomic<std::int64_t> moved{0};
+            std::atomic<std::int64_t> destroyed{0};
+        };
+
+        std::array<Shard, counterShards> shards{};
+
+        static void increment(std::atomic<std::int64_t>& counter){
+            counter.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        Shard& local(){
+            return shards[detail::counterShardIndex()];
+        }
+
+    public:
+        void onCreate(){ increment(local().created); }
+        void onCopyCreate(){ Shard& s = local(); increment(s.created); increment(s.copied); }
+        void onMoveCreate(){ Shard& s = local(); increment(s.created); increment(s.moved); }
+        void onCopyAssign(){ increment(local().copied); }
+        void onMoveAssign(){ increment(local().moved); }
+        void onDestroy(){ increment(local().destroyed); }
+
+        /**
+         * @brief Adds up the shards.
+         * @return The current counts.
+         */
+        InstanceStats read() const{
+            InstanceStats stats;
+            for(const Shard& shard : shards){
+                stats.created += shard.created.load(std::memory_order_relaxed);
+                stats.copied += shard.copied.load(std::memory_order_relaxed);
+                stats.moved += shard.moved.load(std::memory_order_relaxed);
+                stats.destroyed += shard.destroyed.load(std::memory_order_relaxed);
+            }
+            stats.live = stats.created - stats.destroyed;
+            return stats;
+        }
+    };
+
+    /**
+     * @class InstanceCounted
+     * @brief Empty base class that counts the constructions, copies, moves and destructions of a class.
+     * @tparam Tag Type whose objects are counted (usually the derived class itself).
+     *
+     * Classes that only use the implicit copy and move operations are counted without any code. Classes with
+     * their own copy or move constructors must pass the other object to this base, and their assignment
+     * operators must call the base assignment, for copies and moves to be told apart. Copies and moves are
+     * also reported to instrument::Probe<Tag>, which records them (with their call-site tag) in instrumented builds.
+     */
+    template<typename Tag>
+    class InstanceCounted{
+    private:
+        static InstanceCounters& counters(){
+            static InstanceCounters instance;
+            return instance;
+        }
+
+    public:
+        /**
+         * @brief Returns the lifecycle counts of the objects of Tag.
+         * @return Live, created, copied, moved and destroyed counts.
+         */
+        static InstanceStats instanceStats(){
+            return counters().read();
+        }
+
+    protected:
+        InstanceCounted() noexcept { counters().onCreate(); }
+        InstanceCounted(const InstanceCounted&) noexcept { counters().onCopyCreate(); instrument::Probe<Tag>::copied(); }
+        InstanceCounted(InstanceCounted&&) noexcept { counters().onMoveCreate(); instrument::Probe<Tag>::moved(); }
+        ~InstanceCounted(){ counters().onDestroy(); }
+
+        InstanceCounted& operator=(const InstanceCounted&) noexcept {
+            counters().onCopyAssign();
+            instrument::Probe<Tag>::copied();
+            return *this;
+        }
+
+        InstanceCounted& operator=(InstanceCounted&&) noexcept {
+            counters().onMoveAssign();
+            instrument::Probe<Tag>::moved();
+            return *this;
+        }
+    };
+
+}
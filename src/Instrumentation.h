@@ -0,0 +1,497 @@
+/**
+ * @file Instrumentation.h
+ * @brief Opt-in tracing of the allocations, copies and moves of the value types, with call-site tags.
+ *
+ * Build with OOP_INSTRUMENTATION=1 (the CMake option of the same name) to turn it on. When it is off the
+ * probes are empty inline functions, ScopedTag is an empty object, TrackedAllocator is std::allocator and
+ * trackedResource() returns the resource it is given, so nothing is left in the generated code.
+ */
+#pragma once
+
+#ifndef OOP_INSTRUMENTATION
+#define OOP_INSTRUMENTATION 0
+#endif
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace oop{
+
+    /**
+     * @namespace oop::instrument
+     * @brief Allocation and copy/move tracing of DynamicArray, DynamicArrayVector, Student and Person.
+     *
+     * DynamicArray, DynamicArrayVector and Student report their allocations and bytes (for Student, those of
+     * its courses). Person reports only its copies and moves: the memory of its std::string and std::vector
+     * members is not counted.
+     */
+    namespace instrument{
+
+        /** @brief True when the library is built with OOP_INSTRUMENTATION=1. */
+        inline constexpr bool enabled = OOP_INSTRUMENTATION != 0;
+
+        /**
+         * @brief Name of a traced type in queries and reports; traced classes specialize it before their definition.
+         */
+        template<typename Tag>
+        inline constexpr std::string_view probeName = "unnamed";
+
+        /**
+         * @struct ProbeStats
+         * @brief What a type (or a tag) did: allocations, bytes and copies and moves, assignments included.
+         */
+        struct ProbeStats{
+            std::int64_t allocations = 0;
+            std::int64_t bytesAllocated = 0;
+            std::int64_t deallocations = 0;
+            std::int64_t bytesFreed = 0;
+            std::int64_t copies = 0;
+            std::int64_t moves = 0;
+
+            ProbeStats& operator+=(const ProbeStats& other){
+                allocations += other.allocations;
+                bytesAllocated += other.bytesAllocated;
+                deallocations += other.deallocations;
+                bytesFreed += other.bytesFreed;
+                copies += other.copies;
+                moves += other.moves;
+                return *this;
+            }
+
+            /**
+             * @brief Difference between two snapshots, to check the budget of a piece of code.
+             */
+            friend ProbeStats operator-(ProbeStats a, const ProbeStats& b){
+                a.allocations -= b.allocations;
+                a.bytesAllocated -= b.bytesAllocated;
+                a.deallocations -= b.deallocations;
+                a.bytesFreed -= b.bytesFreed;
+                a.copies -= b.copies;
+                a.moves -= b.moves;
+                return a;
+            }
+        };
+
+        namespace detail{
+
+            enum class Event{ Allocate, Deallocate, Copy, Move };
+
+            inline void apply(ProbeStats& stats, Event event, std::int64_t bytes){
+                switch(event){
+                    case Event::Allocate: stats.allocations++; stats.bytesAllocated += bytes; break;
+                    case Event::Deallocate: stats.deallocations++; stats.bytesFreed += bytes; break;
+                    case Event::Copy: stats.copies++; break;
+                    case Event::Move: stats.moves++; break;
+                }
+            }
+
+            // Counters of one traced type
+            struct TypeCounters{
+                std::string_view name;
+                std::atomic<std::int64_t> allocations{0};
+                std::atomic<std::int64_t> bytesAllocated{0};
+                std::atomic<std::int64_t> deallocations{0};
+                std::atomic<std::int64_t> bytesFreed{0};
+                std::atomic<std::int64_t> copies{0};
+                std::atomic<std::int64_t> moves{0};
+
+                void record(Event event, std::int64_t bytes){
+                    switch(event){
+                        case Event::Allocate:
+                            allocations.fetch_add(1, std::memory_order_relaxed);
+                            bytesAllocated.fetch_add(bytes, std::memory_order_relaxed);
+                            break;
+                        case Event::Deallocate:
+                            deallocations.fetch_add(1, std::memory_order_relaxed);
+                            bytesFreed.fetch_add(bytes, std::memory_order_relaxed);
+                            break;
+                        case Event::Copy: copies.fetch_add(1, std::memory_order_relaxed); break;
+                        case Event::Move: moves.fetch_add(1, std::memory_order_relaxed); break;
+                    }
+                }
+
+                ProbeStats read() const{
+                    return {allocations.load(std::memory_order_relaxed), bytesAllocated.load(std::memory_order_relaxed),
+                            deallocations.load(std::memory_order_relaxed), bytesFreed.load(std::memory_order_relaxed),
+                            copies.load(std::memory_order_relaxed), moves.load(std::memory_order_relaxed)};
+                }
+
+                void reset(){
+                    for(auto* counter : {&allocations, &bytesAllocated, &deallocations, &bytesFreed, &copies, &moves}){
+                        counter->store(0, std::memory_order_relaxed);
+                    }
+                }
+            };
+
+            // Orders (tag, type) keys, and finds them from string views without building a std::string
+            struct TagKeyLess{
+                using is_transparent = void;
+
+                template<typename A, typename B>
+                bool operator()(const A& a, const B& b) const{
+                    return std::pair<std::string_view, std::string_view>(a.first, a.second)
+                         < std::pair<std::string_view, std::string_view>(b.first, b.second);
+                }
+            };
+
+            // Every type that recorded something, and the events recorded under each call-site tag
+            struct Registry{
+                std::mutex mutex;
+                std::vector<TypeCounters*> types;
+                std::map<std::pair<std::string, std::string_view>, ProbeStats, TagKeyLess> tagged; // (tag, type)
+
+                static Registry& get(){
+                    static Registry* registry = new Registry; // never freed, like the counters it lists
+                    return *registry;
+                }
+            };
+
+            // Innermost ScopedTag of the calling thread (empty outside any tag)
+            inline std::string_view& currentTag(){
+                thread_local std::string_view tag;
+                return tag;
+            }
+
+            inline void recordTagged(std::string_view type, Event event, std::int64_t bytes) noexcept {
+                std::string_view tag = currentTag();
+                if (tag.empty()) return;
+                Registry& registry = Registry::get();
+                try {
+                    std::lock_guard<std::mutex> lock(registry.mutex);
+                    auto found = registry.tagged.find(std::pair(tag, type));
+                    if (found == registry.tagged.end()){
+                        found = registry.tagged.emplace(std::pair(std::string(tag), type), ProbeStats{}).first;
+                    }
+                    apply(found->second, event, bytes);
+                } catch (...) {
+                    // tracing must never make the traced operation fail; an event lost to bad_alloc is acceptable
+                }
+            }
+        }
+
+        /**
+         * @class Probe
+         * @brief Recording points of one traced type; every member is a no-op unless the instrumentation is on.
+         * @tparam Tag Traced type (DynamicArray instantiations share detail::DynamicArrayCounterTag).
+         */
+        template<typename Tag>
+        class Probe{
+        private:
+            static detail::TypeCounters& counters(){
+                static detail::TypeCounters* instance = []{
+                    auto* c = new detail::TypeCounters; // never freed, so probes still work during static destruction
+                    c->name = probeName<Tag>;
+                    detail::Registry& registry = detail::Registry::get();
+                    std::lock_guard<std::mutex> lock(registry.mutex);
+                    registry.types.push_back(c);
+                    return c;
+                }();
+                return *instance;
+            }
+
+            static void record(detail::Event event, std::size_t bytes = 0) noexcept {
+                if constexpr (enabled){
+                    counters().record(event, static_cast<std::int64_t>(bytes));
+                    detail::recordTagged(probeName<Tag>, event, static_cast<std::int64_t>(bytes));
+                }
+            }
+
+        public:
+            static void allocated(std::size_t bytes) noexcept { record(detail::Event::Allocate, bytes); }
+            static void freed(std::size_t bytes) noexcept { record(detail::Event::Deallocate, bytes); }
+            static void copied() noexcept { record(detail::Event::Copy); }
+            static void moved() noexcept { record(detail::Event::Move); }
+
+            /**
+             * @brief Returns what the objects of Tag recorded since the start (or the last reset()).
+             * @return The counts, all zero when the instrumentation is off.
+             */
+            static ProbeStats stats(){
+                if constexpr (enabled){
+                    return counters().read();
+                } else {
+                    return {};
+                }
+            }
+        };
+
+        /**
+         * @brief Returns what the objects of Tag recorded.
+         * @return The counts, all zero when the instrumentation is off.
+         */
+        template<typename Tag>
+        ProbeStats stats(){
+            return Probe<Tag>::stats();
+        }
+
+        /**
+         * @brief Returns what the objects of a type recorded, looked up by the name used in reports.
+         * @param type Name of the type, e.g. "DynamicArray".
+         * @return The counts, all zero if the type recorded nothing.
+         */
+        inline ProbeStats stats(std::string_view type){
+            detail::Registry& registry = detail::Registry::get();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            ProbeStats total;
+            for(const detail::TypeCounters* counters : registry.types){
+                if (counters->name == type) total += counters->read();
+            }
+            return total;
+        }
+
+        /**
+         * @brief Returns what every traced type recorded under a call-site tag.
+         * @param tag Name given to ScopedTag.
+         * @param type Only count this type if not empty.
+         * @return The counts, all zero if nothing was recorded under the tag.
+         */
+        inline ProbeStats tagStats(std::string_view tag, std::string_view type = {}){
+            detail::Registry& registry = detail::Registry::get();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            ProbeStats total;
+            for(const auto& [key, stats] : registry.tagged){
+                if (key.first == tag && (type.empty() || key.second == type)) total += stats;
+            }
+            return total;
+        }
+
+        /**
+         * @brief Sets every counter back to zero and forgets the tags.
+         */
+        inline void reset(){
+            detail::Registry& registry = detail::Registry::get();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            for(detail::TypeCounters* counters : registry.types){
+                counters->reset();
+            }
+            registry.tagged.clear();
+        }
+
+        namespace detail{
+
+            inline void writeJsonString(std::ostream& os, std::string_view text){
+                os << '"';
+                for(char c : text){
+                    if (c == '"' || c == '\\') os << '\\' << c;
+                    else if (static_cast<unsigned char>(c) < 0x20) os << ' ';
+                    else os << c;
+                }
+                os << '"';
+            }
+
+            inline void writeJsonStats(std::ostream& os, const ProbeStats& s){
+                os << "\"allocations\": " << s.allocations << ", \"bytesAllocated\": " << s.bytesAllocated
+                   << ", \"deallocations\": " << s.deallocations << ", \"bytesFreed\": " << s.bytesFreed
+                   << ", \"copies\": " << s.copies << ", \"moves\": " << s.moves;
+            }
+        }
+
+        /**
+         * @brief Writes the counts of every type and every tag as JSON.
+         * @param os Stream the report is written to.
+         */
+        inline void writeReport(std::ostream& os){
+            detail::Registry& registry = detail::Registry::get();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            os << "{\n  \"enabled\": " << (enabled ? "true" : "false") << ",\n  \"types\": [";
+            const char* separator = "\n";
+            for(const detail::TypeCounters* counters : registry.types){
+                os << separator << "    {\"type\": ";
+                detail::writeJsonString(os, counters->name);
+                os << ", ";
+                detail::writeJsonStats(os, counters->read());
+                os << "}";
+                separator = ",\n";
+            }
+            os << "\n  ],\n  \"tags\": [";
+            separator = "\n";
+            for(const auto& [key, stats] : registry.tagged){
+                os << separator << "    {\"tag\": ";
+                detail::writeJsonString(os, key.first);
+                os << ", \"type\": ";
+                detail::writeJsonString(os, key.second);
+                os << ", ";
+                detail::writeJsonStats(os, stats);
+                os << "}";
+                separator = ",\n";
+            }
+            os << "\n  ]\n}\n";
+        }
+
+        /**
+         * @brief Writes the report to a file, e.g. at the end of a run.
+         * @param path File to be (over)written.
+         * @throws std::runtime_error if the file cannot be written.
+         */
+        inline void writeReport(const std::string& path){
+            std::ofstream file(path);
+            if (!file) throw std::runtime_error("instrument::writeReport: cannot open " + path);
+            writeReport(file);
+            if (!file) throw std::runtime_error("instrument::writeReport: cannot write " + path);
+        }
+
+        /**
+         * @class ScopedTag
+         * @brief Attributes everything the calling thread records while it lives to a call-site name.
+         *
+         * Tags nest: events go to the innermost tag only. The name must outlive the tag (a literal is typical).
+         */
+        class ScopedTag{
+#if OOP_INSTRUMENTATION
+            std::string_view previous;
+#endif
+        public:
+            explicit ScopedTag(std::string_view name){
+#if OOP_INSTRUMENTATION
+                previous = std::exchange(detail::currentTag(), name);
+#else
+                (void)name;
+#endif
+            }
+
+            ~ScopedTag(){
+#if OOP_INSTRUMENTATION
+                detail::currentTag() = previous;
+#endif
+            }
+
+            ScopedTag(const ScopedTag&) = delete;
+            ScopedTag& operator=(const ScopedTag&) = delete;
+        };
+
+        /**
+         * @class TrackingAllocator
+         * @brief std::allocator that reports its allocations to Probe<Tag>.
+         */
+        template<typename T, typename Tag>
+        class TrackingAllocator{
+        public:
+            using value_type = T;
+
+            TrackingAllocator() = default;
+
+            template<typename U>
+            TrackingAllocator(const TrackingAllocator<U, Tag>&) noexcept {}
+
+            template<typename U>
+            struct rebind{ using other = TrackingAllocator<U, Tag>; };
+
+            T* allocate(std::size_t n){
+                T* p = std::allocator<T>().allocate(n);
+                Probe<Tag>::allocated(n * sizeof(T));
+                return p;
+            }
+
+            void deallocate(T* p, std::size_t n) noexcept {
+                Probe<Tag>::freed(n * sizeof(T));
+                std::allocator<T>().deallocate(p, n);
+            }
+
+            template<typename U>
+            bool operator==(const TrackingAllocator<U, Tag>&) const noexcept { return true; }
+        };
+
+        /**
+         * @brief Allocator of the std containers inside traced types: tracked when the instrumentation is on.
+         */
+        template<typename T, typename Tag>
+        using TrackedAllocator = std::conditional_t<enabled, TrackingAllocator<T, Tag>, std::allocator<T>>;
+
+        /**
+         * @class TrackingResource
+         * @brief memory_resource that forwards to an upstream resource and reports its allocations to Probe<Tag>.
+         *
+         * Two tracking resources are equal when their upstream resources are, so memory allocated through one
+         * is always freed through a tracking one and the bytes freed match the bytes allocated.
+         */
+        template<typename Tag>
+        class TrackingResource : public std::pmr::memory_resource{
+        private:
+            std::pmr::memory_resource* upstreamResource;
+
+        public:
+            /**
+             * @brief Constructor of a resource tracking upstream.
+             * @param upstream Resource doing the allocations; it must outlive this one.
+             */
+            explicit TrackingResource(std::pmr::memory_resource* upstream) : upstreamResource(upstream){}
+
+            /** @brief Returns the resource doing the allocations. */
+            std::pmr::memory_resource* upstream() const noexcept { return upstreamResource; }
+
+        protected:
+            void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+                void* p = upstreamResource->allocate(bytes, alignment);
+                Probe<Tag>::allocated(bytes);
+                return p;
+            }
+
+            void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+                Probe<Tag>::freed(bytes);
+                upstreamResource->deallocate(p, bytes, alignment);
+            }
+
+            bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+                if (this == &other) return true;
+                auto* tracking = dynamic_cast<const TrackingResource*>(&other);
+                return tracking != nullptr && upstreamResource->is_equal(*tracking->upstreamResource);
+            }
+        };
+
+        /**
+         * @brief Resource the std::pmr members of traced types allocate through: tracked when the instrumentation is on.
+         *
+         * There is one TrackingResource per upstream resource and tag, created on first use and never freed,
+         * so the allocators of objects sharing a resource stay equal.
+         * @param upstream Resource given to the traced object.
+         * @return A TrackingResource<Tag> over upstream, or upstream itself when the instrumentation is off.
+         */
+        template<typename Tag>
+        std::pmr::memory_resource* trackedResource(std::pmr::memory_resource* upstream){
+            if constexpr (enabled){
+                thread_local std::pmr::memory_resource* lastUpstream = nullptr;
+                thread_local TrackingResource<Tag>* last = nullptr;
+                if (upstream != lastUpstream){
+                    if (dynamic_cast<TrackingResource<Tag>*>(upstream) != nullptr) return upstream;
+                    static std::mutex mutex;
+                    static auto* wrappers = new std::map<std::pmr::memory_resource*, TrackingResource<Tag>*>;
+                    std::lock_guard<std::mutex> lock(mutex);
+                    TrackingResource<Tag>*& wrapper = (*wrappers)[upstream];
+                    if (wrapper == nullptr) wrapper = new TrackingResource<Tag>(upstream);
+                    lastUpstream = upstream;
+                    last = wrapper;
+                }
+                return last;
+            } else {
+                return upstream;
+            }
+        }
+
+        /**
+         * @brief Undoes trackedResource(), so a traced object reports the resource it was given.
+         * @param resource Resource of a std::pmr member of a traced object.
+         * @return The upstream resource if resource is a TrackingResource<Tag>, resource itself otherwise.
+         */
+        template<typename Tag>
+        std::pmr::memory_resource* untrackedResource(std::pmr::memory_resource* resource){
+            if constexpr (enabled){
+                if (auto* tracking = dynamic_cast<TrackingResource<Tag>*>(resource)) return tracking->upstream();
+            }
+            return resource;
+        }
+    }
+
+}
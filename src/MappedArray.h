@@ -0,0 +1,367 @@
+/**
+ * @file MappedArray.h
+ * @brief Declaration of the MappedArray class, an array backed by a memory-mapped file instead of the heap.
+ */
+#pragma once
+
+#include "ArrayExpression.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <filesystem>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define OOP_HAS_MMAP 1
+#else
+#define OOP_HAS_MMAP 0
+#endif
+
+#if OOP_HAS_MMAP
+
+namespace oop{
+
+    /**
+     * @brief How a MappedArray opens its file.
+     */
+    enum class MapMode{
+        ReadOnly,  /**< the file is mapped copy-on-write: writes through the array stay in memory, the file is unchanged. */
+        ReadWrite  /**< the file is created if missing, and writes and growth go to the file. */
+    };
+
+    /**
+     * @brief Access pattern passed to the kernel with madvise() to tune read-ahead.
+     */
+    enum class AccessHint{ Normal, Sequential, Random, WillNeed, DontNeed };
+
+    /**
+     * @class MappedArray
+     * @brief Array whose elements live in a file mapped into memory with mmap.
+     * @tparam T Type of the elements (trivially copyable, stored as raw bytes in the native byte order).
+     *
+     * Opening the array only maps the file, so a dataset of several gigabytes is usable immediately and its
+     * pages are read on first access. The file holds raw elements and nothing else. In read-write mode
+     * push_back() and resize() grow the file with ftruncate() and remap it, so pointers into the array are
+     * invalidated like in DynamicArray; while the array is open the file is capacity() elements long, and
+     * closing it trims the spare capacity so that it then holds exactly size() elements. flush() writes the
+     * dirty pages back with msync(). The array is move-only and unmaps and closes the file when destroyed.
+     * Errors of the system calls are reported as std::system_error.
+     */
+    template<typename T>
+    class MappedArray{
+        static_assert(std::is_trivially_copyable_v<T>, "MappedArray stores its elements as raw bytes");
+
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using iterator = T*;
+        using const_iterator = const T*;
+
+    private:
+        int fd = -1; /**< descriptor of the mapped file. */
+        MapMode mode = MapMode::ReadOnly; /**< mode the file was opened in. */
+        T* ptr = nullptr; /**< start of the mapping, nullptr while the capacity is 0. */
+        size_type arrSize = 0; /**< number of elements in use. */
+        size_type arrCapacity = 0; /**< number of elements mapped (and in the file while it is open). */
+
+        static constexpr size_type minCapacity = 4096 / sizeof(T) > 0 ? 4096 / sizeof(T) : 1; /**< one page at least. */
+
+        [[noreturn]] static void fail(const std::string& what){
+            throw std::system_error(errno, std::generic_category(), "MappedArray: " + what);
+        }
+
+        void map(size_type capacity){
+            if (capacity == 0){
+                ptr = nullptr;
+                return;
+            }
+            int protection = PROT_READ | PROT_WRITE; // writable in read-only mode too, where the pages are private copies
+            int flags = mode == MapMode::ReadWrite ? MAP_SHARED : MAP_PRIVATE;
+            void* p = ::mmap(nullptr, capacity * sizeof(T), protection, flags, fd, 0);
+            if (p == MAP_FAILED) fail("mmap");
+            ptr = static_cast<T*>(p);
+        }
+
+        void unmap(){
+            if (ptr != nullptr){
+                ::munmap(ptr, arrCapacity * sizeof(T));
+                ptr = nullptr;
+            }
+        }
+
+        // Sets the file to capacity elements and maps all of them
+        void remap(size_type capacity){
+            if (::ftruncate(fd, static_cast<off_t>(capacity * sizeof(T))) != 0) fail("ftruncate");
+#if defined(__linux__) && defined(MREMAP_MAYMOVE)
+            if (ptr != nullptr && capacity != 0){
+                void* p = ::mremap(ptr, arrCapacity * sizeof(T), capacity * sizeof(T), MREMAP_MAYMOVE);
+                if (p == MAP_FAILED) fail("mremap");
+                ptr = static_cast<T*>(p);
+                arrCapacity = capacity;
+                return;
+            }
+#endif
+            unmap();
+            arrCapacity = capacity;
+            map(capacity);
+        }
+
+        void requireWritable(const char* operation) const{
+            if (mode != MapMode::ReadWrite){
+                throw std::logic_error(std::string("MappedArray: ") + operation + " on a read-only array");
+            }
+        }
+
+        // Unmaps, trims the spare capacity off the file and closes it
+        void close() noexcept{
+            if (fd < 0) return;
+            unmap();
+            if (mode == MapMode::ReadWrite && arrCapacity != arrSize){
+                [[maybe_unused]] int result = ::ftruncate(fd, static_cast<off_t>(arrSize * sizeof(T)));
+            }
+            ::close(fd);
+            fd = -1;
+            arrSize = arrCapacity = 0;
+        }
+
+    public:
+        /**
+         * @brief Maps an existing file of raw elements, or creates an empty one in read-write mode.
+         * @param path File holding the elements.
+         * @param mode Whether the array may be modified and grown.
+         * @throws std::system_error if the file cannot be opened or mapped.
+         * @throws std::runtime_error if the size of the file is not a multiple of sizeof(T).
+         */
+        explicit MappedArray(const std::filesystem::path& path, MapMode mode = MapMode::ReadOnly) : mode(mode){
+            int flags = mode == MapMode::ReadWrite ? O_RDWR | O_CREAT : O_RDONLY;
+            fd = ::open(path.c_str(), flags | O_CLOEXEC, 0644);
+            if (fd < 0) fail("cannot open " + path.string());
+            struct stat info;
+            if (::fstat(fd, &info) != 0){
+                int error = errno;
+                ::close(fd);
+                errno = error;
+                fail("fstat");
+            }
+            if (static_cast<std::size_t>(info.st_size) % sizeof(T) != 0){
+                ::close(fd);
+                throw std::runtime_error("MappedArray: size of " + path.string() + " is not a multiple of the element size");
+            }
+            arrSize = arrCapacity = static_cast<std::size_t>(info.st_size) / sizeof(T);
+            try {
+                map(arrCapacity);
+            } catch (...) {
+                ::close(fd);
+                throw;
+            }
+        }
+
+        /**
+         * @brief Creates (or truncates) a file of n zero elements and maps it in read-write mode.
+         * @param path File to be created.
+         * @param n Number of elements.
+         * @return The mapped array.
+         */
+        static MappedArray create(const std::filesystem::path& path, size_type n = 0){
+            int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+            if (fd < 0) fail("cannot create " + path.string());
+            ::close(fd);
+            MappedArray array(path, MapMode::ReadWrite);
+            array.resize(n);
+            return array;
+        }
+
+        MappedArray(const MappedArray&) = delete;
+        MappedArray& operator=(const MappedArray&) = delete;
+
+        /**
+         * @brief Move constructor: the mapping and the file descriptor are transferred.
+         * @param other Array to be moved, left empty and closed.
+         */
+        MappedArray(MappedArray&& other) noexcept
+            : fd(std::exchange(other.fd, -1)), mode(other.mode), ptr(std::exchange(other.ptr, nullptr)),
+              arrSize(std::exchange(other.arrSize, 0)), arrCapacity(std::exchange(other.arrCapacity, 0)) {}
+
+        /**
+         * @brief Move assignment: the current file is closed and the mapping of other is taken over.
+         * @param other Array to be moved, left empty and closed.
+         * @return Reference to this array.
+         */
+        MappedArray& operator=(MappedArray&& other) noexcept{
+            if (this != &other){
+                close();
+                fd = std::exchange(other.fd, -1);
+                mode = other.mode;
+                ptr = std::exchange(other.ptr, nullptr);
+                arrSize = std::exchange(other.arrSize, 0);
+                arrCapacity = std::exchange(other.arrCapacity, 0);
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Destructor that unmaps the file (dirty pages are still written back by the kernel) and closes it.
+         */
+        ~MappedArray(){
+            close();
+        }
+
+        /**
+         * @brief Returns the size of the array.
+         * @return The number of elements.
+         */
+        size_type size() const { return arrSize; }
+
+        /**
+         * @brief Returns the number of elements the mapping holds before the file has to grow again.
+         * @return The capacity of the array.
+         */
+        size_type capacity() const { return arrCapacity; }
+
+        /**
+         * @brief Returns whether the array has no elements.
+         * @return True if the size is 0.
+         */
+        bool empty() const { return arrSize == 0; }
+
+        /**
+         * @brief Returns whether the array is still attached to a file (false after being moved from).
+         * @return True if a file is open.
+         */
+        bool isOpen() const { return fd >= 0; }
+
+        /**
+         * @brief Returns the mode the file was opened in.
+         * @return ReadOnly or ReadWrite.
+         */
+        MapMode getMode() const { return mode; }
+
+        /**
+         * @brief Overloaded operator[] to access the elements of the array.
+         * @param index Index of the element (in read-only mode a write changes the memory but not the file).
+         * @return Reference to the element at index.
+         */
+        T& operator[](size_type index){ return ptr[index]; }
+
+        /**
+         * @brief Overloaded operator[] to read the elements of a const array.
+         * @param index Index of the element.
+         * @return Const reference to the element at index.
+         */
+        const T& operator[](size_type index) const { return ptr[index]; }
+
+        T* data(){ return ptr; }
+        const T* data() const { return ptr; }
+
+        iterator begin(){ return ptr; }
+        iterator end(){ return ptr + arrSize; }
+        const_iterator begin() const { return ptr; }
+        const_iterator end() const { return ptr + arrSize; }
+
+        /**
+         * @brief Tells the kernel how the array is going to be read, to tune read-ahead.
+         * @param hint Expected access pattern.
+         */
+        void advise(AccessHint hint){
+            if (ptr == nullptr) return;
+            int advice = MADV_NORMAL;
+            switch(hint){
+                case AccessHint::Normal: advice = MADV_NORMAL; break;
+                case AccessHint::Sequential: advice = MADV_SEQUENTIAL; break;
+                case AccessHint::Random: advice = MADV_RANDOM; break;
+                case AccessHint::WillNeed: advice = MADV_WILLNEED; break;
+                case AccessHint::DontNeed: advice = MADV_DONTNEED; break;
+            }
+            if (::madvise(ptr, arrCapacity * sizeof(T), advice) != 0) fail("madvise");
+        }
+
+        /**
+         * @brief Grows the file so that newCapacity elements fit without remapping.
+         * @param newCapacity Minimum capacity of the array.
+         */
+        void reserve(size_type newCapacity){
+            requireWritable("reserve");
+            if (newCapacity > arrCapacity){
+                remap(newCapacity);
+            }
+        }
+
+        /**
+         * @brief Changes the number of elements; new elements are zero (the file is extended with zeros).
+         * @param newSize New size of the array.
+         */
+        void resize(size_type newSize){
+            requireWritable("resize");
+            if (newSize > arrSize){
+                // Slots below the old capacity may hold elements left by pop_back or a shrinking resize
+                std::fill(ptr + arrSize, ptr + std::min(newSize, arrCapacity), T{});
+            }
+            if (newSize > arrCapacity){
+                remap(newSize);
+            }
+            arrSize = newSize;
+        }
+
+        /**
+         * @brief Appends value to the end of the array, growing the file geometrically when it is full.
+         * @param value Element to be appended (copied first, so it may be an element of this array).
+         */
+        void push_back(T value){
+            requireWritable("push_back");
+            if (arrSize == arrCapacity){
+                remap(std::max({arrSize + 1, arrCapacity * 2, minCapacity}));
+            }
+            ptr[arrSize++] = value;
+        }
+
+        /**
+         * @brief Removes the last element of the array.
+         */
+        void pop_back(){
+            arrSize--;
+        }
+
+        /**
+         * @brief Writes the modified pages back to the file and waits for the write to finish.
+         */
+        void flush(){
+            if (mode == MapMode::ReadWrite && ptr != nullptr){
+                if (::msync(ptr, arrCapacity * sizeof(T), MS_SYNC) != 0) fail("msync");
+            }
+        }
+
+        /**
+         * @brief Overloaded operator<< to print the array in the same form as DynamicArray.
+         * @param os Output stream.
+         * @param other Array to be printed.
+         * @return The output stream.
+         */
+        friend std::ostream& operator<<(std::ostream& os, const MappedArray& other) {
+            os << "[";
+            for(size_type i=0; i<other.arrSize;i++){
+                os << other.ptr[i];
+                if (i!=other.arrSize - 1){
+                    os << ", ";
+                }
+            }
+            os << "]";
+            return os;
+        }
+    };
+
+    template<typename T>
+    inline constexpr bool isConcatOperand<MappedArray<T>> = true;
+
+}
+
+#endif
@@ -0,0 +1,287 @@
+/**
+ * @file MemoryResource.h
+ * @brief Declaration of the ArenaResource and PoolResource memory resources for std::pmr allocators.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+namespace oop{
+
+    /**
+     * @class ArenaResource
+     * @brief Bump-pointer memory resource: allocation moves a pointer forward and deallocation does nothing.
+     *
+     * Memory is taken from the upstream resource in chunks of growing size and only returned by release()
+     * or the destructor, so a whole batch of objects built on the arena is freed at once. Objects with
+     * destructors that do more than free memory must still be destroyed before the arena is released.
+     * Not thread-safe: use one arena per thread.
+     */
+    class ArenaResource : public std::pmr::memory_resource{
+    private:
+        // Header stored at the start of every chunk obtained from upstream
+        struct Chunk{
+            Chunk* previous;
+            std::size_t size;
+        };
+
+        std::pmr::memory_resource* upstream; /**< resource providing the chunks. */
+        std::byte* initialBuffer = nullptr; /**< optional buffer given by the user, never freed. */
+        std::size_t initialBufferSize = 0; /**< size of the user buffer. */
+        std::size_t initialChunkSize; /**< size of the first chunk obtained from upstream. */
+        std::size_t nextChunkSize; /**< size of the next chunk, doubled after every chunk. */
+        Chunk* chunks = nullptr; /**< most recent chunk, linked to the previous ones. */
+        std::byte* current = nullptr; /**< next free byte of the current chunk. */
+        std::byte* limit = nullptr; /**< end of the current chunk. */
+        std::size_t allocated = 0; /**< bytes handed out since the last release. */
+
+        static constexpr std::size_t maxChunkSize = std::size_t{64} << 20; /**< chunks stop doubling at 64 MiB. */
+
+        // Takes a new chunk from upstream that can hold bytes with the given alignment
+        void grow(std::size_t bytes, std::size_t alignment){
+            std::size_t header = (sizeof(Chunk) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+            std::size_t size = std::max(nextChunkSize, header + bytes + alignment);
+            auto* chunk = static_cast<Chunk*>(upstream->allocate(size, alignof(std::max_align_t)));
+            chunk->previous = chunks;
+            chunk->size = size;
+            chunks = chunk;
+            current = reinterpret_cast<std::byte*>(chunk) + header;
+            limit = reinterpret_cast<std::byte*>(chunk) + size;
+            nextChunkSize = std::min(nextChunkSize * 2, maxChunkSize);
+        }
+
+        // Aligned pointer for bytes inside the current chunk, or nullptr if they do not fit
+        void* bump(std::size_t bytes, std::size_t alignment){
+            void* p = current;
+            std::size_t space = static_cast<std::size_t>(limit - current);
+            if (current == nullptr || std::align(alignment, bytes, p, space) == nullptr){
+                return nullptr;
+            }
+            current = static_cast<std::byte*>(p) + bytes;
+            allocated += bytes;
+            return p;
+        }
+
+    protected:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+            if (void* p = bump(bytes, alignment)){
+                return p;
+            }
+            grow(bytes, alignment);
+            return bump(bytes, alignment);
+        }
+
+        void do_deallocate(void*, std::size_t, std::size_t) override {
+            // memory is only given back by release()
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+
+    public:
+        /**
+         * @brief Constructor that takes the size of the first chunk.
+         * @param initialChunkSize Bytes requested from upstream the first time memory is needed.
+         * @param upstream Resource providing the chunks.
+         */
+        explicit ArenaResource(std::size_t initialChunkSize = 64 * 1024,
+                               std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+            : upstream(upstream), initialChunkSize(std::max<std::size_t>(initialChunkSize, 256)),
+              nextChunkSize(this->initialChunkSize){}
+
+        /**
+         * @brief Constructor that serves the first allocations from a buffer owned by the caller (e.g. on the stack).
+         * @param buffer Memory used before anything is requested from upstream.
+         * @param size Size of the buffer in bytes.
+         * @param upstream Resource providing the chunks once the buffer is full.
+         */
+        ArenaResource(void* buffer, std::size_t size, std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+            : ArenaResource(std::max<std::size_t>(size, 256), upstream){
+            initialBuffer = static_cast<std::byte*>(buffer);
+            initialBufferSize = size;
+            current = initialBuffer;
+            limit = initialBuffer + size;
+        }
+
+        ArenaResource(const ArenaResource&) = delete;
+        ArenaResource& operator=(const ArenaResource&) = delete;
+
+        /**
+         * @brief Destructor that returns every chunk to upstream.
+         */
+        ~ArenaResource() override {
+            release();
+        }
+
+        /**
+         * @brief Frees everything allocated from the arena at once; it can be reused afterwards.
+         */
+        void release(){
+            while(chunks != nullptr){
+                Chunk* previous = chunks->previous;
+                upstream->deallocate(chunks, chunks->size, alignof(std::max_align_t));
+                chunks = previous;
+            }
+            current = initialBuffer;
+            limit = initialBuffer == nullptr ? nullptr : initialBuffer + initialBufferSize;
+            nextChunkSize = initialChunkSize;
+            allocated = 0;
+        }
+
+        /**
+         * @brief Returns the number of bytes handed out since the last release.
+         * @return Bytes allocated from the arena.
+         */
+        std::size_t getBytesAllocated() const {
+            return allocated;
+        }
+
+        /**
+         * @brief Returns the resource the chunks come from.
+         * @return The upstream resource.
+         */
+        std::pmr::memory_resource* getUpstream() const {
+            return upstream;
+        }
+    };
+
+    /**
+     * @class PoolResource
+     * @brief Memory resource handing out blocks of one fixed size from a free list.
+     *
+     * Blocks are carved out of chunks taken from the upstream resource, and deallocated blocks go back to
+     * the free list, so objects of one size are recycled without touching the global allocator. Requests
+     * larger than the block size are forwarded to upstream. Not thread-safe.
+     */
+    class PoolResource : public std::pmr::memory_resource{
+    private:
+        struct FreeBlock{
+            FreeBlock* next;
+        };
+
+        struct Chunk{
+            Chunk* previous;
+            std::size_t size;
+        };
+
+        std::pmr::memory_resource* upstream; /**< resource providing the chunks and the large blocks. */
+        std::size_t blockSize; /**< size of every block, a multiple of the block alignment. */
+        std::size_t blockAlignment; /**< alignment guaranteed for every block. */
+        std::size_t blocksPerChunk; /**< number of blocks carved from each chunk. */
+        FreeBlock* freeList = nullptr; /**< blocks ready to be handed out. */
+        Chunk* chunks = nullptr; /**< most recent chunk, linked to the previous ones. */
+        std::size_t blocksInUse = 0; /**< blocks handed out and not returned. */
+
+        std::size_t headerSize() const {
+            return (sizeof(Chunk) + blockAlignment - 1) & ~(blockAlignment - 1);
+        }
+
+        // Takes a new chunk from upstream and threads its blocks onto the free list
+        void refill(){
+            std::size_t size = headerSize() + blockSize * blocksPerChunk;
+            auto* chunk = static_cast<Chunk*>(upstream->allocate(size, blockAlignment));
+            chunk->previous = chunks;
+            chunk->size = size;
+            chunks = chunk;
+            std::byte* first = reinterpret_cast<std::byte*>(chunk) + headerSize();
+            for(std::size_t i = blocksPerChunk; i-- > 0;){
+                auto* block = reinterpret_cast<FreeBlock*>(first + i * blockSize);
+                block->next = freeList;
+                freeList = block;
+            }
+        }
+
+        bool fitsBlock(std::size_t bytes, std::size_t alignment) const {
+            return bytes <= blockSize && alignment <= blockAlignment;
+        }
+
+    protected:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+            if (!fitsBlock(bytes, alignment)){
+                return upstream->allocate(bytes, alignment);
+            }
+            if (freeList == nullptr){
+                refill();
+            }
+            FreeBlock* block = freeList;
+            freeList = block->next;
+            blocksInUse++;
+            return block;
+        }
+
+        void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+            if (!fitsBlock(bytes, alignment)){
+                upstream->deallocate(p, bytes, alignment);
+                return;
+            }
+            auto* block = static_cast<FreeBlock*>(p);
+            block->next = freeList;
+            freeList = block;
+            blocksInUse--;
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+
+    public:
+        /**
+         * @brief Constructor that takes the size of the blocks.
+         * @param blockSize Largest allocation served from the pool (rounded up to the block alignment).
+         * @param blocksPerChunk Number of blocks requested from upstream at a time.
+         * @param upstream Resource providing the chunks and the allocations larger than a block.
+         */
+        explicit PoolResource(std::size_t blockSize, std::size_t blocksPerChunk = 1024,
+                              std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+            : upstream(upstream), blocksPerChunk(std::max<std::size_t>(blocksPerChunk, 1)){
+            blockSize = std::max(blockSize, sizeof(FreeBlock));
+            this->blockSize = (blockSize + alignof(FreeBlock) - 1) & ~(alignof(FreeBlock) - 1);
+            // Blocks are aligned to the largest power of two dividing their size, up to max_align_t
+            blockAlignment = std::min(alignof(std::max_align_t), this->blockSize & (~this->blockSize + 1));
+        }
+
+        PoolResource(const PoolResource&) = delete;
+        PoolResource& operator=(const PoolResource&) = delete;
+
+        /**
+         * @brief Destructor that returns every chunk to upstream.
+         */
+        ~PoolResource() override {
+            release();
+        }
+
+        /**
+         * @brief Returns every chunk to upstream, invalidating all the blocks at once.
+         */
+        void release(){
+            while(chunks != nullptr){
+                Chunk* previous = chunks->previous;
+                upstream->deallocate(chunks, chunks->size, blockAlignment);
+                chunks = previous;
+            }
+            freeList = nullptr;
+            blocksInUse = 0;
+        }
+
+        /**
+         * @brief Returns the size of the blocks.
+         * @return Bytes per block.
+         */
+        std::size_t getBlockSize() const {
+            return blockSize;
+        }
+
+        /**
+         * @brief Returns the number of blocks currently handed out.
+         * @return Blocks in use.
+         */
+        std::size_t getBlocksInUse() const {
+            return blocksInUse;
+        }
+    };
+
+}
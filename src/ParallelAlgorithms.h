@@ -0,0 +1,280 @@
+/**
+ * @file ParallelAlgorithms.h
+ * @brief Multithreaded fill, copy, transform, reduce and sort over DynamicArray, run on a ThreadPool.
+ */
+#pragma once
+
+#include "ArrayOps.h"
+#include "DynamicArray.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+/**
+ * @namespace oop::parallel
+ * @brief Parallel versions of the array algorithms. Arrays below serialCutoffBytes are processed serially.
+ */
+namespace oop::parallel{
+
+    /**
+     * @brief Arrays smaller than this many bytes are processed on the calling thread only.
+     */
+    inline constexpr std::size_t serialCutoffBytes = 512 * 1024;
+
+    /**
+     * @brief Size of the per-core L2 cache, used to size the chunks handed to each thread.
+     * @return Bytes of L2 cache (1 MiB if it cannot be queried).
+     */
+    inline std::size_t cacheSizeBytes(){
+        static const std::size_t bytes = []{
+#if defined(_SC_LEVEL2_CACHE_SIZE)
+            long queried = sysconf(_SC_LEVEL2_CACHE_SIZE);
+            if (queried > 0) return static_cast<std::size_t>(queried);
+#endif
+            return std::size_t{1024 * 1024};
+        }();
+        return bytes;
+    }
+
+    namespace detail{
+
+        // Elements per chunk so that the data touched by one chunk fits in half the L2 cache
+        inline std::size_t chunkElements(std::size_t bytesPerElement){
+            return std::max<std::size_t>(cacheSizeBytes() / 2 / bytesPerElement, 1024);
+        }
+
+        // Runs body(chunkBegin, chunkEnd) over [0, n), in parallel only when the data is large enough
+        template<typename F>
+        void forEachChunk(ThreadPool& pool, std::size_t n, std::size_t bytesPerElement, F&& body){
+            if (n * bytesPerElement < serialCutoffBytes || pool.size() == 0){
+                if (n != 0) body(std::size_t{0}, n);
+                return;
+            }
+            pool.parallelFor(0, n, chunkElements(bytesPerElement), body);
+        }
+
+        template<typename A, typename B>
+        void requireSameSize(const A& a, const B& b){
+            if (static_cast<std::size_t>(a.size()) != static_cast<std::size_t>(b.size())){
+                throw std::invalid_argument("parallel algorithm on arrays of different sizes");
+            }
+        }
+
+        // First index k - i of b such that merging a[0, i) and b[0, k - i) gives the first k elements of the merge
+        template<typename T, typename Compare>
+        std::size_t coRank(std::size_t k, const T* a, std::size_t na, const T* b, std::size_t nb, Compare& comp){
+            std::size_t low = k > nb ? k - nb : 0;
+            std::size_t high = std::min(k, na);
+            while(low < high){
+                std::size_t i = low + (high - low) / 2;
+                std::size_t j = k - i;
+                if (j > 0 && !comp(b[j - 1], a[i])){
+                    low = i + 1; // a[i] goes before b[j - 1], so more elements come from a
+                } else {
+                    high = i;
+                }
+            }
+            return low;
+        }
+
+        // Stable merge of a and b into out, with the output split in chunks that are merged independently
+        template<typename T, typename Compare>
+        void merge(ThreadPool& pool, const T* a, std::size_t na, const T* b, std::size_t nb, T* out, Compare& comp){
+            forEachChunk(pool, na + nb, 2 * sizeof(T), [&](std::size_t first, std::size_t last){
+                std::size_t ia = coRank(first, a, na, b, nb, comp);
+                std::size_t ja = coRank(last, a, na, b, nb, comp);
+                std::merge(a + ia, a + ja, b + (first - ia), b + (last - ja), out + first, comp);
+            });
+        }
+    }
+
+    /**
+     * @brief Sets every element of the array to value.
+     * @param a DynamicArray or DynamicArrayVector.
+     * @param value New value of the elements.
+     * @param pool Pool running the chunks.
+     */
+    template<typename A>
+    void fill(A& a, const typename A::value_type& value, ThreadPool& pool = ThreadPool::global()){
+        using T = typename A::value_type;
+        T* data = a.data();
+        detail::forEachChunk(pool, a.size(), sizeof(T), [&](std::size_t first, std::size_t last){
+            if constexpr (oop::detail::Int32Array<A>){
+                simd::kernels().fill(data + first, last - first, value);
+            } else {
+                std::fill(data + first, data + last, value);
+            }
+        });
+    }
+
+    /**
+     * @brief Copies src into dst, which must have the same size.
+     * @param src Array to be copied.
+     * @param dst Array receiving the elements.
+     * @param pool Pool running the chunks.
+     */
+    template<typename A>
+    void copy(const A& src, A& dst, ThreadPool& pool = ThreadPool::global()){
+        using T = typename A::value_type;
+        detail::requireSameSize(src, dst);
+        const T* from = src.data();
+        T* to = dst.data();
+        detail::forEachChunk(pool, src.size(), 2 * sizeof(T), [&](std::size_t first, std::size_t last){
+            if constexpr (std::is_trivially_copyable_v<T>){
+                std::memcpy(to + first, from + first, (last - first) * sizeof(T));
+            } else {
+                std::copy(from + first, from + last, to + first);
+            }
+        });
+    }
+
+    /**
+     * @brief Makes a copy of the array with the element copies spread over the pool.
+     * @param src Array to be copied.
+     * @param pool Pool running the chunks.
+     * @return The copy.
+     */
+    template<typename A>
+    A copy(const A& src, ThreadPool& pool = ThreadPool::global()){
+        A result = oop::detail::uninitializedLike(src);
+        copy(src, result, pool);
+        return result;
+    }
+
+    /**
+     * @brief Stores op(in[i]) in out[i]; in and out must have the same size and may be the same array.
+     * @param in Source array.
+     * @param out Destination array.
+     * @param op Function applied to every element, called concurrently from several threads.
+     * @param pool Pool running the chunks.
+     */
+    template<typename A, typename B, typename UnaryOp>
+    void transform(const A& in, B& out, UnaryOp op, ThreadPool& pool = ThreadPool::global()){
+        detail::requireSameSize(in, out);
+        auto from = in.data();
+        auto to = out.data();
+        detail::forEachChunk(pool, in.size(), sizeof(*from) + sizeof(*to), [&](std::size_t first, std::size_t last){
+            for(std::size_t i = first; i < last; i++){
+                to[i] = op(from[i]);
+            }
+        });
+    }
+
+    /**
+     * @brief Combines all the elements with op, each chunk on its own thread.
+     * @param a Array to be reduced.
+     * @param init Initial value of the reduction.
+     * @param op Associative operation; chunk results are combined in order.
+     * @param pool Pool running the chunks.
+     * @return op(...op(op(init, a[0]), a[1])..., a[n - 1]) up to reassociation.
+     */
+    template<typename A, typename T, typename BinaryOp>
+    T reduce(const A& a, T init, BinaryOp op, ThreadPool& pool = ThreadPool::global()){
+        using V = typename A::value_type;
+        const V* data = a.data();
+        std::size_t n = a.size();
+        std::size_t grain = detail::chunkElements(sizeof(V));
+        if (n * sizeof(V) < serialCutoffBytes || pool.size() == 0){
+            for(std::size_t i = 0; i < n; i++) init = op(init, data[i]);
+            return init;
+        }
+
+        std::vector<T> partials((n + grain - 1) / grain);
+        pool.parallelFor(0, n, grain, [&](std::size_t first, std::size_t last){
+            T partial = data[first];
+            for(std::size_t i = first + 1; i < last; i++) partial = op(partial, data[i]);
+            partials[first / grain] = partial;
+        });
+        for(const T& partial : partials) init = op(init, partial);
+        return init;
+    }
+
+    /**
+     * @brief Sum of the elements, with the SIMD kernels on each chunk for arrays of int.
+     * @param a Array to be added.
+     * @param pool Pool running the chunks.
+     * @return Sum of the elements (integers are added in 64 bits).
+     */
+    template<typename A>
+    oop::detail::AccumulatorType<typename A::value_type> sum(const A& a, ThreadPool& pool = ThreadPool::global()){
+        using V = typename A::value_type;
+        using Result = oop::detail::AccumulatorType<V>;
+        if constexpr (oop::detail::Int32Array<A>){
+            const V* data = a.data();
+            std::size_t grain = detail::chunkElements(sizeof(V));
+            if (a.size() * sizeof(V) < serialCutoffBytes || pool.size() == 0){
+                return simd::kernels().sum(data, a.size());
+            }
+            std::vector<Result> partials((a.size() + grain - 1) / grain);
+            pool.parallelFor(0, a.size(), grain, [&](std::size_t first, std::size_t last){
+                partials[first / grain] = simd::kernels().sum(data + first, last - first);
+            });
+            Result total = 0;
+            for(Result partial : partials) total += partial;
+            return total;
+        } else {
+            return reduce(a, Result{}, std::plus<>(), pool);
+        }
+    }
+
+    /**
+     * @brief Sorts the array: blocks are sorted in parallel and then merged pairwise with parallel merges.
+     * @param a Array to be sorted.
+     * @param comp Strict weak ordering of the elements.
+     * @param pool Pool running the blocks and merges.
+     */
+    template<typename A, typename Compare = std::less<>>
+    void sort(A& a, Compare comp = Compare(), ThreadPool& pool = ThreadPool::global()){
+        using T = typename A::value_type;
+        std::size_t n = a.size();
+        T* data = a.data();
+        if constexpr (!std::is_default_constructible_v<T>){
+            std::sort(data, data + n, comp); // the merge buffer needs default-constructible elements
+            return;
+        } else {
+            if (n * sizeof(T) < serialCutoffBytes || pool.size() == 0){
+                std::sort(data, data + n, comp);
+                return;
+            }
+
+            // A power of two number of blocks, at least one per thread, so the merge rounds pair up evenly
+            std::size_t blocks = 1;
+            while(blocks < pool.size() + 1) blocks *= 2;
+            std::size_t width = (n + blocks - 1) / blocks;
+            pool.parallelFor(0, blocks, 1, [&](std::size_t first, std::size_t last){
+                for(std::size_t block = first; block < last; block++){
+                    std::size_t begin = std::min(n, block * width);
+                    std::sort(data + begin, data + std::min(n, begin + width), comp);
+                }
+            });
+
+            DynamicArray<T> buffer(n, defaultInit);
+            T* from = data;
+            T* to = buffer.data();
+            for(; width < n; width *= 2){
+                for(std::size_t begin = 0; begin < n; begin += 2 * width){
+                    std::size_t middle = std::min(n, begin + width);
+                    std::size_t end = std::min(n, begin + 2 * width);
+                    detail::merge(pool, from + begin, middle - begin, from + middle, end - middle, to + begin, comp);
+                }
+                std::swap(from, to);
+            }
+            if (from != data){
+                detail::forEachChunk(pool, n, 2 * sizeof(T), [&](std::size_t first, std::size_t last){
+                    std::copy(from + first, from + last, data + first);
+                });
+            }
+        }
+    }
+
+}
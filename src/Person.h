@@ -0,0 +1,52 @@
+/**
+ * @file Person.h
+ * @brief Declaration of the Person class used by the rule of zero example.
+ */
+#pragma once
+
+#include "InstanceCounter.h"
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace oop{
+
+    class Person;
+
+    template<>
+    inline constexpr std::string_view instrument::probeName<Person> = "Person";
+
+    /**
+     * @class Person
+     * @brief A person with hobbies that relies on the compiler-generated copy and move operations (rule of zero).
+     *
+     * The counting base class is copied and moved by those generated operations too, so instanceStats()
+     * reports every Person created, copied, moved and destroyed without any code in Person.
+     */
+    class Person : public InstanceCounted<Person> {
+    public:
+        std::string name;
+        int age;
+        std::vector<std::string> hobbies;
+
+        /**
+         * @brief Constructor that takes its arguments by value and moves them into the members.
+         *
+         * Callers passing temporaries (string literals, braced lists, std::move) pay one construction per
+         * string; callers passing lvalues pay exactly one copy.
+         */
+        Person(std::string name, int age, std::vector <std::string> hobbies) : 
+        name(std::move(name)), age(age), hobbies(std::move(hobbies)){}
+
+        void printHobbies() const {
+            std::cout<<"Hobbies:"<<std::endl;
+            for(std::size_t i=0; i<hobbies.size(); i++){
+                std::cout<<"- "<<hobbies[i]<<std::endl;
+            }
+        }
+    };
+
+}
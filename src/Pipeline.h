@@ -0,0 +1,643 @@
+/**
+ * @file Pipeline.h
+ * @brief Declaration of Pipeline, coroutine stages connected by bounded channels and run on a ThreadPool.
+ */
+#pragma once
+
+#include "CourseCatalog.h"
+#include "Random.h"
+#include "Student.h"
+#include "StudentGenerator.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace oop{
+
+    /**
+     * @class Executor
+     * @brief Interface of the objects that resume suspended coroutines.
+     */
+    class Executor{
+    public:
+        virtual ~Executor() = default;
+
+        /**
+         * @brief Queues a coroutine to be resumed later, on any thread.
+         * @param handle Suspended coroutine.
+         */
+        virtual void schedule(std::coroutine_handle<> handle) = 0;
+
+        /**
+         * @brief Tells the executor a coroutine suspended until another one passes it to schedule().
+         *
+         * Lets the executor notice when every coroutine waits on another one and none can make progress.
+         */
+        virtual void suspended(){}
+    };
+
+    /**
+     * @class ChannelBase
+     * @brief Part of a Channel that does not depend on the element type, so a Pipeline can close all of them.
+     */
+    class ChannelBase{
+    public:
+        virtual ~ChannelBase() = default;
+
+        /** @brief Closes the channel at once, whatever the number of producers left. */
+        virtual void close() = 0;
+    };
+
+    /**
+     * @class Channel
+     * @brief Bounded queue between coroutines: a sender suspends while the queue is full and a receiver while it is empty.
+     *
+     * The bound gives backpressure: a fast stage cannot run ahead of a slow one by more than capacity items,
+     * so the items in flight stay few and hot in cache. Suspended coroutines are resumed through the executor,
+     * never inside send() or receive(), so a chain of stages cannot grow the stack. A capacity of 0 makes each
+     * send wait for a receiver.
+     *
+     * The channel closes when each of its producers called done() (or when close() is called); receivers then
+     * drain the items left and get std::nullopt, and senders get false.
+     */
+    template<typename T>
+    class Channel : public ChannelBase{
+    private:
+        struct SendAwaiter;
+        struct ReceiveAwaiter;
+
+        Executor& executor;
+        std::size_t capacity;
+        std::size_t producers;
+
+        std::mutex mutex;
+        std::deque<T> buffer;
+        std::deque<SendAwaiter*> senders; /**< suspended senders, oldest first. */
+        std::deque<ReceiveAwaiter*> receivers; /**< suspended receivers, oldest first (only while buffer is empty). */
+        bool closed = false;
+
+        struct SendAwaiter{
+            Channel& channel;
+            T value;
+            bool accepted = true;
+            std::coroutine_handle<> handle;
+
+            bool await_ready() const noexcept { return false; }
+
+            bool await_suspend(std::coroutine_handle<> handle){
+                std::coroutine_handle<> wake;
+                {
+                    std::lock_guard<std::mutex> lock(channel.mutex);
+                    if (channel.closed){
+                        accepted = false;
+                        return false;
+                    }
+                    if (!channel.receivers.empty()){
+                        ReceiveAwaiter* receiver = channel.receivers.front();
+                        channel.receivers.pop_front();
+                        receiver->value.emplace(std::move(value));
+                        wake = receiver->handle;
+                    } else if (channel.buffer.size() < channel.capacity){
+                        channel.buffer.push_back(std::move(value));
+                        return false;
+                    } else {
+                        this->handle = handle;
+                        channel.senders.push_back(this);
+                        channel.executor.suspended();
+                        return true; // may be resumed by another thread as soon as the lock is released
+                    }
+                }
+                channel.executor.schedule(wake);
+                return false;
+            }
+
+            bool await_resume() const noexcept { return accepted; }
+        };
+
+        struct ReceiveAwaiter{
+            Channel& channel;
+            std::optional<T> value;
+            std::coroutine_handle<> handle;
+
+            bool await_ready() const noexcept { return false; }
+
+            bool await_suspend(std::coroutine_handle<> handle){
+                std::coroutine_handle<> wake;
+                {
+                    std::lock_guard<std::mutex> lock(channel.mutex);
+                    if (!channel.buffer.empty()){
+                        value.emplace(std::move(channel.buffer.front()));
+                        channel.buffer.pop_front();
+                        if (channel.senders.empty()) return false;
+                        SendAwaiter* sender = channel.senders.front(); // its item takes the freed slot
+                        channel.senders.pop_front();
+                        channel.buffer.push_back(std::move(sender->value));
+                        wake = sender->handle;
+                    } else if (!channel.senders.empty()){
+                        SendAwaiter* sender = channel.senders.front(); // rendezvous when the capacity is 0
+                        channel.senders.pop_front();
+                        value.emplace(std::move(sender->value));
+                        wake = sender->handle;
+                    } else if (channel.closed){
+                        return false;
+                    } else {
+                        this->handle = handle;
+                        channel.receivers.push_back(this);
+                        channel.executor.suspended();
+                        return true;
+                    }
+                }
+                channel.executor.schedule(wake);
+                return false;
+            }
+
+            std::optional<T> await_resume(){ return std::move(value); }
+        };
+
+    public:
+        /**
+         * @brief Constructor of an empty channel.
+         * @param executor Executor resuming the coroutines suspended on the channel.
+         * @param capacity Number of items the channel holds before senders suspend.
+         * @param producers Number of calls to done() that close the channel.
+         */
+        Channel(Executor& executor, std::size_t capacity, std::size_t producers = 1) :
+        executor(executor), capacity(capacity), producers(producers){}
+
+        Channel(const Channel&) = delete;
+        Channel& operator=(const Channel&) = delete;
+
+        /**
+         * @brief Sends an item: co_await channel.send(item) suspends while the channel is full.
+         * @param value Item to send.
+         * @return Awaitable giving true if the item was queued, false if the channel was closed.
+         */
+        [[nodiscard]] SendAwaiter send(T value){
+            return SendAwaiter{*this, std::move(value), true, {}};
+        }
+
+        /**
+         * @brief Receives an item: co_await channel.receive() suspends while the channel is empty.
+         * @return Awaitable giving the oldest item, or std::nullopt once the channel is closed and drained.
+         */
+        [[nodiscard]] ReceiveAwaiter receive(){
+            return ReceiveAwaiter{*this, std::nullopt, {}};
+        }
+
+        /**
+         * @brief Signals that one producer has finished; the channel closes after the last one.
+         */
+        void done(){
+            bool last;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                last = producers > 0 && --producers == 0;
+            }
+            if (last) close();
+        }
+
+        /**
+         * @brief Closes the channel: waiting receivers get std::nullopt and waiting senders get false.
+         */
+        void close() override {
+            std::deque<SendAwaiter*> refused;
+            std::deque<ReceiveAwaiter*> drained;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (closed) return;
+                closed = true;
+                refused.swap(senders);
+                drained.swap(receivers);
+            }
+            for(SendAwaiter* sender : refused){
+                sender->accepted = false;
+                executor.schedule(sender->handle);
+            }
+            for(ReceiveAwaiter* receiver : drained){
+                executor.schedule(receiver->handle);
+            }
+        }
+
+        /** @brief Number of items currently queued. */
+        std::size_t size(){
+            std::lock_guard<std::mutex> lock(mutex);
+            return buffer.size();
+        }
+    };
+
+    /**
+     * @struct StageStats
+     * @brief Counters of one stage of a Pipeline, filled by the stage while it runs.
+     */
+    struct StageStats{
+        std::string name;
+        std::uint64_t items = 0; /**< items the stage handled. */
+        std::uint64_t rejected = 0; /**< items the stage dropped. */
+        double seconds = 0; /**< time from the start of the pipeline to the end of the stage. */
+
+        /** @brief Counts handled items. */
+        void add(std::uint64_t n = 1){ items += n; }
+        /** @brief Counts dropped items. */
+        void reject(std::uint64_t n = 1){ rejected += n; }
+
+        /** @brief Items handled per second, 0 before the stage finished. */
+        double itemsPerSecond() const { return seconds > 0 ? static_cast<double>(items) / seconds : 0.0; }
+
+        friend std::ostream& operator<<(std::ostream& os, const StageStats& stats){
+            os << std::left << std::setw(12) << stats.name << std::right << std::setw(12) << stats.items << " items";
+            if (stats.rejected > 0) os << " (" << stats.rejected << " rejected)";
+            os << std::fixed << std::setprecision(3) << "  " << stats.seconds * 1e3 << " ms  "
+               << std::setprecision(0) << stats.itemsPerSecond() << " items/s" << std::defaultfloat;
+            return os;
+        }
+    };
+
+    class Pipeline;
+
+    /**
+     * @class StageTask
+     * @brief Coroutine of one stage of a Pipeline; it starts when the pipeline runs and frees itself when it ends.
+     */
+    class StageTask{
+    public:
+        struct promise_type{
+            Pipeline* pipeline = nullptr;
+            std::size_t index = 0;
+
+            StageTask get_return_object(){ return StageTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+            std::suspend_always initial_suspend() noexcept { return {}; }
+
+            struct FinalAwaiter{
+                bool await_ready() const noexcept { return false; }
+                void await_suspend(std::coroutine_handle<promise_type> handle) noexcept;
+                void await_resume() const noexcept {}
+            };
+            FinalAwaiter final_suspend() noexcept { return {}; }
+
+            void return_void(){}
+            void unhandled_exception();
+        };
+
+    private:
+        std::coroutine_handle<promise_type> handle;
+
+        explicit StageTask(std::coroutine_handle<promise_type> handle) : handle(handle){}
+
+        friend class Pipeline;
+
+    public:
+        StageTask(StageTask&& other) noexcept : handle(std::exchange(other.handle, nullptr)){}
+        StageTask& operator=(StageTask&& other) noexcept {
+            if (this != &other){
+                if (handle) handle.destroy();
+                handle = std::exchange(other.handle, nullptr);
+            }
+            return *this;
+        }
+        StageTask(const StageTask&) = delete;
+        StageTask& operator=(const StageTask&) = delete;
+
+        // Only a stage that never started is still owned here; a started one destroys itself when it ends
+        ~StageTask(){
+            if (handle) handle.destroy();
+        }
+    };
+
+    /**
+     * @class Pipeline
+     * @brief Runs coroutine stages concurrently on a ThreadPool, connected by bounded Channel objects.
+     *
+     * Instead of one full pass over memory per step, every stage handles an item as soon as the previous stage
+     * sent it, and the channel bounds stop a fast stage from filling memory ahead of a slow one. A stage is a
+     * coroutine returning StageTask that receives from its input channels, sends to its output channels, counts
+     * its items in the StageStats it is given and calls done() on its outputs when it ends. A stage added
+     * several times runs as parallel workers; give its output channel that many producers.
+     *
+     * With a pool of 0 workers everything runs on the thread calling run(). If a stage throws, every channel is
+     * closed so the other stages end, and run() rethrows the first exception. The same happens when every stage
+     * left waits on a channel nobody closes, and run() then throws std::logic_error. A pipeline runs once.
+     */
+    class Pipeline : public Executor{
+    private:
+        struct Stage{
+            StageStats stats;
+            StageTask task;
+        };
+
+        ThreadPool& pool;
+        std::vector<std::unique_ptr<ChannelBase>> channels;
+        std::deque<Stage> stages; /**< stable addresses, the stats are referenced by the coroutines. */
+
+        std::mutex mutex;
+        std::condition_variable finished;
+        std::deque<std::coroutine_handle<>> ready; /**< coroutines to resume when the pool has no worker. */
+        std::size_t running = 0;
+        std::size_t waiting = 0; /**< stages suspended on a channel, not yet scheduled again. */
+        std::exception_ptr error;
+        bool started = false; /**< run() was called: the stages were handed to the pool and cannot run again. */
+        std::chrono::steady_clock::time_point start;
+
+        friend struct StageTask::promise_type;
+
+        void stageFinished(std::size_t index){
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            std::lock_guard<std::mutex> lock(mutex);
+            stages[index].stats.seconds = seconds;
+            if (--running == 0 || running == waiting) finished.notify_all();
+        }
+
+        void enqueue(std::coroutine_handle<> handle){
+            if (pool.size() == 0){
+                std::lock_guard<std::mutex> lock(mutex);
+                ready.push_back(handle);
+                return;
+            }
+            pool.submit([handle]{ handle.resume(); });
+        }
+
+        void fail(std::exception_ptr exception){
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error) error = exception;
+            }
+            for(auto& channel : channels) channel->close();
+        }
+
+    public:
+        /**
+         * @brief Constructor of an empty pipeline.
+         * @param pool Pool whose workers run the stages.
+         */
+        explicit Pipeline(ThreadPool& pool = ThreadPool::global()) : pool(pool){}
+
+        Pipeline(const Pipeline&) = delete;
+        Pipeline& operator=(const Pipeline&) = delete;
+
+        /**
+         * @brief Creates a channel owned by the pipeline.
+         * @param capacity Number of items the channel holds before senders suspend.
+         * @param producers Number of stages sending to the channel.
+         * @return Reference to the channel, valid as long as the pipeline.
+         */
+        template<typename T>
+        Channel<T>& channel(std::size_t capacity, std::size_t producers = 1){
+            auto created = std::make_unique<Channel<T>>(*this, capacity, producers);
+            Channel<T>& result = *created;
+            channels.push_back(std::move(created));
+            return result;
+        }
+
+        /**
+         * @brief Adds a stage.
+         * @param name Name of the stage in the report.
+         * @param make Callable taking a StageStats& and returning the StageTask of the stage.
+         * @throws std::logic_error if the pipeline already ran.
+         */
+        template<typename F>
+        void add(std::string name, F&& make){
+            if (started) throw std::logic_error("Pipeline::add: the pipeline already ran");
+            // The stats must have their final address before make() runs, so the stage is built in a spare slot
+            // and only kept once make() returned
+            Stage& stage = stages.emplace_back(Stage{StageStats{std::move(name)}, StageTask(nullptr)});
+            try {
+                stage.task = std::forward<F>(make)(stage.stats);
+            } catch (...) {
+                stages.pop_back();
+                throw;
+            }
+            stage.task.handle.promise().pipeline = this;
+            stage.task.handle.promise().index = stages.size() - 1;
+        }
+
+        /**
+         * @brief Queues a stage suspended on a channel to be resumed on the pool.
+         * @param handle Coroutine to resume.
+         */
+        void schedule(std::coroutine_handle<> handle) override {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                waiting--;
+            }
+            enqueue(handle);
+        }
+
+        /** @brief Counts a stage suspended on a channel. */
+        void suspended() override {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (++waiting == running) finished.notify_all();
+        }
+
+        /**
+         * @brief Starts every stage and waits until all of them ended.
+         * @return Counters and throughput of each stage, in the order they were added.
+         * @throws The first exception thrown by a stage.
+         * @throws std::logic_error if the pipeline already ran: its stages ended and cannot be started again.
+         */
+        std::vector<StageStats> run(){
+            if (started) throw std::logic_error("Pipeline::run: the pipeline already ran");
+            started = true;
+            start = std::chrono::steady_clock::now();
+            running = stages.size();
+            waiting = 0;
+            for(Stage& stage : stages){
+                enqueue(std::exchange(stage.task.handle, nullptr));
+            }
+            bool stalled = false;
+            std::unique_lock<std::mutex> lock(mutex);
+            while(running > 0){
+                if (running == waiting && !stalled){
+                    // Every stage left waits on a channel nobody closes: closing them all lets the stages end
+                    // and free their frames before run() reports it
+                    stalled = true;
+                    lock.unlock();
+                    fail(std::make_exception_ptr(
+                        std::logic_error("Pipeline::run: stages are waiting on channels nobody closes")));
+                    lock.lock();
+                } else if (!ready.empty()){
+                    std::coroutine_handle<> handle = ready.front();
+                    ready.pop_front();
+                    lock.unlock();
+                    handle.resume();
+                    lock.lock();
+                } else if (pool.size() > 0){
+                    lock.unlock();
+                    bool helped = pool.runPendingTask();
+                    lock.lock();
+                    if (!helped){
+                        finished.wait_for(lock, std::chrono::milliseconds(1),
+                                          [this, stalled]{ return running == 0 || (running == waiting && !stalled); });
+                    }
+                } else {
+                    // Unreachable: inline, a stage is either ready or waiting, and closed channels never suspend
+                    break;
+                }
+            }
+            if (error) std::rethrow_exception(std::exchange(error, nullptr));
+
+            std::vector<StageStats> report;
+            for(const Stage& stage : stages) report.push_back(stage.stats);
+            return report;
+        }
+    };
+
+    inline void StageTask::promise_type::FinalAwaiter::await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+        Pipeline* pipeline = handle.promise().pipeline;
+        std::size_t index = handle.promise().index;
+        handle.destroy();
+        pipeline->stageFinished(index);
+    }
+
+    inline void StageTask::promise_type::unhandled_exception(){
+        pipeline->fail(std::current_exception());
+    }
+
+    /**
+     * @struct StudentRecord
+     * @brief Name, age and grade of a student that was not validated yet.
+     */
+    struct StudentRecord{
+        std::string name;
+        int age = 0;
+        double grade = 0;
+    };
+
+    /**
+     * @struct GradeSummary
+     * @brief Grade statistics gathered by stages::aggregate().
+     */
+    struct GradeSummary{
+        std::uint64_t count = 0;
+        double sum = 0;
+        double min = std::numeric_limits<double>::infinity();
+        double max = -std::numeric_limits<double>::infinity();
+        std::uint64_t enrollments = 0; /**< total number of courses of the students. */
+
+        /** @brief Mean grade, 0 if no student was counted. */
+        double mean() const { return count > 0 ? sum / static_cast<double>(count) : 0.0; }
+    };
+
+    /**
+     * @brief Built-in stages wrapping the Random and Student APIs.
+     *
+     * Each one is a coroutine taking its channels and the StageStats given by Pipeline::add(); the arguments
+     * passed by reference must outlive Pipeline::run().
+     */
+    namespace stages{
+
+        /**
+         * @brief Source sending n random records, drawn like generateStudents() in blocks seeded from (seed, block).
+         * @param out Channel the records are sent to; done() is called at the end.
+         * @param n Number of records.
+         * @param seed Seed of the population.
+         * @param stats Counters of the stage.
+         */
+        inline StageTask generate(Channel<StudentRecord>& out, std::size_t n, std::uint64_t seed, StageStats& stats){
+            for(std::size_t block = 0; block * studentBlockSize < n; block++){
+                Random random(studentBlockSeed(seed, block));
+                std::size_t end = std::min(n, (block + 1) * studentBlockSize);
+                for(std::size_t i = block * studentBlockSize; i < end; i++){
+                    Student::RandomInfo info = Student::drawInfo(random);
+                    StudentRecord record{std::string(StringInterner::global().view(info.nameId)), info.age, info.grade};
+                    if (!co_await out.send(std::move(record))) co_return;
+                    stats.add();
+                }
+            }
+            out.done();
+        }
+
+        /**
+         * @brief Source sending a copy of every element of a range, e.g. records loaded from a file.
+         * @param out Channel the elements are sent to; done() is called at the end.
+         * @param items Range of elements convertible to T.
+         * @param stats Counters of the stage.
+         */
+        template<typename T, typename Range>
+        StageTask fromRange(Channel<T>& out, const Range& items, StageStats& stats){
+            for(const auto& item : items){
+                if (!co_await out.send(T(item))) co_return;
+                stats.add();
+            }
+            out.done();
+        }
+
+        /**
+         * @brief Turns records into students, dropping those Student::setName/setAge/setGrade would refuse.
+         * @param in Channel of records.
+         * @param out Channel the valid students are sent to; done() is called at the end.
+         * @param stats Counters of the stage; dropped records are counted as rejected.
+         */
+        inline StageTask validate(Channel<StudentRecord>& in, Channel<Student>& out, StageStats& stats){
+            while(std::optional<StudentRecord> record = co_await in.receive()){
+                if (!Student::isValidName(record->name) || !Student::isValidAge(record->age)
+                    || !Student::isValidGrade(record->grade)){
+                    stats.reject();
+                    continue;
+                }
+                if (!co_await out.send(Student(record->name, record->age, record->grade))) co_return;
+                stats.add();
+            }
+            out.done();
+        }
+
+        /**
+         * @brief Enrolls every student in coursesPerStudent courses drawn at random from courses.
+         * @param in Channel of students.
+         * @param out Channel the enrolled students are sent to; done() is called at the end.
+         * @param courses IDs in CourseCatalog::global() to draw from (nothing is drawn if empty).
+         * @param coursesPerStudent Number of courses per student.
+         * @param seed Seed of the draws.
+         * @param stats Counters of the stage.
+         */
+        inline StageTask enroll(Channel<Student>& in, Channel<Student>& out, std::span<const CourseCatalog::Id> courses,
+                                std::size_t coursesPerStudent, std::uint64_t seed, StageStats& stats){
+            Random random(seed);
+            while(std::optional<Student> student = co_await in.receive()){
+                for(std::size_t i = 0; i < coursesPerStudent && !courses.empty(); i++){
+                    student->enroll(courses[random.getInt(0, static_cast<int>(courses.size()) - 1)]);
+                }
+                if (!co_await out.send(std::move(*student))) co_return;
+                stats.add();
+            }
+            out.done();
+        }
+
+        /**
+         * @brief Sink adding the grades and enrollments of every student to summary.
+         * @param in Channel of students.
+         * @param summary Statistics to update; only read it after Pipeline::run() returned.
+         * @param stats Counters of the stage.
+         */
+        inline StageTask aggregate(Channel<Student>& in, GradeSummary& summary, StageStats& stats){
+            while(std::optional<Student> student = co_await in.receive()){
+                double grade = student->getGrade();
+                summary.count++;
+                summary.sum += grade;
+                summary.min = std::min(summary.min, grade);
+                summary.max = std::max(summary.max, grade);
+                summary.enrollments += student->getCourseIds().size();
+                stats.add();
+            }
+        }
+
+    }
+
+}
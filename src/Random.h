@@ -0,0 +1,164 @@
+/**
+ * @file Random.h
+ * @brief Declaration of the Random class used to generate random students, and of its Xoshiro256 engine.
+ */
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <span>
+
+namespace oop{
+
+    /**
+     * @brief SplitMix64 step: turns consecutive seeds into well-mixed 64-bit values.
+     * @param state Seed, advanced by the call.
+     * @return The next output of the sequence.
+     */
+    inline std::uint64_t splitMix64(std::uint64_t& state){
+        std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    /**
+     * @class Xoshiro256
+     * @brief The xoshiro256** engine: 32 bytes of state, a few cycles per 64-bit output.
+     *
+     * Satisfies UniformRandomBitGenerator, so it can also drive the std distributions.
+     */
+    class Xoshiro256{
+        std::uint64_t state[4];
+
+        static std::uint64_t rotl(std::uint64_t x, int k){
+            return (x << k) | (x >> (64 - k));
+        }
+
+    public:
+        using result_type = std::uint64_t;
+
+        /**
+         * @brief Constructor that expands a 64-bit seed into the state with SplitMix64.
+         * @param seed Seed of the sequence; equal seeds give equal sequences.
+         */
+        explicit Xoshiro256(std::uint64_t seed = 0){
+            for(std::uint64_t& word : state){
+                word = splitMix64(seed);
+            }
+        }
+
+        static constexpr result_type min(){ return 0; }
+        static constexpr result_type max(){ return std::numeric_limits<result_type>::max(); }
+
+        /**
+         * @brief Returns the next 64 random bits.
+         */
+        result_type operator()(){
+            std::uint64_t result = rotl(state[1] * 5, 7) * 9;
+            std::uint64_t t = state[1] << 17;
+            state[2] ^= state[0];
+            state[3] ^= state[1];
+            state[1] ^= state[2];
+            state[0] ^= state[3];
+            state[2] ^= t;
+            state[3] = rotl(state[3], 45);
+            return result;
+        }
+    };
+
+    /**
+     * @class Random
+     * @brief A class that generates random numbers.
+     *
+     * A default-constructed Random is seeded from an engine kept per thread, which reads std::random_device
+     * once when the thread first needs it, so creating a Random costs a few multiplications. Give a seed to
+     * get a reproducible sequence.
+     */
+    class Random{
+        Xoshiro256 rng; //random number generator
+
+        // Engine of the calling thread, used only to seed default-constructed generators
+        static Xoshiro256& threadEngine(){
+            thread_local Xoshiro256 engine([]{
+                std::random_device rd;
+                return (std::uint64_t{rd()} << 32) | rd();
+            }());
+            return engine;
+        }
+
+    public:
+
+        /**
+         * @brief Constructor that initializes the random number generator.
+         */
+        Random() : rng(threadEngine()()) {}
+
+        /**
+         * @brief Constructor that initializes the random number generator with a fixed seed.
+         * @param seed Seed of the sequence.
+         */
+        explicit Random(std::uint64_t seed) : rng(seed) {}
+
+        /**
+         * @brief Method to generate random integer between first and last.
+         * @param first The first number of the range.
+         * @param last The last number of the range.
+         * @return Random integer between first and last.
+         */
+        int getInt(int first, int last){
+            // Lemire's multiply-shift: an unbiased value in [0, range) without a division in the common case
+            std::uint64_t range = static_cast<std::uint64_t>(static_cast<std::int64_t>(last) - first) + 1;
+            std::uint64_t x = rng() >> 32;
+            std::uint64_t m = x * range;
+            std::uint32_t low = static_cast<std::uint32_t>(m);
+            if (low < range){
+                std::uint32_t threshold = static_cast<std::uint32_t>((std::uint64_t{1} << 32) % range);
+                while(low < threshold){
+                    x = rng() >> 32;
+                    m = x * range;
+                    low = static_cast<std::uint32_t>(m);
+                }
+            }
+            return static_cast<int>(static_cast<std::int64_t>(first) + static_cast<std::int64_t>(m >> 32));
+        }
+
+        /**
+         * @brief Method to generate random double between first and last.
+         * @param first The first number of the range.
+         * @param last The last number of the range.
+         * @return Random double between first and last.
+         */
+        double getDouble(double first, double last){
+            double unit = static_cast<double>(rng() >> 11) * 0x1.0p-53; // uniform in [0, 1)
+            return first + unit * (last - first);
+        }
+
+        /**
+         * @brief Method to fill a buffer with random integers between first and last.
+         * @param out Buffer to be filled (a DynamicArray<int> converts to it).
+         * @param first The first number of the range.
+         * @param last The last number of the range.
+         */
+        void fillInts(std::span<int> out, int first, int last){
+            for(int& value : out){
+                value = getInt(first, last);
+            }
+        }
+
+        /**
+         * @brief Method to fill a buffer with random doubles between first and last.
+         * @param out Buffer to be filled (a DynamicArray<double> converts to it).
+         * @param first The first number of the range.
+         * @param last The last number of the range.
+         */
+        void fillDoubles(std::span<double> out, double first, double last){
+            double scale = (last - first) * 0x1.0p-53;
+            for(double& value : out){
+                value = first + static_cast<double>(rng() >> 11) * scale;
+            }
+        }
+    };
+
+}
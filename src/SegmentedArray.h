@@ -0,0 +1,453 @@
+/**
+ * @file SegmentedArray.h
+ * @brief Declaration of the SegmentedArray class, a growable array made of fixed-size chunks.
+ */
+#pragma once
+
+#include "AlignedAllocator.h"
+#include "ArrayExpression.h"
+#include "DynamicArray.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace oop{
+
+    /**
+     * @brief Default number of elements per chunk of a SegmentedArray: the power of two closest below 16 KiB of elements.
+     */
+    template<typename T>
+    inline constexpr std::size_t defaultChunkSize = std::bit_floor(std::max<std::size_t>(1, 16384 / sizeof(T)));
+
+    /**
+     * @class SegmentedArray
+     * @brief A growable array that adds fixed-size chunks instead of reallocating one buffer.
+     * @tparam T Type of the elements stored in the array.
+     * @tparam ChunkSize Number of elements per chunk; a power of two turns indexing into a shift and a mask.
+     * @tparam Alloc Allocator of the chunks (64-byte aligned by default).
+     *
+     * Appending never moves the elements already stored: each new chunk is allocated next to the others and
+     * only the small table of chunk pointers grows. There is no copy of the whole array while it grows, so
+     * peak memory stays at the size of the data plus one chunk, and references, pointers and iterators to
+     * elements stay valid across push_back(). Use flatten() when a contiguous DynamicArray is needed.
+     */
+    template<typename T, std::size_t ChunkSize = defaultChunkSize<T>, typename Alloc = AlignedAllocator<T>>
+    class SegmentedArray{
+        static_assert(ChunkSize > 0, "chunks must hold at least one element");
+
+    public:
+        using value_type = T;
+        using allocator_type = Alloc;
+        using size_type = std::size_t;
+        using reference = T&;
+        using const_reference = const T&;
+
+        /** @brief Number of elements per chunk. */
+        static constexpr size_type chunkSize = ChunkSize;
+
+    private:
+        using AllocTraits = std::allocator_traits<Alloc>;
+
+        static constexpr bool powerOfTwo = std::has_single_bit(ChunkSize);
+        static constexpr int chunkShift = std::countr_zero(ChunkSize);
+
+        [[no_unique_address]] Alloc alloc; /**< allocator of the chunks. */
+        std::vector<T*> chunks; /**< allocated chunks, full except the one holding the last element. */
+        size_type arrSize = 0; /**< number of elements. */
+
+        static size_type chunkOf(size_type index){
+            if constexpr (powerOfTwo) return index >> chunkShift;
+            else return index / ChunkSize;
+        }
+
+        static size_type offsetOf(size_type index){
+            if constexpr (powerOfTwo) return index & (ChunkSize - 1);
+            else return index % ChunkSize;
+        }
+
+        // Makes sure a chunk exists for the element at index
+        void ensureChunkFor(size_type index){
+            if (chunkOf(index) < chunks.size()) return;
+            T* chunk = AllocTraits::allocate(alloc, ChunkSize);
+            try {
+                chunks.push_back(chunk);
+            } catch (...) {
+                AllocTraits::deallocate(alloc, chunk, ChunkSize);
+                throw;
+            }
+        }
+
+        // Destroys the elements in [first, size())
+        void destroyFrom(size_type first){
+            if constexpr (!std::is_trivially_destructible_v<T>){
+                for(size_type i = first; i < arrSize; i++){
+                    AllocTraits::destroy(alloc, &(*this)[i]);
+                }
+            }
+            arrSize = first;
+        }
+
+        // Gives back the chunks past the one holding the last element
+        void freeChunksFrom(size_type firstUnused){
+            while(chunks.size() > firstUnused){
+                AllocTraits::deallocate(alloc, chunks.back(), ChunkSize);
+                chunks.pop_back();
+            }
+        }
+
+        template<typename InputIt>
+        void appendRange(InputIt first, InputIt last){
+            for(; first != last; ++first){
+                emplace_back(*first);
+            }
+        }
+
+        // Runs the body of a constructor, freeing what it built if it throws (the destructor would not run)
+        template<typename F>
+        void construct(F&& fill){
+            try {
+                fill();
+            } catch (...) {
+                destroyFrom(0);
+                freeChunksFrom(0);
+                throw;
+            }
+        }
+
+    public:
+        /**
+         * @class Iterator
+         * @brief Random access iterator; it stays valid when elements are appended to the array.
+         */
+        template<bool Const>
+        class Iterator{
+            using Table = std::conditional_t<Const, const std::vector<T*>*, std::vector<T*>*>;
+
+            Table table = nullptr;
+            size_type index = 0;
+
+            friend class SegmentedArray;
+            template<bool> friend class Iterator;
+
+        public:
+            using iterator_concept = std::random_access_iterator_tag;
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = std::conditional_t<Const, const T*, T*>;
+            using reference = std::conditional_t<Const, const T&, T&>;
+
+            Iterator() = default;
+            Iterator(Table table, size_type index) : table(table), index(index){}
+
+            /** @brief A mutable iterator converts to a const one. */
+            template<bool OtherConst>
+                requires (Const && !OtherConst)
+            Iterator(const Iterator<OtherConst>& other) : table(other.table), index(other.index){}
+
+            reference operator*() const { return (*table)[chunkOf(index)][offsetOf(index)]; }
+            pointer operator->() const { return &**this; }
+            reference operator[](difference_type n) const { return *(*this + n); }
+            Iterator& operator++(){ ++index; return *this; }
+            Iterator operator++(int){ Iterator old = *this; ++index; return old; }
+            Iterator& operator--(){ --index; return *this; }
+            Iterator operator--(int){ Iterator old = *this; --index; return old; }
+            Iterator& operator+=(difference_type n){ index += n; return *this; }
+            Iterator& operator-=(difference_type n){ index -= n; return *this; }
+            friend Iterator operator+(Iterator it, difference_type n){ return it += n; }
+            friend Iterator operator+(difference_type n, Iterator it){ return it += n; }
+            friend Iterator operator-(Iterator it, difference_type n){ return it -= n; }
+            friend difference_type operator-(const Iterator& a, const Iterator& b){
+                return static_cast<difference_type>(a.index) - static_cast<difference_type>(b.index);
+            }
+            bool operator==(const Iterator& other) const { return index == other.index; }
+            auto operator<=>(const Iterator& other) const { return index <=> other.index; }
+        };
+
+        using iterator = Iterator<false>;
+        using const_iterator = Iterator<true>;
+
+        /**
+         * @brief Default constructor of an empty array (no chunk is allocated).
+         */
+        SegmentedArray() = default;
+
+        /**
+         * @brief Constructor of an empty array that uses the given allocator.
+         * @param allocator Allocator of the chunks.
+         */
+        explicit SegmentedArray(const Alloc& allocator) : alloc(allocator){}
+
+        /**
+         * @brief Constructor of an array of size copies of value.
+         * @param size Number of elements.
+         * @param value Value of every element.
+         * @param allocator Allocator of the chunks.
+         */
+        SegmentedArray(size_type size, const T& value, const Alloc& allocator = Alloc()) : alloc(allocator){
+            construct([&]{
+                reserve(size);
+                for(size_type i = 0; i < size; i++) emplace_back(value);
+            });
+        }
+
+        /**
+         * @brief Constructor from a list of values.
+         * @param values Elements of the array.
+         * @param allocator Allocator of the chunks.
+         */
+        SegmentedArray(std::initializer_list<T> values, const Alloc& allocator = Alloc()) : alloc(allocator){
+            construct([&]{
+                reserve(values.size());
+                appendRange(values.begin(), values.end());
+            });
+        }
+
+        /**
+         * @brief Constructor that materializes a concatenation (SegmentedArray<int> c = a + b;)
+         * @param expr Lazy concatenation returned by operator+
+         */
+        template<LazyArrayExpression E>
+            requires std::is_same_v<typename E::value_type, T>
+        SegmentedArray(const E& expr, const Alloc& allocator = Alloc()) : alloc(allocator){
+            construct([&]{
+                reserve(expr.size());
+                expr.forEachSegment([this](const T* first, const T* last){
+                    appendRange(first, last);
+                });
+            });
+        }
+
+        /**
+         * @brief Copy constructor: allocates the chunks the elements need and copies them.
+         * @param other Array to be copied.
+         */
+        SegmentedArray(const SegmentedArray& other) : alloc(AllocTraits::select_on_container_copy_construction(other.alloc)){
+            construct([&]{
+                reserve(other.arrSize);
+                other.forEachSegment([this](const T* first, const T* last){
+                    appendRange(first, last);
+                });
+            });
+        }
+
+        /**
+         * @brief Move constructor: takes over the chunk table.
+         * @param other Array to be moved, left empty.
+         */
+        SegmentedArray(SegmentedArray&& other) noexcept
+            : alloc(std::move(other.alloc)), chunks(std::move(other.chunks)), arrSize(std::exchange(other.arrSize, 0)){
+            other.chunks.clear();
+        }
+
+        /**
+         * @brief Copy assignment.
+         * @param other Array to be copied.
+         * @return Reference to this array.
+         */
+        SegmentedArray& operator=(const SegmentedArray& other){
+            if (this != &other){
+                SegmentedArray copy(other);
+                swap(copy);
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Move assignment.
+         * @param other Array to be moved, left empty.
+         * @return Reference to this array.
+         */
+        SegmentedArray& operator=(SegmentedArray&& other) noexcept {
+            if (this != &other){
+                SegmentedArray moved(std::move(other));
+                swap(moved);
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Destructor that destroys the elements and frees the chunks.
+         */
+        ~SegmentedArray(){
+            destroyFrom(0);
+            freeChunksFrom(0);
+        }
+
+        /**
+         * @brief Exchanges the contents of two arrays.
+         * @param other Array to exchange with.
+         */
+        void swap(SegmentedArray& other) noexcept {
+            using std::swap;
+            swap(alloc, other.alloc);
+            chunks.swap(other.chunks);
+            swap(arrSize, other.arrSize);
+        }
+
+        /**
+         * @brief Returns the number of elements.
+         * @return The size of the array.
+         */
+        size_type size() const { return arrSize; }
+
+        /**
+         * @brief Returns the number of elements that fit in the allocated chunks.
+         * @return The capacity of the array.
+         */
+        size_type capacity() const { return chunks.size() * ChunkSize; }
+
+        /**
+         * @brief Checks whether the array has no elements.
+         * @return True if the size of the array is 0.
+         */
+        bool empty() const { return arrSize == 0; }
+
+        /**
+         * @brief Access to the element at index.
+         * @param index Index of the element (not checked).
+         * @return Reference to the element; it stays valid when elements are appended.
+         */
+        T& operator[](size_type index){ return chunks[chunkOf(index)][offsetOf(index)]; }
+
+        /**
+         * @brief Read access to the element at index.
+         * @param index Index of the element (not checked).
+         * @return Const reference to the element.
+         */
+        const T& operator[](size_type index) const { return chunks[chunkOf(index)][offsetOf(index)]; }
+
+        /**
+         * @brief Checked access to the element at index.
+         * @param index Index of the element.
+         * @return Reference to the element.
+         * @throws std::out_of_range if index is not smaller than size().
+         */
+        T& at(size_type index){
+            if (index >= arrSize) throw std::out_of_range("SegmentedArray::at: index out of range");
+            return (*this)[index];
+        }
+
+        /** @brief Iterator to the first element. */
+        iterator begin(){ return iterator(&chunks, 0); }
+        /** @brief Iterator past the last element. */
+        iterator end(){ return iterator(&chunks, arrSize); }
+        /** @brief Const iterator to the first element. */
+        const_iterator begin() const { return const_iterator(&chunks, 0); }
+        /** @brief Const iterator past the last element. */
+        const_iterator end() const { return const_iterator(&chunks, arrSize); }
+
+        /**
+         * @brief Allocates the chunks needed to hold newCapacity elements.
+         * @param newCapacity Minimum capacity of the array.
+         */
+        void reserve(size_type newCapacity){
+            if (newCapacity == 0) return;
+            size_type needed = chunkOf(newCapacity - 1) + 1;
+            chunks.reserve(needed);
+            while(chunks.size() < needed){
+                chunks.push_back(AllocTraits::allocate(alloc, ChunkSize)); // cannot throw after the reserve above
+            }
+        }
+
+        /**
+         * @brief Frees the chunks that hold no element.
+         */
+        void shrink_to_fit(){
+            freeChunksFrom(arrSize == 0 ? 0 : chunkOf(arrSize - 1) + 1);
+            chunks.shrink_to_fit();
+        }
+
+        /**
+         * @brief Constructs a new element at the end of the array, adding a chunk if the last one is full.
+         * @param args Arguments forwarded to the constructor of the element.
+         * @return Reference to the new element.
+         */
+        template<typename... Args>
+        T& emplace_back(Args&&... args){
+            ensureChunkFor(arrSize);
+            T* slot = &(*this)[arrSize];
+            AllocTraits::construct(alloc, slot, std::forward<Args>(args)...);
+            arrSize++;
+            return *slot;
+        }
+
+        /**
+         * @brief Appends a copy of value to the end of the array.
+         * @param value Element to be appended.
+         */
+        void push_back(const T& value){ emplace_back(value); }
+
+        /**
+         * @brief Appends value to the end of the array by moving it.
+         * @param value Element to be appended.
+         */
+        void push_back(T&& value){ emplace_back(std::move(value)); }
+
+        /**
+         * @brief Removes the last element (the chunks are kept).
+         */
+        void pop_back(){ destroyFrom(arrSize - 1); }
+
+        /**
+         * @brief Removes all the elements (the chunks are kept).
+         */
+        void clear(){ destroyFrom(0); }
+
+        /**
+         * @brief Calls f(first, last) once per chunk holding elements, in order.
+         * @param f Callable taking two const T pointers.
+         */
+        template<typename F>
+        void forEachSegment(F&& f) const {
+            for(size_type begin = 0; begin < arrSize; begin += ChunkSize){
+                const T* chunk = chunks[chunkOf(begin)];
+                f(chunk, chunk + std::min(ChunkSize, arrSize - begin));
+            }
+        }
+
+        /**
+         * @brief Copies the elements into one contiguous array.
+         * @return A DynamicArray holding the elements in order.
+         */
+        DynamicArray<T> flatten() const {
+            DynamicArray<T> flat;
+            flat.reserve(arrSize);
+            forEachSegment([&](const T* first, const T* last){
+                for(; first != last; ++first) flat.push_back(*first);
+            });
+            return flat;
+        }
+
+        /**
+         * @brief Operator overloading on ostream, in the same [a, b, c] form as DynamicArray.
+         * @param os Output stream object.
+         * @param other SegmentedArray to be printed.
+         * @return Output stream object.
+         */
+        friend std::ostream& operator<<(std::ostream& os, const SegmentedArray& other) {
+            os << "[";
+            for(size_type i = 0; i < other.arrSize; i++){
+                os << other[i];
+                if (i != other.arrSize - 1){
+                    os << ", ";
+                }
+            }
+            os << "]";
+            return os;
+        }
+    };
+
+    template<typename T, std::size_t ChunkSize, typename Alloc>
+    inline constexpr bool isConcatOperand<SegmentedArray<T, ChunkSize, Alloc>> = true;
+
+}
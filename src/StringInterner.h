@@ -0,0 +1,151 @@
+/**
+ * @file StringInterner.h
+ * @brief Declaration of the StringInterner class, which stores each distinct string once and names it by a 32-bit ID.
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace oop{
+
+    /**
+     * @class StringInterner
+     * @brief Dictionary that maps strings to dense 32-bit IDs and back.
+     *
+     * Objects that repeat a few distinct strings (such as the names of students) store the ID instead of a
+     * std::string: equality and grouping become integer comparisons and each string is allocated once.
+     * The strings are kept in blocks that never move, so the views returned by view() stay valid as long as
+     * the interner lives. intern() and find() may be called from several threads; view() takes no lock.
+     */
+    class StringInterner{
+    public:
+        using Id = std::uint32_t;
+
+    private:
+        // Block b holds firstBlockSize << b strings, so 27 blocks cover every 32-bit ID
+        static constexpr std::size_t firstBlockSize = 64;
+        static constexpr std::size_t blockCount = 27;
+
+        std::array<std::atomic<std::string*>, blockCount> blocks{}; /**< string storage, allocated on demand. */
+        std::unordered_map<std::string_view, Id> lookup; /**< ID of every stored string. */
+        std::size_t count = 0; /**< number of stored strings (guarded by mutex). */
+        mutable std::shared_mutex mutex; /**< guards lookup and count. */
+
+        static std::size_t blockOf(Id id){
+            return static_cast<std::size_t>(std::bit_width(id / firstBlockSize + 1)) - 1;
+        }
+
+        static std::size_t offsetIn(Id id, std::size_t block){
+            return id - firstBlockSize * ((std::size_t{1} << block) - 1);
+        }
+
+        std::string& slot(Id id) const{
+            std::size_t block = blockOf(id);
+            return blocks[block].load(std::memory_order_acquire)[offsetIn(id, block)];
+        }
+
+    public:
+        StringInterner() = default;
+
+        StringInterner(const StringInterner&) = delete;
+        StringInterner& operator=(const StringInterner&) = delete;
+
+        /**
+         * @brief Destructor that frees the string blocks.
+         */
+        ~StringInterner(){
+            for(auto& block : blocks){
+                delete[] block.load(std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * @brief Interner shared by every Student and, unless given another one, every StudentTable.
+         * @return Reference to the global interner.
+         */
+        static StringInterner& global(){
+            static StringInterner interner;
+            return interner;
+        }
+
+        /**
+         * @brief Returns the ID of text, storing it first if it is new.
+         * @param text String to be interned.
+         * @return The ID of the string, the same for every equal string.
+         * @throws std::length_error if every 32-bit ID is in use.
+         */
+        Id intern(std::string_view text){
+            {
+                std::shared_lock<std::shared_mutex> lock(mutex);
+                auto found = lookup.find(text);
+                if (found != lookup.end()) return found->second;
+            }
+            std::unique_lock<std::shared_mutex> lock(mutex);
+            auto found = lookup.find(text);
+            if (found != lookup.end()) return found->second;
+
+            if (count > std::numeric_limits<Id>::max()){
+                throw std::length_error("StringInterner: out of IDs");
+            }
+            Id id = static_cast<Id>(count);
+            std::size_t block = blockOf(id);
+            if (blocks[block].load(std::memory_order_relaxed) == nullptr){
+                blocks[block].store(new std::string[firstBlockSize << block], std::memory_order_release);
+            }
+            std::string& stored = slot(id);
+            stored.assign(text);
+            try {
+                lookup.emplace(stored, id);
+            } catch (...) {
+                stored.clear();
+                throw;
+            }
+            count++;
+            return id;
+        }
+
+        /**
+         * @brief Looks up text without storing it.
+         * @param text String to be found.
+         * @return Its ID, or no value if it was never interned.
+         */
+        std::optional<Id> find(std::string_view text) const{
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            auto found = lookup.find(text);
+            if (found == lookup.end()) return std::nullopt;
+            return found->second;
+        }
+
+        /**
+         * @brief Returns the string with the given ID.
+         * @param id ID returned by intern().
+         * @return View of the string, valid while the interner lives.
+         */
+        std::string_view view(Id id) const{
+            return slot(id);
+        }
+
+        /**
+         * @brief Returns the number of distinct strings stored.
+         * @return The number of IDs in use.
+         */
+        std::size_t size() const{
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            return count;
+        }
+    };
+
+}
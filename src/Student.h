@@ -0,0 +1,498 @@
+/**
+ * @file Student.h
+ * @brief Declaration of the Student class and its nested Course class.
+ */
+#pragma once
+
+#include "CourseCatalog.h"
+#include "Diagnostics.h"
+#include "EnrollmentIndex.h"
+#include "GradeObserver.h"
+#include "InstanceCounter.h"
+#include "Random.h"
+#include "StringInterner.h"
+
+#include <atomic>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory_resource>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace oop{
+
+    class Student;
+
+    template<>
+    inline constexpr std::string_view instrument::probeName<Student> = "Student";
+
+    /**
+     * @class Student
+     * @brief A class that represents a student.
+     * @param name Name of the student.
+     * @param age Age of the student.
+     * @param grade Grade of the student.
+     *
+     * The name is interned in StringInterner::global(): the student keeps a 32-bit ID, so equal names are
+     * stored once and compared as integers. Enrolled courses are kept as their IDs in CourseCatalog::global();
+     * build an EnrollmentIndex to find the students of a course. The course list takes its memory from the
+     * allocator given at construction, so a std::pmr::vector<Student> built on an ArenaResource keeps it in the arena.
+     * Constructions, copies, moves and destructions are counted by InstanceCounted and reported by instanceStats().
+     *
+     * Creation, grade changes and destruction are reported to the observers of GradeObserverRegistry, which
+     * identify students by getId(). A moved student keeps its ID; a copy is a new student with a new ID.
+     */
+    class Student : public InstanceCounted<Student>{
+    public:
+        /** @brief Allocator of the course list (the default resource if none is given). */
+        using allocator_type = std::pmr::polymorphic_allocator<>;
+
+        /** @brief Identifier of a student, unique in the process. */
+        using Id = std::uint32_t;
+
+        /** @brief Value of the ID of a student that was never asked for it. */
+        static constexpr Id noId = 0;
+
+    private:
+        StringInterner::Id nameId;
+        int age;
+        double grade;
+
+        mutable bool ageAccessed = false;
+
+        mutable std::atomic<Id> id{noId}; // assigned by getId() on first use, so constructing a student touches no shared counter
+
+        friend class StudentTable; // reads the fields directly so converting does not mark the age as accessed
+
+        // In instrumented builds the courses allocate through a resource reporting to Probe<Student>
+        static allocator_type tracked(const allocator_type& alloc){
+            return allocator_type(instrument::trackedResource<Student>(alloc.resource()));
+        }
+
+        // Returns name if the three values are valid, so that nothing is interned for a rejected student
+        static std::string_view validated(std::string_view name, int age, double grade){
+            if (!isValidName(name)) throw std::invalid_argument("Student: empty name");
+            if (!isValidAge(age)) throw std::invalid_argument("Student: age " + std::to_string(age) + " outside [0, 120]");
+            if (!isValidGrade(grade)) throw std::invalid_argument("Student: grade " + std::to_string(grade) + " outside [0, 10]");
+            return name;
+        }
+
+        void generateStudentInfo(){
+            thread_local Random random;
+            draw(random);
+        }
+
+        void draw(Random& random){
+            RandomInfo info = drawInfo(random);
+            nameId = info.nameId;
+            age = info.age;
+            grade = info.grade;
+        }
+
+    public:
+        /**
+         * @brief Number of distinct names given to random students.
+         */
+        static constexpr int randomNameCount = 4;
+
+        /**
+         * @struct RandomInfo
+         * @brief Name, age and grade drawn for a random student.
+         */
+        struct RandomInfo{
+            StringInterner::Id nameId; /**< ID of the name in StringInterner::global(). */
+            int age;
+            double grade;
+        };
+
+        /**
+         * @brief IDs in StringInterner::global() of the names random students are drawn from, interned once.
+         * @return The randomNameCount IDs.
+         */
+        static std::span<const StringInterner::Id, randomNameCount> randomNameIds(){
+            static const StringInterner::Id ids[randomNameCount] = {
+                StringInterner::global().intern("Rodrigo"), StringInterner::global().intern("Ricardo"),
+                StringInterner::global().intern("Andres"), StringInterner::global().intern("Raul")};
+            return ids;
+        }
+
+        /**
+         * @brief Draws the name, age and grade of a random student, in the order Student(Random&) draws them.
+         * @param random Generator to draw from.
+         * @return The values drawn; they are always valid.
+         */
+        static RandomInfo drawInfo(Random& random){
+            StringInterner::Id name = randomNameIds()[random.getInt(0, randomNameCount - 1)];
+            int age = random.getInt(18, 25);
+            return RandomInfo{name, age, random.getDouble(0.0, 10.0)};
+        }
+
+        /** @brief Checks a name: any non-empty string. */
+        static constexpr bool isValidName(std::string_view name){ return !name.empty(); }
+        /** @brief Checks an age: from 0 to 120. */
+        static constexpr bool isValidAge(int age){ return age >= 0 && age <= 120; }
+        /** @brief Checks a grade: from 0 to 10 (NaN is rejected). */
+        static constexpr bool isValidGrade(double grade){ return grade >= 0 && grade <= 10; }
+
+        /**
+         * @brief Default constructor that initializes student with random values.
+         * @param alloc Allocator for the courses.
+         */
+        explicit Student(const allocator_type& alloc = {}) : nameId(0), age(0), grade(0.0f), courses(tracked(alloc)) {
+            generateStudentInfo();
+            GradeObserverRegistry::studentAdded(*this);
+        }
+
+        /**
+         * @brief Constructor that draws the name, age and grade from random, in the same order as randomize().
+         * @param random Generator to draw from; a seeded one gives reproducible students.
+         * @param alloc Allocator for the courses.
+         */
+        explicit Student(Random& random, const allocator_type& alloc = {}) : nameId(0), age(0), grade(0.0), courses(tracked(alloc)) {
+            draw(random);
+            GradeObserverRegistry::studentAdded(*this);
+        }
+
+        /**
+         * @brief Constructor that initializes student with given values.
+         * @param name Name of the student.
+         * @param age Age of the student.
+         * @param grade Grade of the student.
+         * @param alloc Allocator for the courses.
+         * @throws std::invalid_argument if the name is empty, the age is outside [0, 120] or the grade outside [0, 10].
+         */
+        Student(std::string_view name, int age, double grade, const allocator_type& alloc = {}):
+        nameId(StringInterner::global().intern(validated(name, age, grade))), age(age), grade(grade), courses(tracked(alloc)){
+            GradeObserverRegistry::studentAdded(*this);
+        }
+
+        /**
+         * @brief Copy constructor: the copy is a new student with its own ID.
+         * @param other Student to be copied.
+         */
+        Student(const Student& other)
+            : InstanceCounted(other), nameId(other.nameId), age(other.age), grade(other.grade), ageAccessed(other.ageAccessed),
+              courses(other.courses, tracked({})) {
+            GradeObserverRegistry::studentAdded(*this);
+        }
+
+        /**
+         * @brief Copy constructor that places the copy in the memory of alloc (used by std::pmr containers).
+         * @param other Student to be copied.
+         * @param alloc Allocator for the courses of the copy.
+         */
+        Student(const Student& other, const allocator_type& alloc)
+            : InstanceCounted(other), nameId(other.nameId), age(other.age), grade(other.grade), ageAccessed(other.ageAccessed),
+              courses(other.courses, tracked(alloc)) {
+            GradeObserverRegistry::studentAdded(*this);
+        }
+
+        /**
+         * @brief Move constructor: the student keeps its ID, and other is left without one.
+         * Observers see the new object added; other is still removed when it is destroyed.
+         * @param other Student to be moved.
+         */
+        Student(Student&& other) noexcept
+            : InstanceCounted(std::move(other)), nameId(other.nameId), age(other.age), grade(other.grade), ageAccessed(other.ageAccessed),
+              id(other.id.exchange(noId, std::memory_order_relaxed)), courses(std::move(other.courses)) {
+            GradeObserverRegistry::studentAdded(*this);
+        }
+
+        /**
+         * @brief Move constructor that places the student in the memory of alloc (used by std::pmr containers).
+         * @param other Student to be moved.
+         * @param alloc Allocator for the courses.
+         */
+        Student(Student&& other, const allocator_type& alloc)
+            : InstanceCounted(std::move(other)), nameId(other.nameId), age(other.age), grade(other.grade), ageAccessed(other.ageAccessed),
+              id(other.id.exchange(noId, std::memory_order_relaxed)), courses(std::move(other.courses), tracked(alloc)) {
+            GradeObserverRegistry::studentAdded(*this);
+        }
+
+        /**
+         * @brief Copy assignment: the student keeps its ID and takes the values of other.
+         * @param other Student to be copied.
+         * @return Reference to this student.
+         */
+        Student& operator=(const Student& other){
+            if (this != &other){
+                InstanceCounted::operator=(other);
+                double oldGrade = grade;
+                nameId = other.nameId;
+                age = other.age;
+                grade = other.grade;
+                ageAccessed = other.ageAccessed;
+                courses = other.courses;
+                GradeObserverRegistry::gradeChanged(*this, oldGrade, grade);
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Move assignment: this student is removed and replaced by other, ID included.
+         * @param other Student to be moved.
+         * @return Reference to this student.
+         */
+        Student& operator=(Student&& other){
+            if (this != &other){
+                InstanceCounted::operator=(std::move(other));
+                GradeObserverRegistry::studentRemoved(*this);
+                nameId = other.nameId;
+                age = other.age;
+                grade = other.grade;
+                ageAccessed = other.ageAccessed;
+                id.store(other.id.exchange(noId, std::memory_order_relaxed), std::memory_order_relaxed);
+                courses = std::move(other.courses);
+                GradeObserverRegistry::studentAdded(*this);
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Destructor that notifies the observers.
+         */
+        ~Student(){
+            GradeObserverRegistry::studentRemoved(*this);
+        }
+
+        /**
+         * @brief Returns the ID of the student, assigning the next free one on the first call.
+         * Safe to call from several threads at once: they all get the ID of the one that installs it first.
+         * @return The ID, never noId.
+         */
+        Id getId() const{
+            Id current = id.load(std::memory_order_relaxed);
+            if (current == noId){
+                static std::atomic<Id> nextId{1};
+                Id fresh = nextId.fetch_add(1, std::memory_order_relaxed);
+                if (id.compare_exchange_strong(current, fresh, std::memory_order_relaxed)) return fresh;
+            }
+            return current;
+        }
+
+        /**
+         * @brief Returns whether getId() was ever called on the student (observers ignore students without ID).
+         * @return True if the student has an ID.
+         */
+        bool hasId() const{
+            return id.load(std::memory_order_relaxed) != noId;
+        }
+
+        /**
+         * @brief Returns the allocator of the student.
+         * @return The allocator used by the courses.
+         */
+        allocator_type get_allocator() const {
+            return allocator_type(instrument::untrackedResource<Student>(courses.get_allocator().resource()));
+        }
+
+        /**
+         * @brief Getter for the name of the student.
+         * @return View of the interned name, valid for the whole program.
+         */
+        // Getters
+        std::string_view getName() const{
+            return StringInterner::global().view(this->nameId);
+        }
+
+        /**
+         * @brief Getter for the ID of the name in StringInterner::global().
+         * Students with the same name have the same ID.
+         */
+        StringInterner::Id getNameId() const{
+            return this->nameId;
+        }
+
+        /**
+         * @brief Getter for the age of the student.
+         */
+        int getAge() const{
+            ageAccessed = true;
+            return this->age;
+        }
+
+        /**
+         * @brief Getter for the grade of the student.
+         */
+        double getGrade() const{
+            return this->grade;
+        }
+
+        /**
+         * @brief Setter for the name of the student.
+         * @param newName New name of the student.
+         */
+        // Setters
+        void setName(std::string_view newName){
+            if(isValidName(newName)){
+                this->nameId = StringInterner::global().intern(newName);
+            } else {
+                DiagnosticsSink::global().report("Invalid name");
+            }
+        }
+
+        /**
+         * @brief Setter for the age of the student.
+         * @param newAge New age of the student.
+         */
+        void setAge(int newAge){
+            if(isValidAge(newAge)){
+                this->age = newAge;
+            } else {
+                DiagnosticsSink::global().report("Invalid age");
+            }
+        }
+
+        /**
+         * @brief Setter for the grade of the student.
+         * @param newGrade New grade of the student.
+         */
+        void setGrade(double newGrade){
+            if(isValidGrade(newGrade)){
+                double oldGrade = this->grade;
+                this->grade = newGrade;
+                GradeObserverRegistry::gradeChanged(*this, oldGrade, newGrade);
+            } else {
+                DiagnosticsSink::global().report("Invalid grade");
+            }
+        }
+
+        /**
+         * @brief Method to replace the name, age and grade with random values drawn from random.
+         * @param random Generator to draw from; a seeded one gives reproducible students.
+         */
+        void randomize(Random& random){
+            double oldGrade = grade;
+            draw(random);
+            GradeObserverRegistry::gradeChanged(*this, oldGrade, grade);
+        }
+
+        /**
+         * @brief Method to print the student's information.
+         */
+        void printInfo() const; // Declaring printInfo()
+
+        /**
+         * @brief Method to get the total number of students.
+         * @return The number of Student objects currently alive (copies included, destroyed ones excluded).
+         */
+        static int getTotalStudents() {
+            return static_cast<int>(instanceStats().live);
+        }
+
+        // initializing friend method compareGrade
+        /**
+         * @brief Method to compare the grade of two students.
+         */
+        friend bool compareGrade(const Student& a, const Student& b);
+
+        // Course class 
+        /**
+         * @class Course
+         * @brief A class that represents a course.
+         * @param courseName Name of the course.
+         * @param year Year of the course.
+         */
+        class Course { 
+        public:
+            using allocator_type = std::pmr::polymorphic_allocator<>;
+
+            std::pmr::string courseName;
+            int year;
+
+            Course(std::string_view courseName, int year, const allocator_type& alloc = {}): courseName(courseName, alloc), year(year){}
+
+            Course(const Course& other, const allocator_type& alloc) : courseName(other.courseName, alloc), year(other.year){}
+            Course(Course&& other, const allocator_type& alloc) : courseName(std::move(other.courseName), alloc), year(other.year){}
+            Course(const Course& other) = default;
+            Course(Course&& other) = default;
+            Course& operator=(const Course& other) = default;
+            Course& operator=(Course&& other) = default;
+        };
+
+        /**
+         * @brief Method to enroll a student in a course.
+         * @param course Course to enroll the student in; only its ID in CourseCatalog::global() is kept.
+         */
+        void enroll(const Course& course){
+            enroll(CourseCatalog::global().intern(course.courseName, course.year));
+        }
+
+        /**
+         * @brief Method to enroll a student in a course of CourseCatalog::global().
+         * @param course ID of the course.
+         */
+        void enroll(CourseCatalog::Id course){
+            courses.push_back(course);
+        }
+
+        /**
+         * @brief Returns the courses the student enrolled in, to build an EnrollmentIndex.
+         * @return IDs in CourseCatalog::global(), in enrollment order.
+         */
+        std::span<const CourseCatalog::Id> getCourseIds() const{
+            return courses;
+        }
+
+        /**
+         * @brief Method to print the courses the student is enrolled in.
+         */
+        void printCourses() const{
+            printCourseList(courses);
+        }
+
+        /**
+         * @brief Method to print the courses of the student recorded in an enrollment index.
+         * @param index Index built from the students (see EnrollmentIndex::fromStudents()).
+         */
+        void printCourses(const EnrollmentIndex& index) const{
+            printCourseList(hasId() ? index.coursesOf(getId()) : std::span<const CourseCatalog::Id>());
+        }
+
+    private:
+        // IDs of the enrolled courses in CourseCatalog::global(), starting empty
+        std::pmr::vector<CourseCatalog::Id> courses;
+
+        static void printCourseList(std::span<const CourseCatalog::Id> ids){
+            std::cout<< "Enrolled Courses:"<<std::endl;
+            for (CourseCatalog::Id courseId : ids){
+                CourseCatalog::CourseInfo course = CourseCatalog::global().get(courseId);
+                std::cout << "- " << course.name << " (Year: " << course.year << ")" << std::endl;
+            }
+        }
+
+        // had to declare after Course class because error
+    };
+
+    inline void Student::printInfo() const{ // Defining outside class
+        std::cout << "Name: " << getName() << std::endl;
+        std::cout << "Age: " << age << std::endl;
+        std::cout << std::fixed << std::setprecision(2);
+        std::cout << "Grade: " << grade << std::endl << std::endl;
+
+        if(Student::ageAccessed){
+            std::cout<<"Age has been accessed"<<std::endl<<std::endl;
+        }
+    }
+
+    inline bool compareGrade(const Student& a, const Student& b) {
+        if (a.grade > b.grade){
+            return true;
+        } else {
+            return false;
+        }
+    }
+
+    /**
+     * @brief Method to check whether two students have the same name, comparing the interned IDs.
+     */
+    inline bool sameName(const Student& a, const Student& b) {
+        return a.getNameId() == b.getNameId();
+    }
+
+}
@@ -0,0 +1,94 @@
+/**
+ * @file StudentGenerator.h
+ * @brief Parallel generation of large populations of random students.
+ */
+#pragma once
+
+#include "Random.h"
+#include "Student.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+namespace oop{
+
+    /**
+     * @brief Students generated from one seeded generator; the population does not depend on the thread count.
+     */
+    inline constexpr std::size_t studentBlockSize = 16 * 1024;
+
+    /**
+     * @brief Seed used by generateStudents() when none is given.
+     */
+    inline constexpr std::uint64_t defaultStudentSeed = 0x5EED5EED;
+
+    /**
+     * @brief Seed of the generator of one block of students.
+     * @param seed Seed of the population.
+     * @param block Index of the block.
+     * @return A seed independent of the seeds of the other blocks.
+     */
+    inline std::uint64_t studentBlockSeed(std::uint64_t seed, std::size_t block){
+        std::uint64_t state = seed ^ (static_cast<std::uint64_t>(block) * 0xD1B54A32D192ED03ull);
+        return splitMix64(state);
+    }
+
+    /**
+     * @brief Generates n random students with the workers of pool.
+     *
+     * The population is split in blocks of studentBlockSize students, each drawn from its own generator
+     * seeded from (seed, block), so the same seed always gives the same students whatever the number of threads.
+     * @param n Number of students.
+     * @param pool Pool running the blocks.
+     * @param seed Seed of the population.
+     * @return The students.
+     */
+    inline std::vector<Student> generateStudents(std::size_t n, ThreadPool& pool, std::uint64_t seed = defaultStudentSeed){
+        // Each student is constructed once, from the generator of its block, so no grade is overwritten afterwards
+        std::size_t blocks = (n + studentBlockSize - 1) / studentBlockSize;
+        auto drawBlock = [&](std::size_t block, std::vector<Student>& into){
+            Random random(studentBlockSeed(seed, block));
+            std::size_t end = std::min(n, (block + 1) * studentBlockSize);
+            for(std::size_t i = block * studentBlockSize; i < end; i++) into.emplace_back(random);
+        };
+        std::vector<Student> students;
+        students.reserve(n);
+        if (pool.size() == 0 || blocks <= 1){
+            for(std::size_t block = 0; block < blocks; block++) drawBlock(block, students);
+            return students;
+        }
+        // In parallel the blocks are built in their own vectors, then only the moves into one vector are serial
+        std::vector<std::vector<Student>> parts(blocks);
+        pool.parallelFor(0, blocks, 1, [&](std::size_t first, std::size_t last){
+            for(std::size_t block = first; block < last; block++){
+                parts[block].reserve(std::min(n, (block + 1) * studentBlockSize) - block * studentBlockSize);
+                drawBlock(block, parts[block]);
+            }
+        });
+        for(std::vector<Student>& part : parts){
+            students.insert(students.end(), std::make_move_iterator(part.begin()), std::make_move_iterator(part.end()));
+        }
+        pool.parallelFor(0, blocks, 1, [&](std::size_t first, std::size_t last){
+            for(std::size_t block = first; block < last; block++) std::vector<Student>().swap(parts[block]);
+        });
+        return students;
+    }
+
+    /**
+     * @brief Generates n random students on the given number of threads.
+     * @param n Number of students.
+     * @param threads Threads used, counting the calling thread (1 generates serially).
+     * @param seed Seed of the population.
+     * @return The students.
+     */
+    inline std::vector<Student> generateStudents(std::size_t n, unsigned threads = ThreadPool::defaultThreadCount(),
+                                                 std::uint64_t seed = defaultStudentSeed){
+        ThreadPool pool(threads > 0 ? threads - 1 : 0);
+        return generateStudents(n, pool, seed);
+    }
+
+}
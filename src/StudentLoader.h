@@ -0,0 +1,540 @@
+/**
+ * @file StudentLoader.h
+ * @brief Bulk loading of students from CSV or binary files, parsed in place from a memory mapping.
+ */
+#pragma once
+
+#include "MappedArray.h"
+#include "Student.h"
+#include "StudentTable.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace oop{
+
+    /**
+     * @brief Why a row of an input file was not loaded.
+     */
+    enum class RejectReason : std::uint8_t{
+        MissingField,   /**< fewer than three comma-separated fields. */
+        ExtraField,     /**< more than three fields. */
+        BadAge,         /**< the age is not an integer. */
+        BadGrade,       /**< the grade is not a number. */
+        EmptyName,      /**< the name is empty. */
+        AgeOutOfRange,  /**< the age is outside the range accepted by Student. */
+        GradeOutOfRange,/**< the grade is outside the range accepted by Student. */
+        BadRecord       /**< a binary record whose name lies outside the file. */
+    };
+
+    /**
+     * @brief Short description of a reject reason, as printed in a RejectionReport.
+     */
+    inline std::string_view toString(RejectReason reason){
+        switch(reason){
+            case RejectReason::MissingField: return "missing field";
+            case RejectReason::ExtraField: return "extra field";
+            case RejectReason::BadAge: return "age is not an integer";
+            case RejectReason::BadGrade: return "grade is not a number";
+            case RejectReason::EmptyName: return "empty name";
+            case RejectReason::AgeOutOfRange: return "age out of range";
+            case RejectReason::GradeOutOfRange: return "grade out of range";
+            case RejectReason::BadRecord: return "bad record";
+        }
+        return "unknown";
+    }
+
+    /**
+     * @struct Rejection
+     * @brief One row that was not loaded.
+     */
+    struct Rejection{
+        std::size_t line;    /**< 1-based line of a CSV file, or 1-based record of a binary file. */
+        RejectReason reason; /**< first problem found in the row. */
+        std::string text;    /**< the row as it appears in the file (at most maxTextLength characters). */
+
+        static constexpr std::size_t maxTextLength = 80;
+    };
+
+    /**
+     * @class RejectionReport
+     * @brief Outcome of a load: how many rows were accepted and which ones were rejected and why.
+     */
+    class RejectionReport{
+    public:
+        std::size_t accepted = 0; /**< rows loaded. */
+        std::vector<Rejection> rejections; /**< rows rejected, in file order. */
+
+        /** @brief Number of rows rejected. */
+        std::size_t rejected() const { return rejections.size(); }
+        /** @brief True if every row was loaded. */
+        bool clean() const { return rejections.empty(); }
+
+        /**
+         * @brief Counts the rows rejected for one reason.
+         * @param reason Reason to count.
+         * @return The number of rejections with that reason.
+         */
+        std::size_t count(RejectReason reason) const {
+            return static_cast<std::size_t>(std::count_if(rejections.begin(), rejections.end(),
+                [reason](const Rejection& r){ return r.reason == reason; }));
+        }
+
+        /**
+         * @brief Prints a summary line, then one line per rejected row.
+         * @param os Output stream object.
+         * @param report Report to be printed.
+         * @return Output stream object.
+         */
+        friend std::ostream& operator<<(std::ostream& os, const RejectionReport& report){
+            os << report.accepted << " accepted, " << report.rejected() << " rejected" << std::endl;
+            for(const Rejection& r : report.rejections){
+                os << "line " << r.line << ": " << toString(r.reason) << ": " << r.text << std::endl;
+            }
+            return os;
+        }
+    };
+
+    /**
+     * @struct StudentColumns
+     * @brief Accepted rows of one chunk of a file, column by column; the names point into the file.
+     */
+    struct StudentColumns{
+        std::span<const std::string_view> names;
+        std::span<const int> ages;
+        std::span<const double> grades;
+
+        /** @brief Number of rows. */
+        std::size_t size() const { return ages.size(); }
+    };
+
+    /**
+     * @brief Binary student file: a 16-byte header, fixed 24-byte records, then the characters of the names.
+     *
+     * Header: the magic "OOPS", a version byte, 3 reserved bytes and the record count (64 bits). Record:
+     * name offset and length (32 bits each, relative to the start of the names), age (32 bits), 4 reserved
+     * bytes and grade (IEEE double). Every number is little-endian.
+     */
+    namespace studentBinary{
+
+        inline constexpr char magic[4] = {'O', 'O', 'P', 'S'};
+        inline constexpr std::uint8_t version = 1;
+        inline constexpr std::size_t headerSize = 16;
+        inline constexpr std::size_t recordSize = 24;
+
+        // Little-endian load and store of a trivially copyable value
+        template<typename T>
+        T load(const char* in){
+            T value;
+            std::memcpy(&value, in, sizeof(T));
+            if constexpr (std::endian::native == std::endian::big){
+                auto* bytes = reinterpret_cast<unsigned char*>(&value);
+                std::reverse(bytes, bytes + sizeof(T));
+            }
+            return value;
+        }
+
+        template<typename T>
+        void store(T value, char* out){
+            if constexpr (std::endian::native == std::endian::big){
+                auto* bytes = reinterpret_cast<unsigned char*>(&value);
+                std::reverse(bytes, bytes + sizeof(T));
+            }
+            std::memcpy(out, &value, sizeof(T));
+        }
+    }
+
+    /**
+     * @brief Writes the rows of a table to a file in the binary format read by StudentLoader.
+     * @param path File to be written (replaced if it exists).
+     * @param table Students to be saved.
+     * @throws std::runtime_error if the file cannot be written or the names exceed 4 GiB.
+     */
+    inline void saveStudentsBinary(const std::filesystem::path& path, const StudentTable& table){
+        using namespace studentBinary;
+        std::vector<char> records(headerSize + table.size() * recordSize, 0);
+        std::string names;
+        std::memcpy(records.data(), magic, sizeof(magic));
+        records[4] = static_cast<char>(version);
+        store<std::uint64_t>(table.size(), records.data() + 8);
+        for(std::size_t i = 0; i < table.size(); i++){
+            std::string_view name = table.getName(table.getNameIds()[i]);
+            if (names.size() + name.size() > std::numeric_limits<std::uint32_t>::max()) throw std::runtime_error("saveStudentsBinary: names exceed 4 GiB");
+            char* record = records.data() + headerSize + i * recordSize;
+            store<std::uint32_t>(static_cast<std::uint32_t>(names.size()), record);
+            store<std::uint32_t>(static_cast<std::uint32_t>(name.size()), record + 4);
+            store<std::int32_t>(table.getAges()[i], record + 8);
+            store<double>(table.getGrades()[i], record + 16);
+            names.append(name);
+        }
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(records.data(), static_cast<std::streamsize>(records.size()));
+        file.write(names.data(), static_cast<std::streamsize>(names.size()));
+        if (!file) throw std::runtime_error("saveStudentsBinary: cannot write " + path.string());
+    }
+
+    /**
+     * @brief Writes students to a file in the binary format read by StudentLoader.
+     * @param path File to be written (replaced if it exists).
+     * @param students Students to be saved.
+     */
+    inline void saveStudentsBinary(const std::filesystem::path& path, std::span<const Student> students){
+        saveStudentsBinary(path, StudentTable(students));
+    }
+
+    /**
+     * @class StudentLoader
+     * @brief Loads name, age and grade rows in bulk from a CSV or binary file without copying the file.
+     *
+     * The file is memory-mapped and parsed in place: fields are std::string_view slices of the mapping and
+     * numbers are read with std::from_chars, so parsing allocates nothing per field. The file is split at
+     * line boundaries into chunks of about chunkBytes that are parsed in parallel on a ThreadPool. Each chunk
+     * is validated as a batch with the rules of Student (Student::isValidAge() and friends) and bad rows go
+     * to a RejectionReport instead of stopping the load. The accepted rows are then handed over in file
+     * order to a std::vector<Student>, a StudentTable or any callable taking StudentColumns.
+     *
+     * CSV rows are "name,age,grade" separated by '\\n' or "\\r\\n". Spaces around fields are ignored, names
+     * cannot be quoted or contain commas, blank lines are skipped and a first line starting with "name,"
+     * is taken as a header. A binary file is recognized by its magic number (see studentBinary).
+     */
+    class StudentLoader{
+    public:
+        /** @brief Encoding of the input. */
+        enum class Format{ Csv, Binary };
+
+        /** @brief Default size of the chunks parsed in parallel. */
+        static constexpr std::size_t defaultChunkBytes = std::size_t{1} << 20;
+
+    private:
+        // Rows of one chunk, with where each one came from so that batch validation can report it
+        struct Chunk{
+            std::vector<std::string_view> names;
+            std::vector<int> ages;
+            std::vector<double> grades;
+            std::vector<std::size_t> lines; /**< line of each row, local to the chunk until renumbered. */
+            std::vector<std::string_view> rows; /**< raw text of each row. */
+            std::vector<Rejection> rejections;
+            std::size_t lineCount = 0; /**< lines of the chunk, blank ones included. */
+            std::size_t firstLine = 0; /**< 0-based line of the first line of the chunk in the file. */
+
+            void reject(std::size_t line, RejectReason reason, std::string_view row){
+                rejections.push_back({line, reason, std::string(row.substr(0, Rejection::maxTextLength))});
+            }
+        };
+
+#if OOP_HAS_MMAP
+        std::optional<MappedArray<char>> mapping; /**< the mapped file, when loading from a path. */
+#else
+        std::vector<char> contents; /**< the file read into memory where mmap is not available. */
+#endif
+        std::string_view text; /**< the bytes being parsed. */
+
+        static std::string_view trim(std::string_view field){
+            while (!field.empty() && (field.front() == ' ' || field.front() == '\t')) field.remove_prefix(1);
+            while (!field.empty() && (field.back() == ' ' || field.back() == '\t')) field.remove_suffix(1);
+            return field;
+        }
+
+        template<typename T>
+        static bool parseNumber(std::string_view field, T& value){
+            field = trim(field);
+            auto [end, error] = std::from_chars(field.data(), field.data() + field.size(), value);
+            return error == std::errc() && end == field.data() + field.size() && !field.empty();
+        }
+
+        // Splits the CSV text into chunk boundaries that fall right after a newline
+        std::vector<std::size_t> csvBoundaries(std::size_t chunkBytes) const {
+            std::vector<std::size_t> bounds{0};
+            std::size_t pos = 0;
+            while (text.size() - pos > chunkBytes){
+                std::size_t newline = text.find('\n', pos + chunkBytes);
+                if (newline == std::string_view::npos) break;
+                pos = newline + 1;
+                bounds.push_back(pos);
+            }
+            bounds.push_back(text.size());
+            return bounds;
+        }
+
+        static void parseCsvChunk(std::string_view part, bool skipHeader, Chunk& chunk){
+            const char* p = part.data();
+            const char* end = p + part.size();
+            std::size_t line = 0;
+            std::size_t expectedRows = part.size() / 16; // typical rows are a little longer than 16 bytes
+            chunk.names.reserve(expectedRows);
+            chunk.ages.reserve(expectedRows);
+            chunk.grades.reserve(expectedRows);
+            chunk.lines.reserve(expectedRows);
+            chunk.rows.reserve(expectedRows);
+            for(; p < end; line++){
+                const char* newline = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+                const char* lineEnd = newline ? newline : end;
+                std::string_view row(p, static_cast<std::size_t>(lineEnd - p));
+                p = newline ? newline + 1 : end;
+                if (!row.empty() && row.back() == '\r') row.remove_suffix(1);
+                if (trim(row).empty()) continue;
+                if (line == 0 && skipHeader && row.starts_with("name,")) continue;
+
+                std::size_t comma1 = row.find(',');
+                std::size_t comma2 = comma1 == std::string_view::npos ? comma1 : row.find(',', comma1 + 1);
+                if (comma2 == std::string_view::npos){
+                    chunk.reject(line, RejectReason::MissingField, row);
+                    continue;
+                }
+                if (row.find(',', comma2 + 1) != std::string_view::npos){
+                    chunk.reject(line, RejectReason::ExtraField, row);
+                    continue;
+                }
+                int age;
+                double grade;
+                if (!parseNumber(row.substr(comma1 + 1, comma2 - comma1 - 1), age)){
+                    chunk.reject(line, RejectReason::BadAge, row);
+                    continue;
+                }
+                if (!parseNumber(row.substr(comma2 + 1), grade)){
+                    chunk.reject(line, RejectReason::BadGrade, row);
+                    continue;
+                }
+                chunk.names.push_back(trim(row.substr(0, comma1)));
+                chunk.ages.push_back(age);
+                chunk.grades.push_back(grade);
+                chunk.lines.push_back(line);
+                chunk.rows.push_back(row);
+            }
+            chunk.lineCount = line;
+        }
+
+        void parseBinaryChunk(std::size_t first, std::size_t last, Chunk& chunk) const {
+            using namespace studentBinary;
+            std::size_t count = studentBinary::load<std::uint64_t>(text.data() + 8);
+            std::string_view names = text.substr(headerSize + count * recordSize);
+            for(std::size_t i = first; i < last; i++){
+                const char* record = text.data() + headerSize + i * recordSize;
+                std::uint32_t offset = studentBinary::load<std::uint32_t>(record);
+                std::uint32_t length = studentBinary::load<std::uint32_t>(record + 4);
+                std::size_t line = i - first;
+                if (offset > names.size() || length > names.size() - offset){
+                    chunk.reject(line, RejectReason::BadRecord, "record " + std::to_string(i + 1));
+                    continue;
+                }
+                chunk.names.push_back(names.substr(offset, length));
+                chunk.ages.push_back(studentBinary::load<std::int32_t>(record + 8));
+                chunk.grades.push_back(studentBinary::load<double>(record + 16));
+                chunk.lines.push_back(line);
+                chunk.rows.push_back(chunk.names.back());
+            }
+            chunk.lineCount = last - first;
+        }
+
+        // Checks every row of the chunk against the rules of Student and keeps only the valid ones
+        static void validate(Chunk& chunk){
+            std::size_t n = chunk.ages.size();
+            std::vector<std::uint8_t> problems(n);
+            for(std::size_t i = 0; i < n; i++){
+                problems[i] = static_cast<std::uint8_t>(int(!Student::isValidName(chunk.names[i]))
+                                                        | int(!Student::isValidAge(chunk.ages[i])) << 1
+                                                        | int(!Student::isValidGrade(chunk.grades[i])) << 2);
+            }
+            std::size_t kept = 0;
+            std::vector<Rejection> rejected;
+            for(std::size_t i = 0; i < n; i++){
+                if (problems[i] == 0){
+                    chunk.names[kept] = chunk.names[i];
+                    chunk.ages[kept] = chunk.ages[i];
+                    chunk.grades[kept] = chunk.grades[i];
+                    kept++;
+                    continue;
+                }
+                RejectReason reason = problems[i] & 1 ? RejectReason::EmptyName
+                                    : problems[i] & 2 ? RejectReason::AgeOutOfRange : RejectReason::GradeOutOfRange;
+                rejected.push_back({chunk.lines[i], reason, std::string(chunk.rows[i].substr(0, Rejection::maxTextLength))});
+            }
+            chunk.names.resize(kept);
+            chunk.ages.resize(kept);
+            chunk.grades.resize(kept);
+            if (!rejected.empty()){
+                // Both lists are sorted by line, so merge them to keep the report in file order
+                std::vector<Rejection> merged;
+                merged.reserve(chunk.rejections.size() + rejected.size());
+                std::merge(std::make_move_iterator(chunk.rejections.begin()), std::make_move_iterator(chunk.rejections.end()),
+                           std::make_move_iterator(rejected.begin()), std::make_move_iterator(rejected.end()),
+                           std::back_inserter(merged), [](const Rejection& a, const Rejection& b){ return a.line < b.line; });
+                chunk.rejections = std::move(merged);
+            }
+            chunk.lines = {};
+            chunk.rows = {};
+        }
+
+        // Parses and validates the whole input in parallel, then numbers the lines and fills the report
+        std::vector<Chunk> parse(ThreadPool& pool, std::size_t chunkBytes, RejectionReport& report) const {
+            chunkBytes = std::max<std::size_t>(chunkBytes, 1);
+            std::vector<Chunk> chunks;
+            if (format() == Format::Csv){
+                std::vector<std::size_t> bounds = csvBoundaries(chunkBytes);
+                chunks.resize(bounds.size() - 1);
+                pool.parallelFor(0, chunks.size(), 1, [&](std::size_t begin, std::size_t end){
+                    for(std::size_t c = begin; c < end; c++){
+                        parseCsvChunk(text.substr(bounds[c], bounds[c + 1] - bounds[c]), c == 0, chunks[c]);
+                        validate(chunks[c]);
+                    }
+                });
+            } else {
+                std::size_t count = recordCount();
+                std::size_t perChunk = std::max<std::size_t>(chunkBytes / studentBinary::recordSize, 1);
+                chunks.resize((count + perChunk - 1) / perChunk);
+                pool.parallelFor(0, chunks.size(), 1, [&](std::size_t begin, std::size_t end){
+                    for(std::size_t c = begin; c < end; c++){
+                        parseBinaryChunk(c * perChunk, std::min(count, (c + 1) * perChunk), chunks[c]);
+                        validate(chunks[c]);
+                    }
+                });
+            }
+            std::size_t line = 0;
+            for(Chunk& chunk : chunks){
+                chunk.firstLine = line;
+                line += chunk.lineCount;
+                report.accepted += chunk.ages.size();
+                for(Rejection& r : chunk.rejections){
+                    r.line += chunk.firstLine + 1;
+                    report.rejections.push_back(std::move(r));
+                }
+                chunk.rejections = {};
+            }
+            return chunks;
+        }
+
+        std::size_t recordCount() const {
+            return static_cast<std::size_t>(studentBinary::load<std::uint64_t>(text.data() + 8));
+        }
+
+        void checkBinary() const {
+            using namespace studentBinary;
+            if (format() != Format::Binary) return;
+            if (text.size() < headerSize || static_cast<std::uint8_t>(text[4]) != version){
+                throw std::runtime_error("StudentLoader: unsupported binary student file");
+            }
+            std::size_t count = recordCount();
+            if (count > (text.size() - headerSize) / recordSize){
+                throw std::runtime_error("StudentLoader: binary student file is truncated");
+            }
+        }
+
+    public:
+        /**
+         * @brief Maps a file for loading.
+         * @param path CSV or binary file of students.
+         * @throws std::system_error if the file cannot be opened or mapped.
+         * @throws std::runtime_error if a binary file has a bad header or is truncated.
+         */
+        explicit StudentLoader(const std::filesystem::path& path){
+#if OOP_HAS_MMAP
+            mapping.emplace(path, MapMode::ReadOnly);
+            if (!mapping->empty()){
+                mapping->advise(AccessHint::Sequential);
+                text = std::string_view(mapping->data(), mapping->size());
+            }
+#else
+            std::ifstream file(path, std::ios::binary);
+            if (!file) throw std::system_error(errno, std::generic_category(), "StudentLoader: cannot open " + path.string());
+            contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            text = std::string_view(contents.data(), contents.size());
+#endif
+            checkBinary();
+        }
+
+        /**
+         * @brief Loads from bytes already in memory; they must outlive the loader and the loaded views.
+         * @param bytes Contents of a CSV or binary file.
+         */
+        explicit StudentLoader(std::string_view bytes) : text(bytes){
+            checkBinary();
+        }
+
+        StudentLoader(const StudentLoader&) = delete;
+        StudentLoader& operator=(const StudentLoader&) = delete;
+        StudentLoader(StudentLoader&&) = default;
+        StudentLoader& operator=(StudentLoader&&) = default;
+
+        /**
+         * @brief Returns how the input is encoded, recognized by the magic number of the binary format.
+         * @return Format::Binary or Format::Csv.
+         */
+        Format format() const {
+            return text.starts_with(std::string_view(studentBinary::magic, sizeof(studentBinary::magic))) ? Format::Binary : Format::Csv;
+        }
+
+        /** @brief Size of the input in bytes. */
+        std::size_t bytes() const { return text.size(); }
+
+        /**
+         * @brief Parses and validates the input, then calls f once per chunk of accepted rows, in file order.
+         * @param f Callable taking StudentColumns; the names are valid while the loader lives.
+         * @param pool Pool the chunks are parsed on.
+         * @param chunkBytes Approximate size of the chunks.
+         * @return Report of the accepted and rejected rows.
+         */
+        template<typename F>
+        RejectionReport forEachBatch(F&& f, ThreadPool& pool = ThreadPool::global(), std::size_t chunkBytes = defaultChunkBytes) const {
+            RejectionReport report;
+            std::vector<Chunk> chunks = parse(pool, chunkBytes, report);
+            for(const Chunk& chunk : chunks){
+                f(StudentColumns{chunk.names, chunk.ages, chunk.grades});
+            }
+            return report;
+        }
+
+        /**
+         * @brief Appends the accepted rows to a vector of students.
+         * @param out Vector receiving one Student per accepted row (reserved once for all of them).
+         * @param pool Pool the chunks are parsed on.
+         * @param chunkBytes Approximate size of the chunks.
+         * @return Report of the accepted and rejected rows.
+         */
+        RejectionReport load(std::vector<Student>& out, ThreadPool& pool = ThreadPool::global(), std::size_t chunkBytes = defaultChunkBytes) const {
+            RejectionReport report;
+            std::vector<Chunk> chunks = parse(pool, chunkBytes, report);
+            out.reserve(out.size() + report.accepted);
+            for(const Chunk& chunk : chunks){
+                for(std::size_t i = 0; i < chunk.ages.size(); i++){
+                    out.emplace_back(chunk.names[i], chunk.ages[i], chunk.grades[i]);
+                }
+            }
+            return report;
+        }
+
+        /**
+         * @brief Appends the accepted rows to the columns of a table.
+         * @param out Table receiving one row per accepted row (reserved once for all of them).
+         * @param pool Pool the chunks are parsed on.
+         * @param chunkBytes Approximate size of the chunks.
+         * @return Report of the accepted and rejected rows.
+         */
+        RejectionReport load(StudentTable& out, ThreadPool& pool = ThreadPool::global(), std::size_t chunkBytes = defaultChunkBytes) const {
+            RejectionReport report;
+            std::vector<Chunk> chunks = parse(pool, chunkBytes, report);
+            out.reserve(out.size() + report.accepted);
+            for(const Chunk& chunk : chunks){
+                out.appendColumns(chunk.names, chunk.ages, chunk.grades);
+            }
+            return report;
+        }
+    };
+
+}
@@ -0,0 +1,472 @@
+/**
+ * @file StudentTable.h
+ * @brief Declaration of the StudentTable class, which stores students column by column.
+ */
+#pragma once
+
+#include "ArrayOps.h"
+#include "BatchUpdate.h"
+#include "DynamicArray.h"
+#include "Student.h"
+#include "StringInterner.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <iomanip>
+#include <iostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace oop{
+
+    /**
+     * @class StudentTable
+     * @brief Students stored as a structure of arrays: one contiguous column each for name IDs, ages and grades.
+     *
+     * A scan over the grades reads 8 bytes per student instead of a whole Student object with its name and
+     * courses, and the loops over a column are simple enough for the compiler to vectorize. Names are
+     * interned in a StringInterner (the global one shared with Student unless the table is given its own)
+     * and rows keep the 32-bit ID. Courses are not part of the table. Row views give access to one student
+     * with the getters and setters of Student.
+     */
+    class StudentTable{
+    public:
+        using size_type = std::size_t;
+        using NameId = StringInterner::Id;
+
+    private:
+        DynamicArray<NameId> nameIds; /**< name column, as IDs of the interner. */
+        DynamicArray<int> ages; /**< age column. */
+        DynamicArray<double> grades; /**< grade column. */
+
+        StringInterner* interner = &StringInterner::global(); /**< dictionary of the names, not owned. */
+
+        // Rows share the validation of Student so both report invalid values the same way
+        template<typename Table>
+        class RowView{
+        protected:
+            Table* table;
+            size_type index;
+
+        public:
+            RowView(Table* table, size_type index) : table(table), index(index) {}
+
+            /**
+             * @brief Getter for the name of the student.
+             */
+            std::string_view getName() const{
+                return table->interner->view(table->nameIds[index]);
+            }
+
+            /**
+             * @brief Getter for the ID of the name in the interner of the table.
+             */
+            NameId getNameId() const{
+                return table->nameIds[index];
+            }
+
+            /**
+             * @brief Getter for the age of the student.
+             */
+            int getAge() const{
+                return table->ages[index];
+            }
+
+            /**
+             * @brief Getter for the grade of the student.
+             */
+            double getGrade() const{
+                return table->grades[index];
+            }
+
+            /**
+             * @brief Returns the position of the row in the table.
+             */
+            size_type getIndex() const{
+                return index;
+            }
+
+            /**
+             * @brief Method to print the student's information in the format of Student::printInfo().
+             */
+            void printInfo() const{
+                std::cout << "Name: " << getName() << std::endl;
+                std::cout << "Age: " << getAge() << std::endl;
+                std::cout << std::fixed << std::setprecision(2);
+                std::cout << "Grade: " << getGrade() << std::endl << std::endl;
+            }
+
+            /**
+             * @brief Copies the row into a Student object.
+             * @return A Student with the name, age and grade of the row.
+             */
+            Student toStudent() const{
+                return Student(getName(), getAge(), getGrade());
+            }
+        };
+
+    public:
+        /**
+         * @class ConstRow
+         * @brief Read-only view of one row of a StudentTable.
+         */
+        class ConstRow : public RowView<const StudentTable>{
+        public:
+            using RowView::RowView;
+        };
+
+        /**
+         * @class Row
+         * @brief View of one row of a StudentTable with the getters and setters of Student.
+         *
+         * The view refers to the table by position, so it stays valid while rows are appended.
+         */
+        class Row : public RowView<StudentTable>{
+        public:
+            using RowView::RowView;
+
+            operator ConstRow() const{
+                return ConstRow(table, index);
+            }
+
+            /**
+             * @brief Setter for the name of the student.
+             * @param newName New name of the student.
+             */
+            void setName(std::string_view newName){
+                if(Student::isValidName(newName)){
+                    table->nameIds[index] = table->intern(newName);
+                } else {
+                    DiagnosticsSink::global().report("Invalid name");
+                }
+            }
+
+            /**
+             * @brief Setter for the age of the student.
+             * @param newAge New age of the student.
+             */
+            void setAge(int newAge){
+                if(Student::isValidAge(newAge)){
+                    table->ages[index] = newAge;
+                } else {
+                    DiagnosticsSink::global().report("Invalid age");
+                }
+            }
+
+            /**
+             * @brief Setter for the grade of the student.
+             * @param newGrade New grade of the student.
+             */
+            void setGrade(double newGrade){
+                if(Student::isValidGrade(newGrade)){
+                    table->grades[index] = newGrade;
+                } else {
+                    DiagnosticsSink::global().report("Invalid grade");
+                }
+            }
+        };
+
+        StudentTable() = default;
+
+        /**
+         * @brief Constructor for a table with its own name dictionary.
+         * @param interner Interner of the names; it must outlive the table and its copies.
+         */
+        explicit StudentTable(StringInterner& interner) : interner(&interner) {}
+
+        /**
+         * @brief Constructor that converts a vector of students into columns.
+         * @param students Students to be stored.
+         */
+        explicit StudentTable(std::span<const Student> students){
+            append(students);
+        }
+
+        /**
+         * @brief Returns the number of students.
+         * @return The number of rows.
+         */
+        size_type size() const { return ages.size(); }
+
+        /**
+         * @brief Returns whether the table has no rows.
+         * @return True if the table is empty.
+         */
+        bool empty() const { return ages.empty(); }
+
+        /**
+         * @brief Reserves space in every column for n rows.
+         * @param n Number of rows.
+         */
+        void reserve(size_type n){
+            nameIds.reserve(n);
+            ages.reserve(n);
+            grades.reserve(n);
+        }
+
+        /**
+         * @brief Removes every row (the names stay in the interner).
+         */
+        void clear(){
+            nameIds.clear();
+            ages.clear();
+            grades.clear();
+        }
+
+        /**
+         * @brief Returns the ID of name in the interner of the table, adding it if it is new.
+         * @param name Name to be looked up.
+         * @return The ID of the name.
+         */
+        NameId intern(std::string_view name){
+            return interner->intern(name);
+        }
+
+        /**
+         * @brief Returns the name with the given ID.
+         * @param id ID returned by intern() or Row::getNameId().
+         * @return View of the name, valid while the interner lives.
+         */
+        std::string_view getName(NameId id) const{
+            return interner->view(id);
+        }
+
+        /**
+         * @brief Returns the interner holding the names of the table.
+         * @return Reference to the interner.
+         */
+        StringInterner& getInterner() const{
+            return *interner;
+        }
+
+        /**
+         * @brief Appends one student.
+         * @param name Name of the student.
+         * @param age Age of the student.
+         * @param grade Grade of the student.
+         * @return View of the new row.
+         * @throws std::invalid_argument like the Student constructor, and the table is left unchanged.
+         */
+        Row append(std::string_view name, int age, double grade){
+            NameId id = intern(Student::validated(name, age, grade));
+            nameIds.push_back(id);
+            ages.push_back(age);
+            grades.push_back(grade);
+            return Row(this, size() - 1);
+        }
+
+        /**
+         * @brief Appends the name, age and grade of every student.
+         * @param students Students to be appended.
+         */
+        void append(std::span<const Student> students){
+            reserve(size() + students.size());
+            bool sameInterner = interner == &StringInterner::global();
+            for(const Student& student : students){
+                // Students intern their names globally, so their IDs can be copied when the table does too
+                nameIds.push_back(sameInterner ? student.nameId : intern(student.getName()));
+                ages.push_back(student.age);
+                grades.push_back(student.grade);
+            }
+        }
+
+        /**
+         * @brief Appends rows given as separate columns of the same length.
+         * @param newNames Names of the students.
+         * @param newAges Ages of the students.
+         * @param newGrades Grades of the students.
+         * @throws std::invalid_argument if the columns have different lengths or a row would be refused by the
+         *         Student constructor; nothing is appended then.
+         */
+        void appendColumns(std::span<const std::string_view> newNames, std::span<const int> newAges,
+                           std::span<const double> newGrades){
+            if (newNames.size() != newAges.size() || newNames.size() != newGrades.size()){
+                throw std::invalid_argument("StudentTable::appendColumns: columns of different lengths");
+            }
+            for(size_type i = 0; i < newNames.size(); i++){
+                if (!Student::isValidName(newNames[i]) || !Student::isValidAge(newAges[i]) || !Student::isValidGrade(newGrades[i])){
+                    try{
+                        Student::validated(newNames[i], newAges[i], newGrades[i]);
+                    } catch(const std::invalid_argument& error){
+                        throw std::invalid_argument("StudentTable::appendColumns: row " + std::to_string(i) + ": " + error.what());
+                    }
+                }
+            }
+            reserve(size() + newNames.size());
+            for(std::string_view name : newNames){
+                nameIds.push_back(intern(name));
+            }
+            for(int age : newAges) ages.push_back(age);
+            for(double grade : newGrades) grades.push_back(grade);
+        }
+
+        /**
+         * @brief Sets the age of row rows[i] to newAges[i] for every valid update, without writing diagnostics.
+         * The rows and values are validated 64 at a time into the error mask and the valid ones written right after.
+         * @param rows Row of each update; later updates of the same row win.
+         * @param newAges New ages.
+         * @return Which updates were refused and why.
+         * @throws std::invalid_argument if rows and newAges have different lengths.
+         */
+        UpdateReport setAges(std::span<const size_type> rows, std::span<const int> newAges){
+            detail::checkBatchSizes(rows.size(), newAges.size(), "StudentTable::setAges");
+            int* column = ages.data();
+            size_type count = size();
+            UpdateReport report = applyUpdates(rows.size(),
+                [&](size_type i){ return rows[i] >= count; },
+                [&](size_type i){ return !Student::isValidAge(newAges[i]); },
+                [&](size_type i){ column[rows[i]] = newAges[i]; });
+            return report;
+        }
+
+        /**
+         * @brief Sets the grade of row rows[i] to newGrades[i] for every valid update, without writing diagnostics.
+         * @param rows Row of each update; later updates of the same row win.
+         * @param newGrades New grades.
+         * @return Which updates were refused and why.
+         * @throws std::invalid_argument if rows and newGrades have different lengths.
+         */
+        UpdateReport setGrades(std::span<const size_type> rows, std::span<const double> newGrades){
+            detail::checkBatchSizes(rows.size(), newGrades.size(), "StudentTable::setGrades");
+            double* column = grades.data();
+            size_type count = size();
+            UpdateReport report = applyUpdates(rows.size(),
+                [&](size_type i){ return rows[i] >= count; },
+                [&](size_type i){ return !Student::isValidGrade(newGrades[i]); },
+                [&](size_type i){ column[rows[i]] = newGrades[i]; });
+            return report;
+        }
+
+        /**
+         * @brief Sets the name of row rows[i] to newNames[i] for every valid update, without writing diagnostics.
+         * @param rows Row of each update; later updates of the same row win.
+         * @param newNames New names, interned in the dictionary of the table.
+         * @return Which updates were refused and why.
+         * @throws std::invalid_argument if rows and newNames have different lengths.
+         */
+        UpdateReport setNames(std::span<const size_type> rows, std::span<const std::string_view> newNames){
+            detail::checkBatchSizes(rows.size(), newNames.size(), "StudentTable::setNames");
+            size_type count = size();
+            UpdateReport report = applyUpdates(rows.size(),
+                [&](size_type i){ return rows[i] >= count; },
+                [&](size_type i){ return !Student::isValidName(newNames[i]); },
+                [&](size_type i){ nameIds[rows[i]] = intern(newNames[i]); });
+            return report;
+        }
+
+        /**
+         * @brief Overloaded operator[] to access one row.
+         * @param index Index of the row.
+         * @return View of the row.
+         */
+        Row operator[](size_type index){ return Row(this, index); }
+        ConstRow operator[](size_type index) const { return ConstRow(this, index); }
+
+        /**
+         * @brief Read-only access to the columns, for algorithms that work on whole arrays.
+         */
+        const DynamicArray<NameId>& getNameIds() const { return nameIds; }
+        const DynamicArray<int>& getAges() const { return ages; }
+        const DynamicArray<double>& getGrades() const { return grades; }
+
+        /**
+         * @brief Average grade of all the students.
+         * @return The mean grade, 0 for an empty table.
+         */
+        double averageGrade() const{
+            if (empty()) return 0.0;
+            // Independent partial sums let the additions of consecutive elements overlap
+            const double* g = grades.data();
+            size_type n = size();
+            double partial[8] = {};
+            size_type i = 0;
+            for(; i + 8 <= n; i += 8){
+                for(int lane = 0; lane < 8; lane++) partial[lane] += g[i + lane];
+            }
+            double total = 0.0;
+            for(; i < n; i++) total += g[i];
+            for(double value : partial) total += value;
+            return total / static_cast<double>(n);
+        }
+
+        /**
+         * @brief Counts the students whose age is in [minAge, maxAge].
+         * @param minAge Smallest age counted.
+         * @param maxAge Largest age counted.
+         * @return Number of matching rows.
+         */
+        size_type countAgeInRange(int minAge, int maxAge) const{
+            if (minAge > maxAge) return 0;
+            // One unsigned comparison per row and no branch, so the loop vectorizes
+            const int* a = ages.data();
+            std::uint32_t width = static_cast<std::uint32_t>(maxAge) - static_cast<std::uint32_t>(minAge);
+            size_type count = 0;
+            for(size_type i = 0; i < size(); i++){
+                count += static_cast<std::uint32_t>(a[i]) - static_cast<std::uint32_t>(minAge) <= width;
+            }
+            return count;
+        }
+
+        /**
+         * @brief Average grade of the students whose age is in [minAge, maxAge].
+         * @param minAge Smallest age counted.
+         * @param maxAge Largest age counted.
+         * @return The mean grade of the matching rows, 0 if there are none.
+         */
+        double averageGradeForAges(int minAge, int maxAge) const{
+            const int* a = ages.data();
+            const double* g = grades.data();
+            std::uint32_t width = static_cast<std::uint32_t>(maxAge) - static_cast<std::uint32_t>(minAge);
+            double total = 0.0;
+            size_type count = 0;
+            for(size_type i = 0; i < size(); i++){
+                bool match = static_cast<std::uint32_t>(a[i]) - static_cast<std::uint32_t>(minAge) <= width;
+                total += match ? g[i] : 0.0;
+                count += match;
+            }
+            return minAge > maxAge || count == 0 ? 0.0 : total / static_cast<double>(count);
+        }
+
+        /**
+         * @brief Counts the students with a grade of at least threshold.
+         * @param threshold Smallest grade counted.
+         * @return Number of matching rows.
+         */
+        size_type countGradeAtLeast(double threshold) const{
+            const double* g = grades.data();
+            size_type count = 0;
+            for(size_type i = 0; i < size(); i++){
+                count += g[i] >= threshold;
+            }
+            return count;
+        }
+
+        /**
+         * @brief Counts the students with the given name, comparing IDs instead of strings.
+         * @param name Name to be counted.
+         * @return Number of matching rows.
+         */
+        size_type countName(std::string_view name) const{
+            std::optional<NameId> id = interner->find(name);
+            return id ? oop::count_if(nameIds, *id) : 0;
+        }
+
+        /**
+         * @brief Converts the table back into Student objects.
+         * @return One Student per row, in order.
+         */
+        std::vector<Student> toStudents() const{
+            std::vector<Student> students;
+            students.reserve(size());
+            for(size_type i = 0; i < size(); i++){
+                students.emplace_back(getName(nameIds[i]), ages[i], grades[i]);
+            }
+            return students;
+        }
+    };
+
+}
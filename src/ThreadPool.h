@@ -0,0 +1,264 @@
+/**
+ * @file ThreadPool.h
+ * @brief Declaration of the ThreadPool class, a reusable work-stealing pool of worker threads.
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace oop{
+
+    /**
+     * @class ThreadPool
+     * @brief A pool of worker threads that each own a task queue and steal from the others when idle.
+     *
+     * Tasks submitted from a worker go to its own queue and are taken newest first, which keeps nested work
+     * on the same core; idle workers steal the oldest tasks of the other queues. parallelFor() splits a range
+     * in chunks that are handed out dynamically, and the calling thread works on the chunks too, so nested
+     * calls cannot deadlock.
+     */
+    class ThreadPool{
+    public:
+        using Task = std::function<void()>;
+
+    private:
+        // Task queue of one worker, on its own cache line so workers do not contend on it
+        struct alignas(64) Queue{
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        std::vector<std::unique_ptr<Queue>> queues; /**< one queue per worker. */
+        std::vector<std::thread> workers; /**< worker threads. */
+
+        std::mutex sleepMutex; /**< protects stopping and the sleep of idle workers. */
+        std::condition_variable wakeUp; /**< signalled when a task is submitted or the pool stops. */
+        bool stopping = false; /**< set by the destructor. */
+        std::atomic<std::size_t> queued{0}; /**< number of tasks waiting in the queues. */
+        std::atomic<std::size_t> nextQueue{0}; /**< round-robin queue for tasks submitted from outside. */
+
+        inline static thread_local ThreadPool* currentPool = nullptr; /**< pool of the calling worker thread. */
+        inline static thread_local std::size_t currentIndex = 0; /**< index of the calling worker thread. */
+
+        // Takes a task for worker index: its own newest task first, then the oldest task of another queue
+        bool take(std::size_t index, Task& task){
+            {
+                Queue& own = *queues[index];
+                std::lock_guard<std::mutex> lock(own.mutex);
+                if (!own.tasks.empty()){
+                    task = std::move(own.tasks.back());
+                    own.tasks.pop_back();
+                    queued.fetch_sub(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+            for(std::size_t offset = 1; offset < queues.size(); offset++){
+                Queue& victim = *queues[(index + offset) % queues.size()];
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                if (!victim.tasks.empty()){
+                    task = std::move(victim.tasks.front());
+                    victim.tasks.pop_front();
+                    queued.fetch_sub(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void workerLoop(std::size_t index){
+            currentPool = this;
+            currentIndex = index;
+            while(true){
+                Task task;
+                if (take(index, task)){
+                    task();
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock(sleepMutex);
+                wakeUp.wait(lock, [this]{ return stopping || queued.load(std::memory_order_relaxed) > 0; });
+                if (stopping && queued.load(std::memory_order_relaxed) == 0){
+                    return;
+                }
+            }
+        }
+
+    public:
+        /**
+         * @brief Default number of workers: one per hardware thread.
+         * @return std::thread::hardware_concurrency(), at least 1.
+         */
+        static unsigned defaultThreadCount(){
+            return std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        /**
+         * @brief Constructor that starts the worker threads.
+         * @param threadCount Number of workers (0 runs everything on the calling thread).
+         */
+        explicit ThreadPool(unsigned threadCount = defaultThreadCount()){
+            for(unsigned i = 0; i < threadCount; i++){
+                queues.push_back(std::make_unique<Queue>());
+            }
+            for(unsigned i = 0; i < threadCount; i++){
+                workers.emplace_back([this, i]{ workerLoop(i); });
+            }
+        }
+
+        /**
+         * @brief Destructor that runs the tasks still queued and joins the workers.
+         */
+        ~ThreadPool(){
+            {
+                std::lock_guard<std::mutex> lock(sleepMutex);
+                stopping = true;
+            }
+            wakeUp.notify_all();
+            for(std::thread& worker : workers){
+                worker.join();
+            }
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /**
+         * @brief Returns the number of worker threads.
+         * @return The number of workers.
+         */
+        std::size_t size() const {
+            return workers.size();
+        }
+
+        /**
+         * @brief Pool shared by the parallel algorithms when no pool is given, created on first use.
+         * @return Reference to the global pool.
+         */
+        static ThreadPool& global(){
+            static ThreadPool pool;
+            return pool;
+        }
+
+        /**
+         * @brief Queues a task to be run by a worker. Tasks must not throw.
+         * @param task Function to run.
+         */
+        void submit(Task task){
+            if (workers.empty()){
+                task();
+                return;
+            }
+            std::size_t index = currentPool == this ? currentIndex
+                                                    : nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+            {
+                std::lock_guard<std::mutex> lock(queues[index]->mutex);
+                queues[index]->tasks.push_back(std::move(task));
+            }
+            queued.fetch_add(1, std::memory_order_relaxed);
+            {
+                std::lock_guard<std::mutex> lock(sleepMutex); // a worker between its check and its wait would miss the signal
+            }
+            wakeUp.notify_one();
+        }
+
+        /**
+         * @brief Runs one queued task on the calling thread, used to help the workers while waiting.
+         * @return True if a task was run.
+         */
+        bool runPendingTask(){
+            if (queues.empty() || queued.load(std::memory_order_relaxed) == 0){
+                return false;
+            }
+            Task task;
+            if (take(currentPool == this ? currentIndex : 0, task)){
+                task();
+                return true;
+            }
+            return false;
+        }
+
+        /**
+         * @brief Calls body(chunkBegin, chunkEnd) for consecutive chunks of [begin, end) in parallel and waits for all of them.
+         * @param begin First index of the range.
+         * @param end Index past the end of the range.
+         * @param grain Number of indices per chunk.
+         * @param body Callable taking the bounds of a chunk. If it throws, the remaining chunks are skipped
+         *             and the first exception is rethrown here.
+         */
+        template<typename F>
+        void parallelFor(std::size_t begin, std::size_t end, std::size_t grain, F&& body){
+            if (begin >= end){
+                return;
+            }
+            grain = std::max<std::size_t>(grain, 1);
+            std::size_t chunks = (end - begin + grain - 1) / grain;
+            if (chunks == 1 || workers.empty()){
+                body(begin, end);
+                return;
+            }
+
+            // Shared with the helper tasks, which may start after this call has returned
+            struct State{
+                std::atomic<std::size_t> next{0};
+                std::atomic<std::size_t> done{0};
+                std::atomic<bool> failed{false};
+                std::exception_ptr error;
+                std::mutex mutex;
+                std::condition_variable finished;
+            };
+            auto state = std::make_shared<State>();
+
+            auto runChunks = [state, begin, end, grain, chunks, &body]{
+                while(true){
+                    std::size_t chunk = state->next.fetch_add(1, std::memory_order_relaxed);
+                    if (chunk >= chunks){
+                        return;
+                    }
+                    if (!state->failed.load(std::memory_order_relaxed)){
+                        std::size_t chunkBegin = begin + chunk * grain;
+                        try {
+                            body(chunkBegin, std::min(end, chunkBegin + grain));
+                        } catch (...) {
+                            std::lock_guard<std::mutex> lock(state->mutex);
+                            if (!state->error){
+                                state->error = std::current_exception();
+                            }
+                            state->failed = true;
+                        }
+                    }
+                    if (state->done.fetch_add(1, std::memory_order_acq_rel) + 1 == chunks){
+                        std::lock_guard<std::mutex> lock(state->mutex);
+                        state->finished.notify_all();
+                    }
+                }
+            };
+
+            std::size_t helpers = std::min(chunks - 1, workers.size());
+            for(std::size_t i = 0; i < helpers; i++){
+                submit(runChunks);
+            }
+            runChunks();
+
+            // Help with other queued work until the last chunk of this call is done
+            while(state->done.load(std::memory_order_acquire) < chunks){
+                if (!runPendingTask()){
+                    std::unique_lock<std::mutex> lock(state->mutex);
+                    state->finished.wait(lock, [&]{ return state->done.load(std::memory_order_acquire) == chunks; });
+                }
+            }
+            if (state->error){
+                std::rethrow_exception(state->error);
+            }
+        }
+    };
+
+}
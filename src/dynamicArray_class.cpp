@@ -4,10 +4,10 @@
 
 using namespace oop; // Lets assume the header is in a namespace called oop
 
-DynamicArray createRandomArray(){
+DynamicArray<int> createRandomArray(){
     static std::default_random_engine generator;
     static std::uniform_int_distribution<int> distribution(1,100);
-    DynamicArray a(10);
+    DynamicArray<int> a(10);
     for(int i = 0; i < 10; i++){
         a[i] = distribution(generator);
     }
@@ -26,6 +26,10 @@ int main(){
     if(f.size() != a.size() + b.size()){
         std::cerr << "Error: size of f is not the sum of sizes of a and b" <<std::endl;
     }
+    constexpr StaticArray<int, 3> table{1, 2, 3}; // Size known at compile time, no heap memory
+    constexpr StaticArray<int, 6> twice = table + table; // Concatenated by the compiler
+    DynamicArray g = twice; // One copy into a DynamicArray
+    std::cout << g << std::endl;
 
     return 0; // Destructor is called on all objects: no memory leaks
 }
\ No newline at end of file
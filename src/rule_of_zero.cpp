@@ -1,22 +1,8 @@
-#include <iostream>
-#include <vector>
-
-class Person {
-public:
-    std::string name;
-    int age;
-    std::vector<std::string> hobbies;
+#include "CompactPerson.h"
 
-    Person(std::string name, int age, std::vector <std::string> hobbies) : 
-    name(name), age(age), hobbies(hobbies){}
+#include <iostream>
 
-    void printHobbies(){
-        std::cout<<"Hobbies:"<<std::endl;
-        for(int i=0; i<hobbies.size(); i++){
-            std::cout<<"- "<<hobbies[i]<<std::endl;
-        }
-    }
-};
+using namespace oop;
 
 int main(){
     Person p1{"Alice", 30, {"reading", "hiking"}};
@@ -28,4 +14,14 @@ int main(){
     p2.hobbies.push_back("swimming");
     std::cout<<std::endl<<p2.name<<p2.age<<std::endl;
     p2.printHobbies();
-}
\ No newline at end of file
+
+    CompactPerson p3(p2); // Hobbies packed in one buffer, still copied by compiler-generated operations
+    CompactPerson p4 = p3;
+    std::cout<<std::endl<<p4.name<<p4.age<<std::endl;
+    p4.printHobbies();
+
+    std::vector<Person> people{p1, p2};
+    PersonBatch batch = PersonBatch::from(people); // Both people in a single allocation
+    std::cout<<std::endl<<batch.size()<<" people in "<<batch.bytes()<<" bytes"<<std::endl;
+    batch[1].toPerson().printHobbies();
+}
@@ -0,0 +1,37 @@
+/**
+ * @file TempFile.h
+ * @brief Test fixture giving each test its own temporary file, removed at the end of the test.
+ */
+#pragma once
+
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+/**
+ * @class TempFileTest
+ * @brief Base of the fixtures of tests that read and write a file; path is named after the running test.
+ */
+class TempFileTest : public ::testing::Test {
+protected:
+    std::filesystem::path path = std::filesystem::temp_directory_path() / fileName();
+
+    void TearDown() override {
+        std::filesystem::remove(path);
+    }
+
+    // Replaces the contents of the file with the given bytes
+    void write(std::string_view contents) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+    }
+
+private:
+    static std::string fileName() {
+        const ::testing::TestInfo* test = ::testing::UnitTest::GetInstance()->current_test_info();
+        return "oop_" + std::string(test->test_suite_name()) + "_" + test->name() + ".tmp";
+    }
+};
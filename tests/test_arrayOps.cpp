@@ -0,0 +1,120 @@
+#include "gtest/gtest.h"
+#include "ArrayOps.h"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace oop;
+
+// Instruction sets of this CPU whose kernels can be compared against the scalar ones
+std::vector<simd::Isa> supportedIsas() {
+    std::vector<simd::Isa> isas{simd::Isa::Scalar};
+    if (simd::detectIsa() != simd::Isa::Scalar) {
+        isas.push_back(simd::Isa::Sse2);
+    }
+    if (simd::detectIsa() == simd::Isa::Avx2) {
+        isas.push_back(simd::Isa::Avx2);
+    }
+    return isas;
+}
+
+std::vector<std::int32_t> randomInts(std::size_t n, std::int32_t low, std::int32_t high) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<std::int32_t> dist(low, high);
+    std::vector<std::int32_t> values(n);
+    for (auto& value : values) {
+        value = dist(rng);
+    }
+    return values;
+}
+
+// Test every kernel against the scalar version on aligned and misaligned ranges of several sizes
+TEST(ArrayOpsTest, KernelsMatchScalar) {
+    const simd::Int32Kernels& reference = simd::kernelsFor(simd::Isa::Scalar);
+    std::vector<std::int32_t> a = randomInts(1000, INT32_MIN, INT32_MAX);
+    std::vector<std::int32_t> b = randomInts(1000, -3, 3);
+    std::vector<std::int32_t> expected(1000), actual(1000);
+
+    for (simd::Isa isa : supportedIsas()) {
+        const simd::Int32Kernels& k = simd::kernelsFor(isa);
+        for (std::size_t offset : {0, 1, 3}) {
+            for (std::size_t n : {0, 1, 7, 8, 31, 64, 997}) {
+                const std::int32_t* x = a.data() + offset;
+                const std::int32_t* y = b.data() + offset;
+                SCOPED_TRACE(testing::Message() << "isa " << int(isa) << " offset " << offset << " n " << n);
+
+                EXPECT_EQ(k.sum(x, n), reference.sum(x, n));
+                EXPECT_EQ(k.min(x, n), reference.min(x, n));
+                EXPECT_EQ(k.max(x, n), reference.max(x, n));
+                EXPECT_EQ(k.dot(x, y, n), reference.dot(x, y, n));
+                EXPECT_EQ(k.count(y, n, 2), reference.count(y, n, 2));
+
+                reference.multiply(x, y, expected.data() + offset, n);
+                k.multiply(x, y, actual.data() + offset, n);
+                EXPECT_TRUE(std::equal(expected.begin() + offset, expected.begin() + offset + n, actual.begin() + offset));
+
+                reference.subtractScalar(x, 12345, expected.data() + offset, n);
+                k.subtractScalar(x, 12345, actual.data() + offset, n);
+                EXPECT_TRUE(std::equal(expected.begin() + offset, expected.begin() + offset + n, actual.begin() + offset));
+            }
+        }
+    }
+}
+
+// Test reductions on DynamicArray, which can now be const
+TEST(ArrayOpsTest, Reductions) {
+    DynamicArray<int> values;
+    for (int i = -500; i < 500; i++) {
+        values.push_back(i * 3);
+    }
+    const DynamicArray<int>& constValues = values;
+
+    EXPECT_EQ(sum(constValues), -1500);
+    EXPECT_EQ(min(constValues), -1500);
+    EXPECT_EQ(max(constValues), 1497);
+    EXPECT_EQ(count_if(constValues, 300), 1);
+    EXPECT_EQ(dot(constValues, constValues), 750'001'500);
+    EXPECT_EQ(constValues[0], -1500);
+
+    DynamicArray<double> doubles{1.5, -2.0, 4.0};
+    EXPECT_DOUBLE_EQ(sum(doubles), 3.5);
+    EXPECT_DOUBLE_EQ(min(doubles), -2.0);
+}
+
+// Test element-wise arithmetic with arrays and scalars
+TEST(ArrayOpsTest, ElementWise) {
+    DynamicArray<int> a(100, 3);
+    DynamicArray<int> b(100, 4);
+    fill(b, 5);
+
+    DynamicArray<int> c = add(a, b);
+    DynamicArray<int> d = subtract(a, b);
+    DynamicArray<int> e = multiply(multiply(a, b), 2);
+    DynamicArray<int> f = add(subtract(a, 1), 10);
+    for (int i = 0; i < 100; i++) {
+        EXPECT_EQ(c[i], 8);
+        EXPECT_EQ(d[i], -2);
+        EXPECT_EQ(e[i], 30);
+        EXPECT_EQ(f[i], 12);
+    }
+
+    DynamicArrayVector v(3, 2);
+    EXPECT_EQ(sum(multiply(v, v)), 12);
+
+    DynamicArray<int> shorter(99);
+    EXPECT_THROW(add(a, shorter), std::invalid_argument);
+}
+
+// Test heap storage is aligned to a cache line so the kernels can use aligned loads
+TEST(ArrayOpsTest, StorageIsCacheLineAligned) {
+    for (int size : {17, 100, 1000, 12345}) {
+        DynamicArray<int> a(size);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(a.data()) % 64, 0);
+    }
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,185 @@
+#include "gtest/gtest.h"
+#include "ArrayView.h"
+#include "DynamicArray.h"
+
+#include <numeric>
+#include <span>
+#include <sstream>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace oop;
+
+static DynamicArray<int> iota(int n) {
+    DynamicArray<int> a(n);
+    std::iota(a.begin(), a.end(), 0);
+    return a;
+}
+
+// Test a view refers to the elements of the array instead of copying them
+TEST(ArrayViewTest, ViewsWithoutCopying) {
+    DynamicArray<int> a = iota(100);
+    ArrayView view(a);
+    static_assert(std::is_same_v<decltype(view), ArrayView<int>>);
+    EXPECT_EQ(view.data(), a.data());
+    EXPECT_EQ(view.size(), 100u);
+
+    view[3] = 42;
+    EXPECT_EQ(a[3], 42);
+
+    const DynamicArray<int>& constArray = a;
+    ArrayView readOnly(constArray);
+    static_assert(std::is_same_v<decltype(readOnly), ArrayView<const int>>);
+    static_assert(!std::is_assignable_v<decltype(readOnly[0]), int>);
+    ArrayView<const int> converted = view;
+    EXPECT_EQ(converted[3], 42);
+
+    std::span<int> span = view;
+    EXPECT_EQ(span.size(), 100u);
+    ArrayView<int> fromSpan(span);
+    EXPECT_EQ(fromSpan.data(), a.data());
+
+    DynamicArrayVector v(10, 5);
+    ArrayView<const int> vectorView(v);
+    EXPECT_EQ(vectorView[9], 5);
+    std::vector<int> stdVector{1, 2, 3};
+    EXPECT_EQ(ArrayView(stdVector).back(), 3);
+}
+
+// Test subviews, first and last, and bounds checks
+TEST(ArrayViewTest, Subviews) {
+    DynamicArray<int> a = iota(10);
+    ArrayView<const int> view(a);
+
+    ArrayView<const int> middle = view.subview(2, 5);
+    EXPECT_EQ(middle.size(), 5u);
+    EXPECT_EQ(middle.front(), 2);
+    EXPECT_EQ(middle.back(), 6);
+    EXPECT_EQ(middle.subview(1, 2)[1], 4);
+    EXPECT_EQ(view.subview(7).size(), 3u);
+    EXPECT_EQ(view.subview(8, 100).size(), 2u);
+    EXPECT_TRUE(view.subview(10).empty());
+    EXPECT_EQ(view.first(3).back(), 2);
+    EXPECT_EQ(view.last(3).front(), 7);
+    EXPECT_EQ(view.last(30).size(), 10u);
+    EXPECT_THROW(view.subview(11), std::out_of_range);
+    EXPECT_THROW(view.at(10), std::out_of_range);
+
+    int total = 0;
+    for (int value : middle) total += value;
+    EXPECT_EQ(total, 2 + 3 + 4 + 5 + 6);
+
+    std::ostringstream os;
+    os << middle;
+    EXPECT_EQ(os.str(), "[2, 3, 4, 5, 6]");
+}
+
+// Test strided views pick every step-th element and can be written through
+TEST(ArrayViewTest, StridedViews) {
+    DynamicArray<int> matrix = iota(12); // 4 rows of 3 columns
+    StridedView<int> column = ArrayView(matrix).subview(1).strided(3);
+    EXPECT_EQ(column.size(), 4u);
+    EXPECT_EQ(column[0], 1);
+    EXPECT_EQ(column[3], 10);
+    EXPECT_EQ(ArrayView(matrix).strided(5).size(), 3u);
+    EXPECT_THROW(ArrayView(matrix).strided(0), std::invalid_argument);
+
+    for (int& value : column) value = -value;
+    EXPECT_EQ(matrix[4], -4);
+    EXPECT_EQ(std::accumulate(column.begin(), column.end(), 0), -(1 + 4 + 7 + 10));
+    EXPECT_EQ(column.end() - column.begin(), 4);
+    EXPECT_EQ(column.subview(1, 2)[1], -7);
+
+    StridedView<const int> readOnly = column;
+    EXPECT_EQ(readOnly.toArray().size(), 4u);
+
+    std::ostringstream os;
+    os << column;
+    EXPECT_EQ(os.str(), "[-1, -4, -7, -10]");
+}
+
+// Test views are operands of operator+, so slices are concatenated with a single allocation
+TEST(ArrayViewTest, Concatenation) {
+    DynamicArray<int> a = iota(10);
+    ArrayView<const int> view(a);
+    DynamicArray<int> c = view.first(2) + view.last(2) + view.strided(4);
+    std::ostringstream os;
+    os << c;
+    EXPECT_EQ(os.str(), "[0, 1, 8, 9, 0, 4, 8]");
+}
+
+// Test copies of a SharedArray share one buffer until one of them writes
+TEST(SharedArrayTest, CopyOnWrite) {
+    DynamicArray<int> source = iota(1000);
+    const int* original = source.data();
+    SharedArray<int> shared(std::move(source));
+    EXPECT_EQ(shared.view().data(), original);
+
+    std::vector<SharedArray<int>> stages(6, shared);
+    EXPECT_EQ(shared.useCount(), 7);
+    for (const SharedArray<int>& stage : stages) EXPECT_EQ(stage.view().data(), original);
+
+    stages[2].set(0, -1);
+    EXPECT_NE(stages[2].view().data(), original);
+    EXPECT_EQ(stages[2][0], -1);
+    EXPECT_EQ(shared[0], 0);
+    EXPECT_EQ(shared.useCount(), 6);
+
+    stages[2].mutableArray().push_back(7);
+    EXPECT_EQ(stages[2].size(), 1001u);
+    EXPECT_FALSE(stages[2].isShared());
+
+    stages.clear();
+    EXPECT_FALSE(shared.isShared());
+    DynamicArray<int> back = std::move(shared).take();
+    EXPECT_EQ(back.data(), original);
+    EXPECT_TRUE(shared.empty());
+
+    SharedArray<int> small(iota(3));
+    DynamicArray<int> joined = small + small;
+    EXPECT_EQ(joined.size(), 6u);
+}
+
+// Test a moved-from SharedArray is a valid empty array, like after take()
+TEST(SharedArrayTest, MovedFromIsEmpty) {
+    SharedArray<int> a(iota(5));
+    SharedArray<int> b(std::move(a));
+    EXPECT_EQ(b.size(), 5u);
+    EXPECT_TRUE(a.empty());
+    EXPECT_EQ(a.view().size(), 0u);
+    std::ostringstream os;
+    os << a;
+    EXPECT_EQ(os.str(), "[]");
+
+    SharedArray<int> c(iota(2));
+    c = std::move(b);
+    EXPECT_EQ(c[4], 4);
+    EXPECT_TRUE(b.empty());
+    b.mutableArray().push_back(1);
+    EXPECT_EQ(b[0], 1);
+}
+
+// Test a copy read on another thread and then destroyed lets this one write in place without a race
+TEST(SharedArrayTest, WriteAfterOtherThreadReleases) {
+    for (int round = 0; round < 20; round++) {
+        SharedArray<int> a(iota(1000));
+        auto* b = new SharedArray<int>(a);
+        long sum = 0;
+        std::thread reader([&sum, b] {
+            for (std::size_t i = 0; i < b->size(); i++) sum += (*b)[i];
+            delete b;
+        });
+        while (a.isShared()) std::this_thread::yield();
+        a.set(0, -1); // in place: the reader's copy is gone
+        reader.join();
+        EXPECT_EQ(sum, 999L * 1000 / 2);
+        EXPECT_EQ(a[0], -1);
+    }
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
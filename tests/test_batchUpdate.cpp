@@ -0,0 +1,113 @@
+#include "gtest/gtest.h"
+#include "BatchUpdate.h"
+#include "Diagnostics.h"
+
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace oop;
+
+// Captures the global sink in out, and restores flushed, unlimited output on std::cerr after each test
+class DiagnosticsTest : public ::testing::Test {
+protected:
+    std::ostringstream out;
+
+    void TearDown() override {
+        DiagnosticsSink::global().configure(std::cerr, true);
+    }
+};
+
+// Test a large batch with errors spread over several mask words
+TEST(BatchUpdateTest, MaskAcrossWords) {
+    std::vector<Student> students;
+    for (int i = 0; i < 100; i++) students.emplace_back("Student" + std::to_string(i), 20, 5.0);
+    std::vector<std::size_t> indices;
+    std::vector<double> grades;
+    for (std::size_t i = 0; i < 1000; i++) {
+        indices.push_back(i % 150); // indices 100 to 149 are past the end
+        grades.push_back(i % 7 == 0 ? -1.0 : static_cast<double>(i % 11));
+    }
+    UpdateReport report = setGrades(students, indices, grades);
+    std::size_t badIndices = 0, badValues = 0;
+    for (std::size_t i = 0; i < indices.size(); i++) {
+        bool badIndex = indices[i] >= students.size(), badValue = !badIndex && grades[i] < 0;
+        badIndices += badIndex;
+        badValues += badValue;
+        ASSERT_EQ(report.isRefused(i), badIndex || badValue) << i;
+    }
+    EXPECT_EQ(report.errorMask.size(), 16u);
+    EXPECT_EQ(report.badIndices, badIndices);
+    EXPECT_EQ(report.badValues, badValues);
+    EXPECT_EQ(report.applied + report.refused(), 1000u);
+
+    // the last accepted update of each student wins
+    std::vector<double> expected(students.size(), 5.0);
+    for (std::size_t i = 0; i < indices.size(); i++) {
+        if (!report.isRefused(i)) expected[indices[i]] = grades[i];
+    }
+    for (std::size_t s = 0; s < students.size(); s++) {
+        ASSERT_DOUBLE_EQ(students[s].getGrade(), expected[s]);
+    }
+}
+
+// Test the batch setters of Student write nothing to the diagnostics sink
+TEST_F(DiagnosticsTest, BatchWritesNoDiagnostics) {
+    DiagnosticsSink::global().configure(out, false);
+    std::vector<Student> students{Student("Ana", 20, 5.0), Student("Bea", 21, 6.0)};
+    std::vector<std::size_t> indices{0, 1, 1, 2};
+    std::vector<int> ages{-1, 30, 200, 40};
+    UpdateReport report = setAges(students, indices, ages);
+    EXPECT_EQ(report.applied, 1u);
+    EXPECT_EQ(students[1].getAge(), 30);
+
+    std::vector<std::string_view> names{"", "Carla", "", "Dora"};
+    report = setNames(students, indices, names);
+    EXPECT_EQ(report.refusedUpdates(), (std::vector<std::size_t>{0, 2, 3}));
+    EXPECT_EQ(students[1].getName(), "Carla");
+    EXPECT_TRUE(out.str().empty());
+
+    std::ostringstream summary;
+    summary << report;
+    EXPECT_EQ(summary.str(), "1 of 4 updates applied, 1 bad indices, 2 invalid values");
+}
+
+// Test single setters report through the sink, which drops the messages over its limit and sums them up
+TEST_F(DiagnosticsTest, RateLimitedSetters) {
+    DiagnosticsSink::global().configure(out, false, 3);
+    Student student("Ana", 20, 5.0);
+    for (int i = 0; i < 10; i++) student.setAge(-1);
+    student.setGrade(11);
+    EXPECT_EQ(student.getAge(), 20);
+    EXPECT_EQ(out.str(), "Invalid age\nInvalid age\nInvalid age\n");
+    EXPECT_EQ(DiagnosticsSink::global().suppressed(), 8u);
+
+    DiagnosticsSink::global().flush();
+    EXPECT_EQ(out.str(), "Invalid age\nInvalid age\nInvalid age\n(8 more diagnostics suppressed)\n");
+}
+
+// Test a sink without limit writes every message
+TEST(DiagnosticsSinkTest, Unlimited) {
+    std::ostringstream out;
+    DiagnosticsSink sink(out, true);
+    for (int i = 0; i < 5; i++) sink.report("Invalid grade");
+    EXPECT_EQ(sink.reported(), 5u);
+    EXPECT_EQ(sink.suppressed(), 0u);
+    EXPECT_EQ(out.str().size(), 5 * std::string("Invalid grade\n").size());
+}
+
+// Test the summary of the last rate-limited second is written when the sink is destroyed
+TEST(DiagnosticsSinkTest, DestructorWritesSummary) {
+    std::ostringstream out;
+    {
+        DiagnosticsSink sink(out, false, 2);
+        for (int i = 0; i < 5; i++) sink.report("Invalid name");
+    }
+    EXPECT_EQ(out.str(), "Invalid name\nInvalid name\n(3 more diagnostics suppressed)\n");
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,139 @@
+#include "gtest/gtest.h"
+#include "CompactPerson.h"
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace oop;
+
+// Test the Person constructor moves its arguments into the members instead of copying them
+TEST(PersonTest, ConstructorMovesArguments) {
+    std::string name(64, 'n'); // too long for the small string buffer, so a copy would allocate
+    std::vector<std::string> hobbies{std::string(64, 'h'), "chess"};
+    const char* nameData = name.data();
+    const std::string* hobbyData = hobbies.data();
+
+    Person p(std::move(name), 30, std::move(hobbies));
+    EXPECT_EQ(p.name.data(), nameData);
+    EXPECT_EQ(p.hobbies.data(), hobbyData);
+    EXPECT_EQ(p.hobbies[1], "chess");
+}
+
+// Test the flat list stores the strings back to back and copies like a value
+TEST(FlatStringListTest, AppendAndCopy) {
+    FlatStringList list{"reading", "", "hiking"};
+    list.push_back("swimming");
+    ASSERT_EQ(list.size(), 4u);
+    EXPECT_EQ(list[0], "reading");
+    EXPECT_EQ(list[1], "");
+    EXPECT_EQ(list[3], "swimming");
+    EXPECT_EQ(list.characters(), 21u);
+
+    FlatStringList copy = list;
+    copy.push_back("chess");
+    EXPECT_EQ(list.size(), 4u);
+    EXPECT_EQ(copy[4], "chess");
+
+    std::vector<std::string> expected{"reading", "", "hiking", "swimming"};
+    EXPECT_EQ(list.toVector(), expected);
+    std::vector<std::string_view> seen(list.begin(), list.end());
+    EXPECT_EQ(seen.size(), 4u);
+    EXPECT_EQ(seen[2], "hiking");
+    EXPECT_EQ(FlatStringList(expected), list);
+}
+
+// Test appends grow the storage geometrically instead of reallocating on every push_back
+TEST(FlatStringListTest, GeometricGrowth) {
+    FlatStringList list;
+    std::size_t reallocations = 0, capacity = list.capacity();
+    for (int i = 0; i < 10'000; i++) {
+        list.push_back("hobby" + std::to_string(i));
+        if (list.capacity() != capacity) {
+            reallocations++;
+            capacity = list.capacity();
+        }
+    }
+    EXPECT_LE(reallocations, 32u);
+    EXPECT_EQ(list[9'999], "hobby9999");
+    EXPECT_EQ(list.size(), 10'000u);
+}
+
+// Test CompactPerson converts to and from Person
+TEST(CompactPersonTest, RoundTrip) {
+    Person person("Alice", 30, {"reading", "hiking"});
+    CompactPerson compact(person);
+    EXPECT_EQ(compact.name, "Alice");
+    EXPECT_EQ(compact.hobbies.size(), 2u);
+    EXPECT_EQ(compact.hobbies[1], "hiking");
+
+    CompactPerson copy = compact;
+    copy.hobbies.push_back("swimming");
+    EXPECT_EQ(compact.hobbies.size(), 2u);
+
+    Person back = copy.toPerson();
+    EXPECT_EQ(back.name, "Alice");
+    EXPECT_EQ(back.hobbies, (std::vector<std::string>{"reading", "hiking", "swimming"}));
+}
+
+// Test a batch built from people holds the same people in a single exactly sized buffer
+TEST(PersonBatchTest, FromPeople) {
+    std::vector<Person> people;
+    for (int i = 0; i < 1000; i++) {
+        std::vector<std::string> hobbies;
+        for (int h = 0; h < i % 4; h++) hobbies.push_back("hobby" + std::to_string(i * 10 + h));
+        people.emplace_back("person" + std::to_string(i), 20 + i % 50, std::move(hobbies));
+    }
+    PersonBatch batch = PersonBatch::from(people);
+    ASSERT_EQ(batch.size(), people.size());
+    EXPECT_EQ(batch.capacity(), people.size());
+    for (std::size_t i = 0; i < people.size(); i++) {
+        PersonBatch::PersonRef ref = batch[i];
+        ASSERT_EQ(ref.name, people[i].name);
+        ASSERT_EQ(ref.age, people[i].age);
+        ASSERT_EQ(ref.hobbies.toVector(), people[i].hobbies);
+    }
+    EXPECT_THROW(batch.add("late", 1, {}), std::length_error);
+
+    std::vector<Person> back = batch.toPeople();
+    EXPECT_EQ(back[999].hobbies, people[999].hobbies);
+}
+
+// Test the batch follows the rule of zero: copies are independent and a moved-from batch is empty
+TEST(PersonBatchTest, CopyAndMove) {
+    PersonBatch batch(3, 2, 64);
+    batch.add("Alice", 30, {"reading", "hiking"});
+    batch.add("Bob", 25, {});
+
+    PersonBatch copy = batch;
+    copy.add("Carol", 41, {});
+    EXPECT_EQ(batch.size(), 2u);
+    EXPECT_EQ(copy.size(), 3u);
+    EXPECT_EQ(copy[2].name, "Carol");
+    EXPECT_TRUE(copy[1].hobbies.empty());
+
+    PersonBatch moved = std::move(copy);
+    EXPECT_EQ(moved.size(), 3u);
+    EXPECT_EQ(moved[0].hobbies[1], "hiking");
+    EXPECT_EQ(copy.size(), 0u); // the moved-from batch is empty, not dangling
+
+    EXPECT_THROW(batch.add("Dave", 50, {"a", "b", "c"}), std::length_error); // only 1 string left
+    EXPECT_EQ(batch.size(), 2u);
+    EXPECT_THROW(PersonBatch().add("Eve", 1, {}), std::length_error);
+}
+
+// Test a batch can be built from compact people too
+TEST(PersonBatchTest, FromCompactPeople) {
+    std::vector<CompactPerson> people{{"Alice", 30, {"reading"}}, {"Bob", 25, {"chess", "go"}}};
+    PersonBatch batch = PersonBatch::from(people);
+    ASSERT_EQ(batch.size(), 2u);
+    EXPECT_EQ(batch[1].name, "Bob");
+    EXPECT_EQ(batch[1].hobbies[1], "go");
+    EXPECT_EQ(batch[0].toPerson().hobbies, (std::vector<std::string>{"reading"}));
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,133 @@
+#include "gtest/gtest.h"
+#include "ConcurrentArray.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace oop;
+
+// Test single-threaded appends get consecutive indices across segment boundaries
+TEST(ConcurrentArrayTest, SequentialPush) {
+    ConcurrentArray<int, 4> a;
+    for (int i = 0; i < 100; i++) {
+        EXPECT_EQ(a.push_back(i * 2), static_cast<std::size_t>(i));
+    }
+    EXPECT_EQ(a.size(), 100u);
+    EXPECT_EQ(a.publishedPrefix(), 100u);
+    for (int i = 0; i < 100; i++) {
+        EXPECT_EQ(a[i], i * 2);
+    }
+    EXPECT_TRUE(a.isPublished(99));
+    EXPECT_FALSE(a.isPublished(100));
+    EXPECT_EQ(a.tryGet(100), nullptr);
+    ASSERT_NE(a.tryGet(37), nullptr);
+    EXPECT_EQ(*a.tryGet(37), 74);
+
+    DynamicArray<int> copy = a.snapshot();
+    ASSERT_EQ(copy.size(), 100u);
+    EXPECT_EQ(copy[63], 126);
+}
+
+// Test references to published elements stay valid while later segments are added
+TEST(ConcurrentArrayTest, StableReferences) {
+    ConcurrentArray<std::string, 2> a;
+    a.push_back("first");
+    const std::string& first = a[0];
+    for (int i = 0; i < 1000; i++) a.push_back(std::to_string(i));
+    EXPECT_EQ(&first, &a[0]);
+    EXPECT_EQ(first, "first");
+    EXPECT_EQ(a[1000], "999");
+}
+
+// Test many producers push every value exactly once, while a reader takes snapshots of the published prefix
+TEST(ConcurrentArrayTest, StressManyProducers) {
+    constexpr int producers = 8;
+    constexpr int perProducer = 50'000;
+    ConcurrentArray<int, 64> a;
+    std::atomic<bool> done{false};
+
+    std::thread reader([&] {
+        std::size_t lastPrefix = 0;
+        while (!done.load()) {
+            DynamicArray<int> snap = a.snapshot();
+            EXPECT_GE(snap.size(), lastPrefix); // the published prefix only grows
+            lastPrefix = snap.size();
+            for (std::size_t i = 0; i < snap.size(); i++) {
+                ASSERT_GE(snap[i], 0);
+                ASSERT_LT(snap[i], producers * perProducer);
+            }
+        }
+    });
+
+    std::vector<std::thread> writers;
+    for (int p = 0; p < producers; p++) {
+        writers.emplace_back([&a, p] {
+            for (int i = 0; i < perProducer; i++) a.push_back(p * perProducer + i);
+        });
+    }
+    for (std::thread& t : writers) t.join();
+    done = true;
+    reader.join();
+
+    ASSERT_EQ(a.size(), static_cast<std::size_t>(producers * perProducer));
+    EXPECT_EQ(a.failed(), 0u);
+    DynamicArray<int> all = a.snapshot();
+    ASSERT_EQ(all.size(), a.size());
+    std::sort(all.begin(), all.end());
+    for (int i = 0; i < producers * perProducer; i++) {
+        ASSERT_EQ(all[i], i);
+    }
+}
+
+// Test each producer's own values keep their relative order
+TEST(ConcurrentArrayTest, PerProducerOrder) {
+    constexpr int producers = 4;
+    ConcurrentArray<std::pair<int, int>> a(4 * 20'000);
+    std::vector<std::thread> writers;
+    for (int p = 0; p < producers; p++) {
+        writers.emplace_back([&a, p] {
+            for (int i = 0; i < 20'000; i++) a.emplace_back(p, i);
+        });
+    }
+    for (std::thread& t : writers) t.join();
+
+    std::vector<int> next(producers, 0);
+    for (std::size_t i = 0; i < a.size(); i++) {
+        auto [p, value] = a[i];
+        ASSERT_EQ(value, next[p]++);
+    }
+}
+
+struct ThrowOnSeven {
+    std::shared_ptr<int> payload;
+    explicit ThrowOnSeven(int value) : payload(std::make_shared<int>(value)) {
+        if (value == 7) throw std::runtime_error("seven");
+    }
+};
+
+// Test a throwing constructor leaves an unpublished hole that snapshot() stops at, and nothing leaks
+TEST(ConcurrentArrayTest, ThrowingConstructorLeavesHole) {
+    ConcurrentArray<ThrowOnSeven, 4> a;
+    for (int i = 0; i < 10; i++) {
+        if (i == 7) {
+            EXPECT_THROW(a.emplace_back(i), std::runtime_error);
+        } else {
+            a.emplace_back(i);
+        }
+    }
+    EXPECT_EQ(a.size(), 10u);
+    EXPECT_EQ(a.failed(), 1u);
+    EXPECT_FALSE(a.isPublished(7));
+    EXPECT_TRUE(a.isPublished(8));
+    EXPECT_EQ(a.publishedPrefix(), 7u);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -1,5 +1,10 @@
 #include "gtest/gtest.h"
 #include "DynamicArray.h"
+#include <array>
+#include <cstddef>
+#include <sstream>
+#include <stdexcept>
+#include <string>
 
 using namespace oop;
 
@@ -7,7 +12,7 @@ using namespace oop;
 TEST(DynamicArrayTest, DefaultConstructor) {
     DynamicArray a(5); // Create DynamicArray with size 5
     EXPECT_EQ(a.size(), 5); // Size should be 5
-    for (int i = 0; i < a.size(); i++) {
+    for (std::size_t i = 0; i < a.size(); i++) {
         EXPECT_EQ(a[i], 0); // Each element should be initialized to 0
     }
 }
@@ -16,7 +21,7 @@ TEST(DynamicArrayTest, DefaultConstructor) {
 TEST(DynamicArrayTest, ConstructorWithValue) {
     DynamicArray a(5, 3); // Create DynamicArray with size 5, all elements initialized to 3
     EXPECT_EQ(a.size(), 5); // Size should be 5
-    for (int i = 0; i < a.size(); i++) {
+    for (std::size_t i = 0; i < a.size(); i++) {
         EXPECT_EQ(a[i], 3); // Each element should be initialized to 3
     }
 }
@@ -26,7 +31,7 @@ TEST(DynamicArrayTest, CopyConstructor) {
     DynamicArray a(5, 1);
     DynamicArray b(a); // Copy constructor
     EXPECT_EQ(b.size(), a.size()); // Sizes should match
-    for (int i = 0; i < b.size(); i++) {
+    for (std::size_t i = 0; i < b.size(); i++) {
         EXPECT_EQ(b[i], a[i]); // Elements should match
     }
 }
@@ -37,7 +42,7 @@ TEST(DynamicArrayTest, CopyAssignmentOperator) {
     DynamicArray b(3, 2);
     b = a; // Copy assignment
     EXPECT_EQ(b.size(), a.size()); // Sizes should match
-    for (int i = 0; i < b.size(); i++) {
+    for (std::size_t i = 0; i < b.size(); i++) {
         EXPECT_EQ(b[i], a[i]); // Elements should match
     }
 }
@@ -92,6 +97,312 @@ TEST(DynamicArrayTest, ElementAccessOperator) {
     EXPECT_EQ(a[0], 10); // Check if the modification works
 }
 
+// Test push_back grows the array geometrically instead of once per element
+TEST(DynamicArrayTest, PushBackAmortizedGrowth) {
+    DynamicArray<int> a;
+    EXPECT_EQ(a.size(), 0);
+    EXPECT_EQ(a.capacity(), DynamicArray<int>::inlineCapacity);
+
+    int reallocations = 0;
+    const int* previous = a.data();
+    for (int i = 0; i < 1000; i++) {
+        a.push_back(i);
+        if (a.data() != previous) {
+            reallocations++;
+            previous = a.data();
+        }
+    }
+    EXPECT_EQ(a.size(), 1000);
+    EXPECT_GE(a.capacity(), a.size());
+    EXPECT_LE(reallocations, 10); // log2(1000) growth steps, not 1000
+    for (int i = 0; i < 1000; i++) {
+        EXPECT_EQ(a[i], i);
+    }
+}
+
+// Test reserve and shrink_to_fit
+TEST(DynamicArrayTest, ReserveAndShrinkToFit) {
+    DynamicArray<int> a(3, 7);
+    a.reserve(100);
+    EXPECT_EQ(a.capacity(), 100);
+    EXPECT_EQ(a.size(), 3);
+
+    const int* storage = a.data();
+    for (int i = 0; i < 97; i++) {
+        a.push_back(i);
+    }
+    EXPECT_EQ(a.data(), storage); // no reallocation within the reserved capacity
+
+    a.pop_back();
+    a.shrink_to_fit();
+    EXPECT_EQ(a.capacity(), 99);
+    EXPECT_EQ(a[0], 7);
+    EXPECT_EQ(a[98], 95);
+}
+
+// Test pushing an element of the array itself while it reallocates
+TEST(DynamicArrayTest, PushBackOwnElement) {
+    DynamicArray<std::string> a;
+    a.push_back("first");
+    while (a.size() < a.capacity()) {
+        a.push_back("filler");
+    }
+    a.push_back(a[0]); // forces a reallocation while reading from the old buffer
+    EXPECT_EQ(a[a.size() - 1], "first");
+}
+
+// Helper type that counts how often it is copied and moved
+struct CopyMoveCounter {
+    static inline int copies = 0;
+    static inline int moves = 0;
+    int value;
+
+    CopyMoveCounter(int value) : value(value) {}
+    CopyMoveCounter(const CopyMoveCounter& other) : value(other.value) { copies++; }
+    CopyMoveCounter(CopyMoveCounter&& other) noexcept : value(other.value) { moves++; }
+    CopyMoveCounter& operator=(const CopyMoveCounter&) = default;
+    CopyMoveCounter& operator=(CopyMoveCounter&&) = default;
+};
+
+// Test nothrow-movable elements are moved, not copied, when the storage grows
+TEST(DynamicArrayTest, ReallocationMovesElements) {
+    DynamicArray<CopyMoveCounter> a;
+    CopyMoveCounter::copies = 0;
+    CopyMoveCounter::moves = 0;
+    for (int i = 0; i < 100; i++) {
+        a.emplace_back(i);
+    }
+    EXPECT_EQ(CopyMoveCounter::copies, 0);
+    EXPECT_GT(CopyMoveCounter::moves, 0);
+    EXPECT_EQ(a[42].value, 42);
+}
+
+// Test copy assignment into arrays with smaller and larger capacity
+TEST(DynamicArrayTest, CopyAssignmentReusesStorage) {
+    DynamicArray<std::string> big(10, "big");
+    DynamicArray<std::string> small(2, "small");
+
+    big = small;
+    EXPECT_EQ(big.size(), 2);
+    EXPECT_EQ(big.capacity(), 10); // the old buffer is reused instead of leaked
+    EXPECT_EQ(big[1], "small");
+
+    DynamicArray<std::string> other(5, "other");
+    small = other;
+    EXPECT_EQ(small.size(), 5);
+    EXPECT_EQ(small[4], "other");
+}
+
+// Allocator that counts the allocations made through it
+template<typename T>
+struct CountingAllocator {
+    using value_type = T;
+    static inline int allocations = 0;
+
+    CountingAllocator() = default;
+    template<typename U>
+    CountingAllocator(const CountingAllocator<U>&) {}
+
+    T* allocate(std::size_t n) {
+        allocations++;
+        return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T* p, std::size_t n) { std::allocator<T>().deallocate(p, n); }
+
+    bool operator==(const CountingAllocator&) const { return true; }
+};
+
+// Test a chain of additions allocates once, with the exact final size
+TEST(DynamicArrayTest, AdditionChainAllocatesOnce) {
+    using CountedArray = DynamicArray<int, CountingAllocator<int>, 0>; // heap only
+    CountedArray a(3, 1), b(2, 2), c(4, 3), d(1, 4);
+
+    CountingAllocator<int>::allocations = 0;
+    CountedArray e = a + b + c + d;
+    EXPECT_EQ(CountingAllocator<int>::allocations, 1);
+    EXPECT_EQ(e.size(), 10);
+    EXPECT_EQ(e.capacity(), 10);
+
+    std::stringstream ss;
+    ss << e;
+    EXPECT_EQ(ss.str(), "[1, 1, 1, 2, 2, 3, 3, 3, 3, 4]");
+}
+
+// Test a concatenation can be streamed and iterated without materializing it
+TEST(DynamicArrayTest, LazyConcatenationIsNotMaterialized) {
+    using CountedArray = DynamicArray<int, CountingAllocator<int>, 0>; // heap only
+    CountedArray a(2, 5), b(1, 6);
+
+    CountingAllocator<int>::allocations = 0;
+    std::stringstream ss;
+    ss << a + b + a;
+    EXPECT_EQ(ss.str(), "[5, 5, 6, 5, 5]");
+
+    int sum = 0;
+    auto expr = a + b;
+    for (int value : expr) {
+        sum += value;
+    }
+    EXPECT_EQ(sum, 16);
+    EXPECT_EQ(expr[2], 6);
+    EXPECT_EQ(CountingAllocator<int>::allocations, 0);
+}
+
+// Test temporaries in a chain are kept alive by the expression
+TEST(DynamicArrayTest, AdditionWithTemporaries) {
+    DynamicArray a(2, 1);
+    auto expr = a + DynamicArray(3, 2) + DynamicArray(1, 3); // temporaries are moved into the expression
+    DynamicArray b = expr;
+    EXPECT_EQ(b.size(), 6);
+    EXPECT_EQ(b[1], 1);
+    EXPECT_EQ(b[4], 2);
+    EXPECT_EQ(b[5], 3);
+}
+
+// Test assigning a concatenation that reads the array being assigned
+TEST(DynamicArrayTest, AdditionAssignmentToOperand) {
+    DynamicArray a(2, 1);
+    DynamicArray b(1, 2);
+    a = a + b + a;
+    std::stringstream ss;
+    ss << a;
+    EXPECT_EQ(ss.str(), "[1, 1, 2, 1, 1]");
+}
+
+// Test addition operator of DynamicArrayVector, alone and mixed with DynamicArray
+TEST(DynamicArrayVectorTest, AdditionOperator) {
+    DynamicArrayVector a(3, 1);
+    DynamicArrayVector b(2, 2);
+    DynamicArrayVector c = a + b;
+    EXPECT_EQ(c.size(), 5);
+    EXPECT_EQ(c[2], 1);
+    EXPECT_EQ(c[3], 2);
+
+    DynamicArray d(1, 9);
+    DynamicArray e = d + a + b;
+    std::stringstream ss;
+    ss << e;
+    EXPECT_EQ(ss.str(), "[9, 1, 1, 1, 2, 2]");
+}
+
+// Test arrays that fit in the inline buffer never allocate
+TEST(DynamicArrayTest, SmallArraysDoNotAllocate) {
+    using SmallArray = DynamicArray<int, CountingAllocator<int>, 16>;
+    CountingAllocator<int>::allocations = 0;
+
+    SmallArray a(10, 1);
+    SmallArray b(a); // copy
+    SmallArray c(std::move(b)); // move
+    SmallArray d(4);
+    d = a; // copy assignment
+    d = std::move(c); // move assignment
+    SmallArray e = a + SmallArray(5, 2) + SmallArray{}; // concatenation of 15 elements
+
+    SmallArray f;
+    for (int i = 0; i < 16; i++) {
+        f.push_back(i);
+    }
+
+    EXPECT_EQ(CountingAllocator<int>::allocations, 0);
+    EXPECT_EQ(d.size(), 10);
+    EXPECT_EQ(e.size(), 15);
+    EXPECT_EQ(e[14], 2);
+    EXPECT_EQ(f[15], 15);
+    EXPECT_EQ(f.capacity(), 16);
+
+    f.push_back(16); // first element that does not fit
+    EXPECT_EQ(CountingAllocator<int>::allocations, 1);
+    EXPECT_GT(f.capacity(), 16);
+}
+
+// Test copies and moves between inline and heap arrays
+TEST(DynamicArrayTest, InlineAndHeapTransitions) {
+    using SmallArray = DynamicArray<std::string, std::allocator<std::string>, 4>;
+    SmallArray small(3, "inline");
+    SmallArray large(20, "heap");
+
+    SmallArray a(large);
+    a = small; // heap array receiving inline contents keeps its buffer
+    EXPECT_EQ(a.size(), 3);
+    EXPECT_EQ(a[2], "inline");
+
+    SmallArray b(small);
+    b = large; // inline array receiving heap contents allocates
+    EXPECT_EQ(b.size(), 20);
+    EXPECT_EQ(b[19], "heap");
+
+    SmallArray c(std::move(small)); // inline elements are moved one by one
+    EXPECT_EQ(c.size(), 3);
+    EXPECT_EQ(c[0], "inline");
+    EXPECT_EQ(small.size(), 0);
+
+    const std::string* heapStorage = large.data();
+    SmallArray d(std::move(large)); // heap buffer is stolen
+    EXPECT_EQ(d.data(), heapStorage);
+    EXPECT_EQ(large.size(), 0);
+
+    c = std::move(d);
+    EXPECT_EQ(c.size(), 20);
+    d = std::move(c);
+    EXPECT_EQ(d.size(), 20);
+    EXPECT_EQ(d[0], "heap");
+
+    while (d.size() > 2) {
+        d.pop_back();
+    }
+    d.shrink_to_fit(); // elements move back into the inline buffer
+    EXPECT_EQ(d.capacity(), 4);
+    EXPECT_EQ(d[1], "heap");
+}
+
+// Test arrays created like createRandomArray() in the demo stay off the heap by default
+TEST(DynamicArrayTest, DefaultInlineCapacity) {
+    EXPECT_GE(DynamicArray<int>::inlineCapacity, 10);
+    DynamicArray<int> a(10);
+    EXPECT_EQ(a.capacity(), DynamicArray<int>::inlineCapacity);
+    EXPECT_EQ((defaultInlineCapacity<std::array<char, 100>>), 0); // large elements always use the heap
+}
+
+// A lookup table computed by the compiler
+constexpr auto squares = makeStaticArray<8>([](std::size_t i) { return static_cast<int>(i * i); });
+static_assert(squares.size() == 8 && squares[7] == 49);
+static_assert((StaticArray<int, 2>{1, 2} + StaticArray<int, 3>{3, 4, 5}) == StaticArray<int, 5>{1, 2, 3, 4, 5});
+static_assert(std::is_same_v<decltype(StaticArray{1, 2} + squares), StaticArray<int, 10>>);
+
+// Test StaticArray has the interface of DynamicArray and mixes with it in concatenations
+TEST(StaticArrayTest, SameInterfaceAsDynamicArray) {
+    StaticArray<int, 3> a{1, 2, 3};
+    a[0] = 10;
+    EXPECT_EQ(a.size(), 3u);
+    EXPECT_THROW(a.at(3), std::out_of_range);
+
+    std::ostringstream out;
+    out << a;
+    EXPECT_EQ(out.str(), "[10, 2, 3]");
+
+    StaticArray<int, 6> joined = a + a; // eager, no heap memory
+    EXPECT_EQ(joined[5], 3);
+
+    DynamicArray<int> dynamic{7, 8};
+    DynamicArray<int> mixed = a + dynamic; // any other operand goes through the lazy concatenation
+    EXPECT_EQ(mixed.size(), 5u);
+    EXPECT_EQ(mixed[4], 8);
+}
+
+// Test a StaticArray converts to a DynamicArray with one copy, inline when it fits
+TEST(StaticArrayTest, ConvertsToDynamicArray) {
+    DynamicArray copy = squares;
+    static_assert(std::is_same_v<decltype(copy), DynamicArray<int>>);
+    ASSERT_EQ(copy.size(), squares.size());
+    EXPECT_EQ(copy[3], 9);
+    EXPECT_EQ(copy.capacity(), DynamicArray<int>::inlineCapacity);
+
+    StaticArray<std::string, 2> words{"static", "array"};
+    DynamicArray<std::string> strings = words;
+    EXPECT_EQ(strings[1], "array");
+    EXPECT_EQ(words[1], "array");
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
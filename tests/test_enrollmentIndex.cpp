@@ -0,0 +1,100 @@
+#include "gtest/gtest.h"
+#include "CourseCatalog.h"
+#include "EnrollmentIndex.h"
+#include "Student.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace oop;
+
+// Test equal courses share an ID and the catalog resolves IDs back to courses
+TEST(CourseCatalogTest, InternsCourses) {
+    CourseCatalog catalog;
+    CourseCatalog::Id hpc = catalog.intern("High Performance Computing", 2024);
+    CourseCatalog::Id hpcOld = catalog.intern("High Performance Computing", 2023);
+    CourseCatalog::Id prog = catalog.intern("Computer Programming 2", 2024);
+
+    EXPECT_EQ(catalog.intern(std::string("High Performance Computing"), 2024), hpc);
+    EXPECT_NE(hpc, hpcOld);
+    EXPECT_EQ(catalog.size(), 3u);
+    EXPECT_EQ(catalog.get(prog).name, "Computer Programming 2");
+    EXPECT_EQ(catalog.get(hpcOld).year, 2023);
+    EXPECT_EQ(catalog.find("High Performance Computing", 2023), hpcOld);
+    EXPECT_FALSE(catalog.find("High Performance Computing", 2022).has_value());
+    EXPECT_FALSE(catalog.find("Databases", 2024).has_value());
+}
+
+// Test concurrent interning gives one ID per course
+TEST(CourseCatalogTest, ConcurrentIntern) {
+    CourseCatalog catalog;
+    std::vector<std::vector<CourseCatalog::Id>> ids(4);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < 200; i++) ids[t].push_back(catalog.intern("Course " + std::to_string(i % 50), 2000 + i % 3));
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    EXPECT_EQ(catalog.size(), 150u);
+    for (int t = 1; t < 4; t++) EXPECT_EQ(ids[t], ids[0]);
+}
+
+// Test both directions of the index and the co-enrollment queries
+TEST(EnrollmentIndexTest, Queries) {
+    using E = EnrollmentIndex::Enrollment;
+    EnrollmentIndex index({{7, 2}, {3, 0}, {3, 2}, {5, 1}, {5, 2}, {3, 2}, {7, 0}});
+
+    EXPECT_EQ(index.size(), 6u);
+    EXPECT_EQ(index.studentCount(), 3u);
+    EXPECT_EQ(index.courseCount(), 3u);
+    EXPECT_EQ(std::vector<CourseCatalog::Id>(index.coursesOf(3).begin(), index.coursesOf(3).end()),
+              (std::vector<CourseCatalog::Id>{0, 2}));
+    EXPECT_EQ(std::vector<EnrollmentIndex::StudentId>(index.studentsIn(2).begin(), index.studentsIn(2).end()),
+              (std::vector<EnrollmentIndex::StudentId>{3, 5, 7}));
+    EXPECT_TRUE(index.coursesOf(4).empty());
+    EXPECT_TRUE(index.studentsIn(9).empty());
+    EXPECT_TRUE(index.isEnrolled(5, 1));
+    EXPECT_FALSE(index.isEnrolled(3, 1));
+    EXPECT_EQ(index.sharedCourses(3, 7), (std::vector<CourseCatalog::Id>{0, 2}));
+    EXPECT_EQ(index.countCoEnrolled(0, 2), 2u);
+    EXPECT_EQ(index.countCoEnrolled(1, 0), 0u);
+    EXPECT_EQ(index.classmatesOf(5), (std::vector<EnrollmentIndex::StudentId>{3, 7}));
+
+    EnrollmentIndex empty(std::vector<E>{});
+    EXPECT_EQ(empty.size(), 0u);
+    EXPECT_EQ(empty.courseCount(), 0u);
+    EXPECT_TRUE(EnrollmentIndex().coursesOf(1).empty());
+}
+
+// Test an index built from students and printing the courses from it
+TEST(EnrollmentIndexTest, FromStudents) {
+    Student::Course hpc("High Performance Computing", 2024);
+    Student::Course prog("Computer Programming 2", 2024);
+    std::vector<Student> students;
+    students.emplace_back("Alice", 20, 8.0);
+    students.emplace_back("Bob", 21, 7.0);
+    students.emplace_back("Carol", 22, 6.0);
+    students[0].enroll(hpc);
+    students[0].enroll(prog);
+    students[1].enroll(hpc);
+
+    EnrollmentIndex index = EnrollmentIndex::fromStudents(students);
+    CourseCatalog::Id hpcId = *CourseCatalog::global().find("High Performance Computing", 2024);
+    EXPECT_EQ(index.studentsIn(hpcId).size(), 2u);
+    EXPECT_TRUE(index.isEnrolled(students[1].getId(), hpcId));
+    EXPECT_EQ(index.coursesOf(students[2].getId()).size(), 0u);
+    EXPECT_EQ(index.sharedCourses(students[0].getId(), students[1].getId()), (std::vector<CourseCatalog::Id>{hpcId}));
+
+    testing::internal::CaptureStdout();
+    students[0].printCourses(index);
+    std::string printed = testing::internal::GetCapturedStdout();
+    EXPECT_NE(printed.find("- High Performance Computing (Year: 2024)"), std::string::npos);
+    EXPECT_NE(printed.find("- Computer Programming 2 (Year: 2024)"), std::string::npos);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
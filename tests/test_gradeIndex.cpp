@@ -0,0 +1,160 @@
+#include "gtest/gtest.h"
+#include "GradeIndex.h"
+#include "Student.h"
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace oop;
+
+// Test rank, percentile and count queries on a small cohort with ties
+TEST(GradeIndexTest, RankAndPercentile) {
+    GradeIndex index;
+    Student a("Alice", 20, 9.5), b("Bob", 21, 7.25), c("Carol", 22, 7.25), d("Dave", 23, 3.0);
+    for (const Student* s : {&a, &b, &c, &d}) index.insert(*s);
+
+    EXPECT_EQ(index.size(), 4u);
+    EXPECT_EQ(index.rankOf(a), 1u);
+    EXPECT_EQ(index.rankOf(b), 2u);
+    EXPECT_EQ(index.rankOf(c), 2u);
+    EXPECT_EQ(index.rankOf(d), 4u);
+    EXPECT_DOUBLE_EQ(index.percentileOf(a), 75.0);
+    EXPECT_DOUBLE_EQ(index.percentileOf(b), 25.0);
+    EXPECT_DOUBLE_EQ(index.percentileOf(d), 0.0);
+    EXPECT_EQ(index.countAbove(7.25), 1u);
+    EXPECT_EQ(index.countAbove(7.2), 3u);
+    EXPECT_DOUBLE_EQ(index.gradeAtRank(1), 9.5);
+    EXPECT_DOUBLE_EQ(index.gradeAtRank(4), 3.0);
+    EXPECT_DOUBLE_EQ(index.gradeAtPercentile(50), 7.25);
+    EXPECT_DOUBLE_EQ(index.gradeAtPercentile(100), 9.5);
+    EXPECT_THROW(index.gradeAtRank(5), std::out_of_range);
+
+    Student outsider("Eve", 20, 5.0);
+    EXPECT_THROW(index.rankOf(outsider), std::out_of_range);
+}
+
+// Test top-K returns the best grades in order, ties ordered by ID
+TEST(GradeIndexTest, TopK) {
+    GradeIndex index;
+    std::vector<Student> cohort;
+    for (int i = 0; i <= 100; i++) cohort.emplace_back("Student", 20, i * 0.1);
+    for (const Student& s : cohort) index.insert(s);
+
+    std::vector<GradeIndex::Entry> top = index.topK(3);
+    ASSERT_EQ(top.size(), 3u);
+    EXPECT_DOUBLE_EQ(top[0].grade, 10.0);
+    EXPECT_DOUBLE_EQ(top[1].grade, 9.9);
+    EXPECT_DOUBLE_EQ(top[2].grade, 9.8);
+    EXPECT_EQ(top[0].id, cohort[100].getId());
+    EXPECT_EQ(index.topK(1000).size(), cohort.size());
+}
+
+// Test the index follows grade changes, moves and destructions of tracked students
+TEST(GradeIndexTest, FollowsStudents) {
+    GradeIndex index;
+    Student a("Alice", 20, 5.0), b("Bob", 21, 6.0);
+    index.insert(a);
+    index.insert(b);
+    EXPECT_EQ(index.rankOf(a), 2u);
+
+    a.setGrade(8.0);
+    EXPECT_EQ(index.rankOf(a), 1u);
+    EXPECT_EQ(index.rankOf(b), 2u);
+
+    Student moved = std::move(a);
+    EXPECT_TRUE(index.contains(moved));
+    EXPECT_FALSE(index.contains(a));
+    EXPECT_EQ(index.rankOf(moved), 1u);
+
+    Student copy = b;
+    EXPECT_FALSE(index.contains(copy));
+    {
+        Student temporary("Tmp", 20, 9.0);
+        index.insert(temporary);
+        EXPECT_EQ(index.size(), 3u);
+    }
+    EXPECT_EQ(index.size(), 2u);
+
+    moved = std::move(copy);
+    EXPECT_EQ(index.size(), 1u);
+    EXPECT_TRUE(index.erase(b));
+    EXPECT_EQ(index.size(), 0u);
+}
+
+// Test the Fenwick queries agree with sorting on random grades
+TEST(GradeIndexTest, MatchesSorting) {
+    GradeIndex index;
+    Random random(42);
+    std::vector<Student> cohort(2000);
+    for (Student& s : cohort) {
+        s.randomize(random);
+        index.insert(s);
+    }
+    for (int i = 0; i < 500; i++) cohort[random.getInt(0, 1999)].setGrade(random.getDouble(0.0, 10.0));
+
+    std::vector<double> sorted;
+    for (const Student& s : cohort) sorted.push_back(s.getGrade());
+    std::sort(sorted.begin(), sorted.end(), std::greater<>());
+    for (std::size_t rank = 1; rank <= sorted.size(); rank += 97) {
+        EXPECT_DOUBLE_EQ(index.gradeAtRank(rank), sorted[rank - 1]);
+    }
+    for (int i = 0; i < 2000; i += 113) {
+        double grade = cohort[i].getGrade();
+        std::size_t above = std::count_if(sorted.begin(), sorted.end(), [&](double g) { return g > grade; });
+        EXPECT_EQ(index.rankOf(cohort[i]), above + 1);
+    }
+}
+
+// Test concurrent grade changes keep the index consistent
+TEST(GradeIndexTest, ConcurrentUpdates) {
+    GradeIndex index;
+    std::vector<Student> cohort(400);
+    for (const Student& s : cohort) index.insert(s);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&, t] {
+            Random random(t);
+            for (int i = t * 100; i < (t + 1) * 100; i++) {
+                for (int j = 0; j < 20; j++) cohort[i].setGrade(random.getDouble(0.0, 10.0));
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    EXPECT_EQ(index.size(), cohort.size());
+    double best = 0.0;
+    for (const Student& s : cohort) best = std::max(best, s.getGrade());
+    EXPECT_DOUBLE_EQ(index.gradeAtRank(1), best);
+}
+
+// Test threads asking a new student for its ID at the same time all get the same one, and the index finds it once
+TEST(GradeIndexTest, ConcurrentFirstId) {
+    for (int round = 0; round < 50; round++) {
+        GradeIndex index;
+        Student student;
+        std::vector<Student::Id> ids(4);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; t++) {
+            threads.emplace_back([&, t] {
+                ids[t] = student.getId();
+                index.insert(student);
+            });
+        }
+        for (auto& thread : threads) thread.join();
+
+        EXPECT_NE(ids[0], Student::noId);
+        EXPECT_EQ(std::count(ids.begin(), ids.end(), ids[0]), 4);
+        EXPECT_EQ(student.getId(), ids[0]);
+        EXPECT_EQ(index.size(), 1u);
+    }
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,112 @@
+#include "gtest/gtest.h"
+#include "GradeStats.h"
+
+#include <cmath>
+#include <thread>
+#include <vector>
+
+using namespace oop;
+
+// Mean and population variance computed by a scan, to check the incremental statistics
+static void expectMatchesScan(const GradeStats& stats, const std::vector<Student>& students) {
+    double sum = 0;
+    for (const Student& s : students) sum += s.getGrade();
+    double mean = students.empty() ? 0.0 : sum / static_cast<double>(students.size());
+    double squares = 0;
+    for (const Student& s : students) squares += (s.getGrade() - mean) * (s.getGrade() - mean);
+    GradeStats::Snapshot snapshot = stats.snapshot();
+    ASSERT_EQ(snapshot.count, static_cast<std::int64_t>(students.size()));
+    EXPECT_NEAR(snapshot.sum, sum, 1e-6);
+    EXPECT_NEAR(snapshot.mean(), mean, 1e-9);
+    EXPECT_NEAR(snapshot.variance(), students.empty() ? 0.0 : squares / static_cast<double>(students.size()), 1e-9);
+    std::int64_t inBins = 0;
+    for (std::int64_t n : snapshot.histogram) inBins += n;
+    EXPECT_EQ(inBins, snapshot.count);
+}
+
+// Test construction, setGrade and destruction keep the statistics equal to a scan
+TEST(GradeStatsTest, FollowsLifecycle) {
+    GradeStats stats;
+    std::vector<Student> students;
+    students.reserve(100);
+    for (int i = 0; i < 100; i++) students.emplace_back("Student", 20, (i % 21) * 0.5);
+    expectMatchesScan(stats, students);
+
+    for (int i = 0; i < 100; i += 3) students[i].setGrade(10.0 - students[i].getGrade());
+    students[5].setGrade(42.0); // refused, nothing changes
+    expectMatchesScan(stats, students);
+
+    students.erase(students.begin(), students.begin() + 40); // moves and destructions
+    expectMatchesScan(stats, students);
+
+    students.clear();
+    EXPECT_EQ(stats.count(), 0);
+    EXPECT_DOUBLE_EQ(stats.variance(), 0.0);
+}
+
+// Test the histogram bins and the percentiles estimated from them
+TEST(GradeStatsTest, HistogramAndPercentiles) {
+    GradeStats stats;
+    std::vector<Student> students;
+    students.reserve(1000);
+    for (int i = 0; i < 1000; i++) students.emplace_back("Student", 20, i / 100.0); // uniform over [0, 10)
+    GradeStats::Snapshot snapshot = stats.snapshot();
+    for (std::int64_t n : snapshot.histogram) EXPECT_EQ(n, 50);
+    EXPECT_NEAR(snapshot.percentile(50), 5.0, 0.01);
+    EXPECT_NEAR(snapshot.percentile(90), 9.0, 0.01);
+    EXPECT_DOUBLE_EQ(snapshot.percentile(0), 0.0);
+    EXPECT_NEAR(snapshot.stddev(), std::sqrt((100.0 - 0.01) / 12.0), 1e-3);
+
+    Student top("Top", 20, 10.0);
+    EXPECT_EQ(stats.snapshot().histogram[GradeStats::binCount - 1], 51);
+}
+
+// Test students created before the statistics are counted once tracked
+TEST(GradeStatsTest, TrackExisting) {
+    std::vector<Student> students{Student("Ana", 20, 4.0), Student("Bea", 21, 8.0)};
+    GradeStats stats;
+    EXPECT_EQ(stats.count(), 0);
+    stats.track(students);
+    expectMatchesScan(stats, students);
+    students[0].setGrade(6.0);
+    expectMatchesScan(stats, students);
+}
+
+// Test partial aggregates of many threads, with students created on one thread and destroyed on another
+TEST(GradeStatsTest, ManyProducers) {
+    GradeStats stats;
+    constexpr int threads = 8, perThread = 2000;
+    std::vector<std::vector<Student>> made(threads);
+    {
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; t++) {
+            workers.emplace_back([&, t] {
+                Random random(static_cast<std::uint64_t>(t));
+                made[t].reserve(perThread);
+                for (int i = 0; i < perThread; i++) made[t].emplace_back("Student", 20, random.getDouble(0.0, 10.0));
+                for (int i = 0; i < perThread; i += 2) made[t][i].setGrade(random.getDouble(0.0, 10.0));
+            });
+        }
+        for (std::thread& w : workers) w.join();
+    }
+    {
+        // each thread destroys the students made by the next one
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; t++) {
+            workers.emplace_back([&, t] { made[(t + 1) % threads].resize(perThread / 4); });
+        }
+        for (std::thread& w : workers) w.join();
+    }
+    std::vector<Student> live;
+    live.reserve(threads * perThread / 4);
+    for (std::vector<Student>& v : made) {
+        for (Student& s : v) live.push_back(s); // copies count too
+    }
+    for (std::vector<Student>& v : made) v.clear();
+    expectMatchesScan(stats, live);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,108 @@
+#include "gtest/gtest.h"
+#include "DynamicArray.h"
+#include "InstanceCounter.h"
+#include "Person.h"
+#include "Student.h"
+
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace oop;
+
+// Difference between two snapshots of the counters
+InstanceStats operator-(const InstanceStats& a, const InstanceStats& b) {
+    return {a.live - b.live, a.created - b.created, a.copied - b.copied, a.moved - b.moved, a.destroyed - b.destroyed};
+}
+
+// Test the sharded counter adds up increments from many threads
+TEST(ShardedCounterTest, ConcurrentIncrements) {
+    ShardedCounter counter;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; t++) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 10'000; i++) counter.add();
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    counter.add(-5);
+    EXPECT_EQ(counter.read(), 80'000 - 5);
+}
+
+// Test students are counted on construction, copy, move and destruction
+TEST(InstanceCounterTest, Student) {
+    InstanceStats before = Student::instanceStats();
+    int totalBefore = Student::getTotalStudents();
+    {
+        Student a("Alice", 20, 8.0);
+        Student b = a;
+        Student c = std::move(b);
+        a = c;
+        c = std::move(a);
+        EXPECT_EQ(Student::getTotalStudents(), totalBefore + 3);
+    }
+    InstanceStats delta = Student::instanceStats() - before;
+    EXPECT_EQ(delta.created, 3);
+    EXPECT_EQ(delta.copied, 2);
+    EXPECT_EQ(delta.moved, 2);
+    EXPECT_EQ(delta.destroyed, 3);
+    EXPECT_EQ(delta.live, 0);
+}
+
+// Test every DynamicArray instantiation is counted, with its own copy and move operations
+TEST(InstanceCounterTest, DynamicArray) {
+    InstanceStats before = DynamicArray<int>::instanceStats();
+    {
+        DynamicArray<int> a = {1, 2, 3};
+        DynamicArray<double> b(100);
+        DynamicArray<int> c(a);
+        DynamicArray<int> d(std::move(c));
+        d = a;
+        a = std::move(d);
+        InstanceStats delta = DynamicArray<char>::instanceStats() - before;
+        EXPECT_EQ(delta.live, 4);
+    }
+    InstanceStats delta = DynamicArray<int>::instanceStats() - before;
+    EXPECT_EQ(delta.created, 4);
+    EXPECT_EQ(delta.copied, 2);
+    EXPECT_EQ(delta.moved, 2);
+    EXPECT_EQ(delta.live, 0);
+}
+
+// Test Person is counted through the compiler-generated operations
+TEST(InstanceCounterTest, Person) {
+    InstanceStats before = Person::instanceStats();
+    {
+        std::vector<Person> people;
+        people.reserve(2);
+        people.emplace_back("Alice", 30, std::vector<std::string>{"reading"});
+        Person copy = people[0];
+        people.push_back(std::move(copy));
+    }
+    InstanceStats delta = Person::instanceStats() - before;
+    EXPECT_EQ(delta.created, 3);
+    EXPECT_EQ(delta.copied, 1);
+    EXPECT_EQ(delta.moved, 1);
+    EXPECT_EQ(delta.live, 0);
+}
+
+// Test counts stay exact when students are created and destroyed on many threads
+TEST(InstanceCounterTest, ConcurrentStudents) {
+    InstanceStats before = Student::instanceStats();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([] {
+            std::vector<Student> students;
+            for (int i = 0; i < 1'000; i++) students.emplace_back("Bob", 20, 5.0);
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    InstanceStats delta = Student::instanceStats() - before;
+    EXPECT_EQ(delta.created - delta.moved, 4'000);
+    EXPECT_EQ(delta.live, 0);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,177 @@
+#include "gtest/gtest.h"
+#include "DynamicArray.h"
+#include "Instrumentation.h"
+#include "Person.h"
+#include "Student.h"
+
+#include <sstream>
+#include <utility>
+#include <vector>
+
+using namespace oop;
+
+static_assert(instrument::enabled, "this test must be built with OOP_INSTRUMENTATION=1");
+
+using ArrayProbe = instrument::Probe<oop::detail::DynamicArrayCounterTag>;
+
+// Test a copy allocates exactly one buffer of the right size and a move allocates nothing
+TEST(InstrumentationTest, DynamicArrayCopyAndMoveBudget) {
+    DynamicArray<int> a(100, 7);
+    instrument::ProbeStats before = ArrayProbe::stats();
+
+    DynamicArray<int> copy(a);
+    instrument::ProbeStats copied = ArrayProbe::stats() - before;
+    EXPECT_EQ(copied.copies, 1);
+    EXPECT_EQ(copied.allocations, 1);
+    EXPECT_EQ(copied.bytesAllocated, static_cast<std::int64_t>(100 * sizeof(int)));
+
+    before = ArrayProbe::stats();
+    DynamicArray<int> moved(std::move(copy));
+    instrument::ProbeStats afterMove = ArrayProbe::stats() - before;
+    EXPECT_EQ(afterMove.moves, 1);
+    EXPECT_EQ(afterMove.copies, 0);
+    EXPECT_EQ(afterMove.allocations, 0);
+}
+
+// Test copy assignment returns the old buffer, so every byte allocated in the scope is freed
+TEST(InstrumentationTest, DynamicArrayAssignmentDoesNotLeak) {
+    instrument::ProbeStats before = ArrayProbe::stats();
+    {
+        DynamicArray<int> small(50, 1);
+        DynamicArray<int> large(500, 2);
+        small = large;
+        large = DynamicArray<int>(1000, 3);
+    }
+    instrument::ProbeStats delta = ArrayProbe::stats() - before;
+    EXPECT_EQ(delta.allocations, delta.deallocations);
+    EXPECT_EQ(delta.bytesAllocated, delta.bytesFreed);
+    EXPECT_EQ(delta.copies, 1);
+}
+
+// Test a growing std::vector moves its arrays (the move constructor is noexcept) instead of copying them
+TEST(InstrumentationTest, VectorGrowthMovesArrays) {
+    static_assert(std::is_nothrow_move_constructible_v<DynamicArray<int>>);
+    std::vector<DynamicArray<int>> arrays;
+    instrument::ProbeStats before = ArrayProbe::stats();
+    for (int i = 0; i < 100; i++) arrays.emplace_back(64, i);
+    instrument::ProbeStats delta = ArrayProbe::stats() - before;
+    EXPECT_EQ(delta.copies, 0);
+    EXPECT_GT(delta.moves, 0);
+    EXPECT_EQ(delta.allocations, 100);
+}
+
+// Test the vector-based array reports the allocations of its std::vector
+TEST(InstrumentationTest, DynamicArrayVectorAllocations) {
+    instrument::ProbeStats before = instrument::stats<DynamicArrayVector>();
+    {
+        DynamicArrayVector a(256, 1);
+        DynamicArrayVector b = a;
+        EXPECT_EQ(b[255], 1);
+    }
+    instrument::ProbeStats delta = instrument::stats<DynamicArrayVector>() - before;
+    EXPECT_EQ(delta.allocations, 2);
+    EXPECT_EQ(delta.bytesAllocated, static_cast<std::int64_t>(2 * 256 * sizeof(int)));
+    EXPECT_EQ(delta.bytesFreed, delta.bytesAllocated);
+    EXPECT_EQ(delta.copies, 1);
+    EXPECT_EQ(instrument::stats("DynamicArrayVector").copies, instrument::stats<DynamicArrayVector>().copies);
+}
+
+// Test copies and moves of Student and Person are recorded, assignments included
+TEST(InstrumentationTest, StudentAndPerson) {
+    instrument::ProbeStats students = instrument::stats<Student>();
+    instrument::ProbeStats people = instrument::stats<Person>();
+    {
+        Student a("Alice", 20, 8.0);
+        Student b = a;
+        Student c = std::move(b);
+        a = c;
+        Person p("Bob", 30, {"chess"});
+        Person q = std::move(p);
+        Person r = q;
+    }
+    instrument::ProbeStats studentDelta = instrument::stats<Student>() - students;
+    instrument::ProbeStats personDelta = instrument::stats<Person>() - people;
+    EXPECT_EQ(studentDelta.copies, 2);
+    EXPECT_EQ(studentDelta.moves, 1);
+    EXPECT_EQ(personDelta.copies, 1);
+    EXPECT_EQ(personDelta.moves, 1);
+}
+
+// Test the courses of a student report their bytes, and a move allocates nothing
+TEST(InstrumentationTest, StudentCourseAllocations) {
+    using Id = CourseCatalog::Id;
+    instrument::ProbeStats before = instrument::stats<Student>();
+    {
+        Student a("Alice", 20, 8.0);
+        for (Id course = 1; course <= 3; course++) a.enroll(course);
+        instrument::ProbeStats enrolled = instrument::stats<Student>() - before;
+        EXPECT_GT(enrolled.allocations, 0);
+        EXPECT_GE(enrolled.bytesAllocated - enrolled.bytesFreed, static_cast<std::int64_t>(3 * sizeof(Id))); // the capacity may be larger
+
+        instrument::ProbeStats beforeCopy = instrument::stats<Student>();
+        Student b = a;
+        instrument::ProbeStats copied = instrument::stats<Student>() - beforeCopy;
+        EXPECT_EQ(copied.allocations, 1);
+        EXPECT_EQ(copied.bytesAllocated, static_cast<std::int64_t>(3 * sizeof(Id)));
+
+        instrument::ProbeStats beforeMove = instrument::stats<Student>();
+        Student c = std::move(b);
+        a = std::move(c);
+        instrument::ProbeStats moved = instrument::stats<Student>() - beforeMove;
+        EXPECT_EQ(moved.allocations, 0);
+        EXPECT_EQ(a.get_allocator().resource(), std::pmr::get_default_resource());
+    }
+    instrument::ProbeStats delta = instrument::stats<Student>() - before;
+    EXPECT_EQ(delta.bytesFreed, delta.bytesAllocated);
+    EXPECT_EQ(delta.allocations, delta.deallocations);
+}
+
+// Test events are attributed to the innermost tag of the thread
+TEST(InstrumentationTest, ScopedTags) {
+    DynamicArray<int> a(100, 1);
+    {
+        instrument::ScopedTag outer("outer");
+        DynamicArray<int> b = a;
+        {
+            instrument::ScopedTag inner("inner");
+            DynamicArray<int> c = a;
+            DynamicArray<int> d = a;
+            Student s("Carol", 21, 9.0);
+            Student t = s;
+        }
+    }
+    DynamicArray<int> untagged = a;
+
+    instrument::ProbeStats outer = instrument::tagStats("outer", "DynamicArray");
+    instrument::ProbeStats inner = instrument::tagStats("inner", "DynamicArray");
+    EXPECT_EQ(outer.copies, 1);
+    EXPECT_EQ(inner.copies, 2);
+    EXPECT_EQ(inner.allocations, 2);
+    EXPECT_EQ(instrument::tagStats("inner").copies, 3);
+    EXPECT_EQ(instrument::tagStats("inner", "Student").copies, 1);
+    EXPECT_EQ(instrument::tagStats("unknown").copies, 0);
+}
+
+// Test the report lists the types and the tags as JSON
+TEST(InstrumentationTest, Report) {
+    {
+        instrument::ScopedTag tag("report \"quoted\"");
+        DynamicArray<int> a(100, 1);
+        DynamicArray<int> b = a;
+    }
+    std::ostringstream report;
+    instrument::writeReport(report);
+    std::string text = report.str();
+    EXPECT_NE(text.find("\"enabled\": true"), std::string::npos);
+    EXPECT_NE(text.find("{\"type\": \"DynamicArray\", \"allocations\": "), std::string::npos);
+    EXPECT_NE(text.find("{\"tag\": \"report \\\"quoted\\\"\", \"type\": \"DynamicArray\""), std::string::npos);
+
+    instrument::reset();
+    EXPECT_EQ(ArrayProbe::stats().copies, 0);
+    EXPECT_EQ(instrument::tagStats("inner").copies, 0);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,123 @@
+#include "gtest/gtest.h"
+#include "MappedArray.h"
+#include "ArrayOps.h"
+#include "ArraySerialization.h"
+#include "TempFile.h"
+
+#include <filesystem>
+#include <numeric>
+#include <string_view>
+#include <vector>
+
+using namespace oop;
+
+// Temporary file that the tests fill with the raw ints 0, 1, 2, ...
+class MappedArrayTest : public TempFileTest {
+protected:
+    void writeInts(int n) {
+        std::vector<int> values(n);
+        std::iota(values.begin(), values.end(), 0);
+        write(std::string_view(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(int)));
+    }
+};
+
+// Test an existing file is mapped read-only with its elements in place
+TEST_F(MappedArrayTest, ReadOnly) {
+    writeInts(10'000);
+    MappedArray<int> a(path);
+    a.advise(AccessHint::Sequential);
+    EXPECT_EQ(a.size(), 10'000u);
+    EXPECT_EQ(a.getMode(), MapMode::ReadOnly);
+    EXPECT_EQ(a[1234], 1234);
+    EXPECT_EQ(oop::sum(a), 10'000LL * 9'999 / 2);
+    EXPECT_THROW(a.push_back(1), std::logic_error);
+}
+
+// Test writing through a read-only array changes the private copy of the page but not the file
+TEST_F(MappedArrayTest, ReadOnlyWritesStayPrivate) {
+    writeInts(1000);
+    {
+        MappedArray<int> a(path);
+        a[10] = -1;
+        *a.data() = -2;
+        EXPECT_EQ(a[10], -1);
+        EXPECT_EQ(a[0], -2);
+    }
+    MappedArray<int> b(path);
+    EXPECT_EQ(b[10], 10);
+    EXPECT_EQ(b[0], 0);
+}
+
+// Test writes, growth and flush reach the file and the spare capacity is trimmed on close
+TEST_F(MappedArrayTest, ReadWriteGrowth) {
+    {
+        MappedArray<int> a = MappedArray<int>::create(path, 3);
+        EXPECT_EQ(a[2], 0);
+        a[0] = 7;
+        for (int i = 0; i < 100'000; i++) a.push_back(i);
+        a.push_back(a[0]); // element of the array itself while it may be remapped
+        EXPECT_GE(a.capacity(), a.size());
+        a.flush();
+        EXPECT_EQ(std::filesystem::file_size(path), a.capacity() * sizeof(int));
+    }
+    EXPECT_EQ(std::filesystem::file_size(path), 100'004 * sizeof(int));
+
+    MappedArray<int> b(path, MapMode::ReadWrite);
+    EXPECT_EQ(b.size(), 100'004u);
+    EXPECT_EQ(b[0], 7);
+    EXPECT_EQ(b[3 + 99'999], 99'999);
+    EXPECT_EQ(b[100'003], 7);
+    b.resize(5);
+    b.resize(6);
+    EXPECT_EQ(b[5], 0);
+}
+
+// Test growing past the capacity zeroes the slots left behind by a shrinking resize
+TEST_F(MappedArrayTest, GrowingResizeZeroesOldElements) {
+    MappedArray<int> a = MappedArray<int>::create(path, 0);
+    for (int i = 100; i < 104; i++) a.push_back(i);
+    a.resize(1);
+    a.resize(a.capacity() + 1);
+    EXPECT_EQ(a[0], 100);
+    for (std::size_t i = 1; i < a.size(); i++) EXPECT_EQ(a[i], 0) << "at " << i;
+}
+
+// Test moving transfers the mapping and leaves the source closed
+TEST_F(MappedArrayTest, MoveOnly) {
+    writeInts(100);
+    MappedArray<int> a(path);
+    const int* data = a.data();
+    MappedArray<int> b(std::move(a));
+    EXPECT_FALSE(a.isOpen());
+    EXPECT_EQ(a.size(), 0u);
+    EXPECT_EQ(b.data(), data);
+
+    MappedArray<int> c = MappedArray<int>::create(path.string() + ".2", 1);
+    c = std::move(b);
+    EXPECT_EQ(c.size(), 100u);
+    EXPECT_EQ(c[99], 99);
+    std::filesystem::remove(path.string() + ".2");
+}
+
+// Test a mapped array works with concatenation and the text formatter
+TEST_F(MappedArrayTest, InteroperatesWithArrays) {
+    writeInts(3);
+    MappedArray<int> a(path);
+    DynamicArray<int> b = {3, 4};
+    DynamicArray<int> c = a + b;
+    EXPECT_EQ(formatArray(c), "[0, 1, 2, 3, 4]");
+}
+
+// Test invalid files are rejected
+TEST_F(MappedArrayTest, InvalidFiles) {
+    EXPECT_THROW(MappedArray<int>{path}, std::system_error);
+    write("abcde");
+    EXPECT_THROW(MappedArray<int>{path}, std::runtime_error);
+    MappedArray<char> chars(path);
+    EXPECT_EQ(chars.size(), 5u);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
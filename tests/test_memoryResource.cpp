@@ -0,0 +1,172 @@
+#include "gtest/gtest.h"
+#include "DynamicArray.h"
+#include "MemoryResource.h"
+#include "Student.h"
+
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+using namespace oop;
+
+// Upstream resource that counts what it hands out
+class CountingResource : public std::pmr::memory_resource {
+public:
+    std::size_t allocations = 0;
+    std::size_t bytesInUse = 0;
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        allocations++;
+        bytesInUse += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+        bytesInUse -= bytes;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+// Makes any allocation from the default resource throw while it is alive
+class NoDefaultAllocations {
+    std::pmr::memory_resource* previous;
+public:
+    NoDefaultAllocations() : previous(std::pmr::set_default_resource(std::pmr::null_memory_resource())) {}
+    ~NoDefaultAllocations() { std::pmr::set_default_resource(previous); }
+};
+
+// Test the arena returns aligned, non-overlapping memory and grows in chunks
+TEST(ArenaResourceTest, AllocatesAlignedMemoryInChunks) {
+    CountingResource upstream;
+    ArenaResource arena(1024, &upstream);
+    char* previous = nullptr;
+    for (int i = 0; i < 100; i++) {
+        auto* p = static_cast<char*>(arena.allocate(24, 16));
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p) % 16, 0u);
+        if (previous != nullptr && p > previous) {
+            EXPECT_GE(p - previous, 24);
+        }
+        previous = p;
+    }
+    EXPECT_EQ(arena.getBytesAllocated(), 2400u);
+    EXPECT_GT(upstream.allocations, 1u);
+    EXPECT_LT(upstream.allocations, 10u);
+
+    void* large = arena.allocate(1 << 20, 64);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(large) % 64, 0u);
+}
+
+// Test release gives every chunk back and the arena can be reused
+TEST(ArenaResourceTest, ReleaseFreesEverything) {
+    CountingResource upstream;
+    {
+        ArenaResource arena(1024, &upstream);
+        for (int i = 0; i < 100; i++) static_cast<void>(arena.allocate(100));
+        arena.release();
+        EXPECT_EQ(upstream.bytesInUse, 0u);
+        EXPECT_EQ(arena.getBytesAllocated(), 0u);
+        static_cast<void>(arena.allocate(100));
+        EXPECT_GT(upstream.bytesInUse, 0u);
+    }
+    EXPECT_EQ(upstream.bytesInUse, 0u);
+}
+
+// Test an arena over a caller buffer only goes upstream once the buffer is full
+TEST(ArenaResourceTest, InitialBuffer) {
+    CountingResource upstream;
+    alignas(std::max_align_t) std::byte buffer[4096];
+    ArenaResource arena(buffer, sizeof(buffer), &upstream);
+    void* p = arena.allocate(1000);
+    EXPECT_GE(static_cast<std::byte*>(p), buffer);
+    EXPECT_LT(static_cast<std::byte*>(p), buffer + sizeof(buffer));
+    EXPECT_EQ(upstream.allocations, 0u);
+    static_cast<void>(arena.allocate(4000));
+    EXPECT_EQ(upstream.allocations, 1u);
+}
+
+// Test the pool recycles freed blocks and forwards large requests
+TEST(PoolResourceTest, RecyclesBlocks) {
+    CountingResource upstream;
+    PoolResource pool(32, 16, &upstream);
+    EXPECT_EQ(pool.getBlockSize(), 32u);
+
+    std::vector<void*> blocks;
+    for (int i = 0; i < 16; i++) blocks.push_back(pool.allocate(32));
+    EXPECT_EQ(upstream.allocations, 1u);
+    EXPECT_EQ(pool.getBlocksInUse(), 16u);
+
+    void* last = blocks.back();
+    pool.deallocate(last, 32);
+    EXPECT_EQ(pool.allocate(20), last);
+    EXPECT_EQ(upstream.allocations, 1u);
+
+    void* large = pool.allocate(1000);
+    EXPECT_EQ(upstream.allocations, 2u);
+    pool.deallocate(large, 1000);
+
+    pool.release();
+    EXPECT_EQ(pool.getBlocksInUse(), 0u);
+    EXPECT_EQ(upstream.bytesInUse, 0u);
+}
+
+// Test a pmr DynamicArray takes all its memory from the arena
+TEST(PmrDynamicArrayTest, UsesTheArena) {
+    CountingResource upstream;
+    ArenaResource arena(1024, &upstream);
+    {
+        NoDefaultAllocations guard;
+        pmr::DynamicArray<int, 0> a(&arena);
+        for (int i = 0; i < 1000; i++) a.push_back(i);
+        EXPECT_EQ(a.get_allocator().resource(), &arena);
+
+        pmr::DynamicArray<int, 0> copy(a, &arena);
+        EXPECT_EQ(copy[999], 999);
+        pmr::DynamicArray<int, 0> moved(std::move(copy), &arena);
+        EXPECT_EQ(moved.size(), 1000u);
+    }
+    EXPECT_GT(arena.getBytesAllocated(), 1000 * sizeof(int));
+}
+
+// Test moving between arrays on different resources copies into the target resource
+TEST(PmrDynamicArrayTest, MoveAcrossResources) {
+    ArenaResource first;
+    ArenaResource second;
+    pmr::DynamicArray<int, 0> a(&first);
+    for (int i = 0; i < 100; i++) a.push_back(i);
+
+    pmr::DynamicArray<int, 0> b(std::move(a), &second);
+    EXPECT_EQ(b.get_allocator().resource(), &second);
+    EXPECT_EQ(b.size(), 100u);
+    EXPECT_EQ(b[42], 42);
+
+    pmr::DynamicArray<int, 0> c(&first);
+    c = b; // polymorphic_allocator is not propagated on assignment
+    EXPECT_EQ(c.get_allocator().resource(), &first);
+    EXPECT_EQ(c[99], 99);
+}
+
+// Test a pmr vector of students keeps the students and their courses in the arena
+TEST(PmrStudentTest, StudentsLiveInTheArena) {
+    ArenaResource arena;
+    NoDefaultAllocations guard;
+    std::pmr::vector<Student> students(&arena);
+    for (int i = 0; i < 100; i++) {
+        students.emplace_back("A student with a name too long for the small string buffer", 20, 7.5);
+    }
+    Student::Course course("High Performance Computing", 2024, &arena);
+    students[0].enroll(course);
+
+    EXPECT_EQ(students[0].get_allocator().resource(), &arena);
+    EXPECT_EQ(students[99].getName(), "A student with a name too long for the small string buffer");
+    EXPECT_DOUBLE_EQ(students[50].getGrade(), 7.5);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,123 @@
+#include "gtest/gtest.h"
+#include "ParallelAlgorithms.h"
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+
+using namespace oop;
+
+// Large enough to go past the serial cutoff and be split in many chunks
+constexpr std::size_t largeSize = 3'000'001;
+
+DynamicArray<int> randomArray(std::size_t n) {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> dist(-1'000'000, 1'000'000);
+    DynamicArray<int> a(n, defaultInit);
+    for (std::size_t i = 0; i < n; i++) {
+        a[i] = dist(rng);
+    }
+    return a;
+}
+
+// Test every submitted task runs exactly once, including tasks submitted from workers
+TEST(ThreadPoolTest, SubmitRunsEveryTask) {
+    std::atomic<int> counter{0};
+    {
+        ThreadPool pool(4);
+        for (int i = 0; i < 1000; i++) {
+            pool.submit([&] {
+                counter++;
+                pool.submit([&] { counter++; });
+            });
+        }
+    } // the destructor runs the remaining tasks
+    EXPECT_EQ(counter.load(), 2000);
+}
+
+// Test parallelFor covers the range once and nested calls do not deadlock
+TEST(ThreadPoolTest, NestedParallelFor) {
+    ThreadPool pool(3);
+    std::vector<std::atomic<int>> hits(10'000);
+    pool.parallelFor(0, 100, 1, [&](std::size_t first, std::size_t last) {
+        for (std::size_t outer = first; outer < last; outer++) {
+            pool.parallelFor(outer * 100, outer * 100 + 100, 7, [&](std::size_t b, std::size_t e) {
+                for (std::size_t i = b; i < e; i++) hits[i]++;
+            });
+        }
+    });
+    for (auto& hit : hits) {
+        EXPECT_EQ(hit.load(), 1);
+    }
+}
+
+// Test the first exception thrown by a chunk reaches the caller
+TEST(ThreadPoolTest, ParallelForPropagatesExceptions) {
+    ThreadPool pool(2);
+    EXPECT_THROW(pool.parallelFor(0, 1000, 10, [](std::size_t first, std::size_t) {
+        if (first == 500) throw std::runtime_error("chunk failed");
+    }), std::runtime_error);
+}
+
+// Test fill, copy and transform against the serial results
+TEST(ParallelAlgorithmsTest, FillCopyTransform) {
+    ThreadPool pool(4);
+    DynamicArray<int> a(largeSize, defaultInit);
+    parallel::fill(a, 7, pool);
+    EXPECT_EQ(oop::count_if(a, 7), largeSize);
+
+    DynamicArray<int> b = randomArray(largeSize);
+    DynamicArray<int> c = parallel::copy(b, pool);
+    EXPECT_TRUE(std::equal(b.begin(), b.end(), c.begin()));
+
+    parallel::transform(b, c, [](int x) { return 2 * x + 1; }, pool);
+    for (std::size_t i = 0; i < largeSize; i += 9973) {
+        EXPECT_EQ(c[i], 2 * b[i] + 1);
+    }
+
+    DynamicArray<int> shorter(10);
+    EXPECT_THROW(parallel::copy(b, shorter, pool), std::invalid_argument);
+}
+
+// Test reductions give the serial result
+TEST(ParallelAlgorithmsTest, Reduce) {
+    ThreadPool pool(4);
+    DynamicArray<int> a = randomArray(largeSize);
+    long long expected = std::accumulate(a.begin(), a.end(), 0LL);
+
+    EXPECT_EQ(parallel::sum(a, pool), expected);
+    EXPECT_EQ(parallel::reduce(a, 0LL, std::plus<>(), pool), expected);
+    EXPECT_EQ(parallel::reduce(a, 0, [](int x, int y) { return std::max(x, y); }, pool), oop::max(a));
+}
+
+// Test sort on sizes that do not split evenly, and with a custom ordering
+TEST(ParallelAlgorithmsTest, Sort) {
+    ThreadPool pool(5);
+    for (std::size_t n : {std::size_t{1000}, largeSize}) {
+        DynamicArray<int> a = randomArray(n);
+        DynamicArray<int> expected = a;
+        std::sort(expected.begin(), expected.end());
+
+        parallel::sort(a, std::less<>(), pool);
+        EXPECT_TRUE(std::equal(a.begin(), a.end(), expected.begin()));
+
+        parallel::sort(a, std::greater<>(), pool);
+        EXPECT_TRUE(std::is_sorted(a.begin(), a.end(), std::greater<>()));
+    }
+}
+
+// Test the algorithms also run serially on a pool without workers
+TEST(ParallelAlgorithmsTest, PoolWithoutWorkers) {
+    ThreadPool pool(0);
+    DynamicArray<int> a = randomArray(largeSize);
+    parallel::sort(a, std::less<>(), pool);
+    EXPECT_TRUE(std::is_sorted(a.begin(), a.end()));
+    EXPECT_EQ(parallel::sum(a, pool), oop::sum(a));
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,240 @@
+#include "gtest/gtest.h"
+#include "Pipeline.h"
+
+#include <algorithm>
+#include <atomic>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace oop;
+
+namespace {
+
+    StageTask produce(Channel<int>& out, int n, std::atomic<int>& sent, StageStats& stats) {
+        for (int i = 0; i < n; i++) {
+            if (!co_await out.send(i)) co_return;
+            sent++;
+            stats.add();
+        }
+        out.done();
+    }
+
+    StageTask consume(Channel<int>& in, std::vector<int>& seen, const std::atomic<int>& sent, std::size_t& maxAhead,
+                      StageStats& stats) {
+        while (std::optional<int> value = co_await in.receive()) {
+            seen.push_back(*value);
+            std::size_t produced = static_cast<std::size_t>(sent.load()); // counted after the send resumed, so it may lag
+            if (produced > seen.size()) maxAhead = std::max(maxAhead, produced - seen.size());
+            stats.add();
+        }
+    }
+
+    StageTask collect(Channel<StudentRecord>& in, std::vector<StudentRecord>& into, StageStats& stats) {
+        while (std::optional<StudentRecord> record = co_await in.receive()) {
+            into.push_back(std::move(*record));
+            stats.add();
+        }
+    }
+
+    StageTask failOnFirst(Channel<int>& in, StageStats&) {
+        co_await in.receive();
+        throw std::runtime_error("bad item");
+    }
+
+}
+
+// Test a bounded channel keeps the producer at most capacity items ahead and delivers every item in order
+TEST(PipelineTest, ChannelBackpressure) {
+    for (unsigned workers : {0u, 3u}) {
+        ThreadPool pool(workers);
+        Pipeline pipeline(pool);
+        Channel<int>& channel = pipeline.channel<int>(4);
+        std::atomic<int> sent{0};
+        std::vector<int> seen;
+        std::size_t maxAhead = 0;
+        pipeline.add("produce", [&](StageStats& s) { return produce(channel, 10'000, sent, s); });
+        pipeline.add("consume", [&](StageStats& s) { return consume(channel, seen, sent, maxAhead, s); });
+        std::vector<StageStats> report = pipeline.run();
+
+        ASSERT_EQ(seen.size(), 10'000u);
+        for (int i = 0; i < 10'000; i++) {
+            ASSERT_EQ(seen[i], i);
+        }
+        if (workers == 0) {
+            EXPECT_LE(maxAhead, 4u + 1u); // the buffer plus the item handed over when a slot frees up
+        }
+        ASSERT_EQ(report.size(), 2u);
+        EXPECT_EQ(report[0].name, "produce");
+        EXPECT_EQ(report[0].items, 10'000u);
+        EXPECT_EQ(report[1].items, 10'000u);
+        EXPECT_GT(report[1].itemsPerSecond(), 0.0);
+    }
+}
+
+// Test a channel of capacity 0 hands each item straight from sender to receiver, and several producers close it
+TEST(PipelineTest, RendezvousWithSeveralProducers) {
+    ThreadPool pool(2);
+    Pipeline pipeline(pool);
+    Channel<int>& channel = pipeline.channel<int>(0, 3);
+    std::atomic<int> sent{0};
+    std::vector<int> seen;
+    std::size_t maxAhead = 0;
+    for (int p = 0; p < 3; p++) {
+        pipeline.add("produce", [&](StageStats& s) { return produce(channel, 1000, sent, s); });
+    }
+    pipeline.add("consume", [&](StageStats& s) { return consume(channel, seen, sent, maxAhead, s); });
+    pipeline.run();
+
+    ASSERT_EQ(seen.size(), 3000u);
+    std::sort(seen.begin(), seen.end());
+    EXPECT_EQ(seen[2999], 999);
+    EXPECT_EQ(std::count(seen.begin(), seen.end(), 500), 3);
+}
+
+// Test the built-in stages validate, enroll and aggregate records, with parallel validation workers
+TEST(PipelineTest, StudentStages) {
+    std::vector<StudentRecord> records;
+    for (int i = 0; i < 5000; i++) {
+        records.push_back(StudentRecord{i % 100 == 0 ? "" : "Student" + std::to_string(i), 18 + i % 10, (i % 11) * 1.0});
+    }
+    records.push_back(StudentRecord{"Old", 121, 5.0});
+    records.push_back(StudentRecord{"High", 20, 10.5});
+    std::vector<CourseCatalog::Id> courses{CourseCatalog::global().intern("Math", 2024),
+                                           CourseCatalog::global().intern("Physics", 2024)};
+
+    ThreadPool pool(3);
+    Pipeline pipeline(pool);
+    auto& raw = pipeline.channel<StudentRecord>(64);
+    auto& valid = pipeline.channel<Student>(64, 2);
+    auto& enrolled = pipeline.channel<Student>(64);
+    GradeSummary summary;
+    pipeline.add("load", [&](StageStats& s) { return stages::fromRange(raw, records, s); });
+    for (int worker = 0; worker < 2; worker++) {
+        pipeline.add("validate", [&](StageStats& s) { return stages::validate(raw, valid, s); });
+    }
+    pipeline.add("enroll", [&](StageStats& s) { return stages::enroll(valid, enrolled, courses, 2, 7, s); });
+    pipeline.add("aggregate", [&](StageStats& s) { return stages::aggregate(enrolled, summary, s); });
+    std::vector<StageStats> report = pipeline.run();
+
+    EXPECT_EQ(report[0].items, records.size());
+    EXPECT_EQ(report[1].rejected + report[2].rejected, 52u);
+    EXPECT_EQ(report[1].items + report[2].items, 4950u);
+    EXPECT_EQ(report[4].items, 4950u);
+    EXPECT_EQ(summary.count, 4950u);
+    EXPECT_EQ(summary.enrollments, 2 * 4950u);
+    EXPECT_DOUBLE_EQ(summary.min, 0.0);
+    EXPECT_DOUBLE_EQ(summary.max, 10.0);
+    EXPECT_NEAR(summary.mean(), 5.0, 0.01);
+}
+
+// Test the generator stage is reproducible and its records are all valid students
+TEST(PipelineTest, GenerateIsReproducible) {
+    auto run = [](unsigned workers) {
+        ThreadPool pool(workers);
+        Pipeline pipeline(pool);
+        auto& raw = pipeline.channel<StudentRecord>(128);
+        auto& valid = pipeline.channel<Student>(128);
+        GradeSummary summary;
+        pipeline.add("generate", [&](StageStats& s) { return stages::generate(raw, 40'000, 42, s); });
+        pipeline.add("validate", [&](StageStats& s) { return stages::validate(raw, valid, s); });
+        pipeline.add("aggregate", [&](StageStats& s) { return stages::aggregate(valid, summary, s); });
+        std::vector<StageStats> report = pipeline.run();
+        EXPECT_EQ(report[1].rejected, 0u);
+        return summary;
+    };
+    GradeSummary serial = run(0);
+    GradeSummary parallel = run(3);
+    EXPECT_EQ(serial.count, 40'000u);
+    EXPECT_EQ(parallel.count, 40'000u);
+    EXPECT_DOUBLE_EQ(serial.sum, parallel.sum);
+}
+
+// Test the generator stage draws the same records as generateStudents() with the same seed
+TEST(PipelineTest, GenerateMatchesGenerateStudents) {
+    ThreadPool pool(0);
+    Pipeline pipeline(pool);
+    auto& raw = pipeline.channel<StudentRecord>(16);
+    std::vector<StudentRecord> records;
+    pipeline.add("generate", [&](StageStats& s) { return stages::generate(raw, 1000, 5, s); });
+    pipeline.add("collect", [&](StageStats& s) { return collect(raw, records, s); });
+    pipeline.run();
+
+    std::vector<Student> students = generateStudents(1000, pool, 5);
+    ASSERT_EQ(records.size(), students.size());
+    for (std::size_t i = 0; i < records.size(); i++) {
+        EXPECT_EQ(records[i].name, students[i].getName());
+        EXPECT_EQ(records[i].age, students[i].getAge());
+        EXPECT_EQ(records[i].grade, students[i].getGrade());
+    }
+}
+
+// Test an exception thrown by a stage closes the channels so the other stages end, and is rethrown by run()
+TEST(PipelineTest, StageExceptionIsRethrown) {
+    for (unsigned workers : {0u, 2u}) {
+        ThreadPool pool(workers);
+        Pipeline pipeline(pool);
+        Channel<int>& channel = pipeline.channel<int>(2);
+        std::atomic<int> sent{0};
+        pipeline.add("produce", [&](StageStats& s) { return produce(channel, 1'000'000, sent, s); });
+        pipeline.add("fail", [&](StageStats& s) { return failOnFirst(channel, s); });
+        EXPECT_THROW(pipeline.run(), std::runtime_error);
+        EXPECT_LT(sent.load(), 1'000'000);
+    }
+}
+
+// Test stages waiting on a channel nobody closes are ended and reported instead of hanging
+TEST(PipelineTest, UnclosedChannelIsReported) {
+    for (unsigned workers : {0u, 2u}) {
+        ThreadPool pool(workers);
+        Pipeline pipeline(pool);
+        Channel<int>& channel = pipeline.channel<int>(2, 2); // two producers declared, only one added
+        std::vector<int> seen;
+        std::atomic<int> sent{0};
+        std::size_t maxAhead = 0;
+        pipeline.add("produce", [&](StageStats& s) { return produce(channel, 10, sent, s); });
+        pipeline.add("consume", [&](StageStats& s) { return consume(channel, seen, sent, maxAhead, s); });
+        EXPECT_THROW(pipeline.run(), std::logic_error);
+        EXPECT_EQ(seen.size(), 10u);
+    }
+}
+
+// Test a stage whose factory throws is not kept, so the pipeline still runs the others
+TEST(PipelineTest, ThrowingFactoryAddsNoStage) {
+    ThreadPool pool(0);
+    Pipeline pipeline(pool);
+    Channel<int>& channel = pipeline.channel<int>(2);
+    std::vector<int> seen;
+    std::atomic<int> sent{0};
+    std::size_t maxAhead = 0;
+    pipeline.add("produce", [&](StageStats& s) { return produce(channel, 10, sent, s); });
+    EXPECT_THROW(pipeline.add("broken", [](StageStats&) -> StageTask { throw std::runtime_error("no stage"); }),
+                 std::runtime_error);
+    pipeline.add("consume", [&](StageStats& s) { return consume(channel, seen, sent, maxAhead, s); });
+    std::vector<StageStats> report = pipeline.run();
+    ASSERT_EQ(report.size(), 2u);
+    EXPECT_EQ(report[1].name, "consume");
+    EXPECT_EQ(seen.size(), 10u);
+}
+
+// Test a pipeline runs once: a second run() or add() is refused instead of resuming ended stages
+TEST(PipelineTest, RunsOnce) {
+    ThreadPool pool(0);
+    Pipeline pipeline(pool);
+    Channel<int>& channel = pipeline.channel<int>(2);
+    std::vector<int> seen;
+    std::atomic<int> sent{0};
+    std::size_t maxAhead = 0;
+    pipeline.add("produce", [&](StageStats& s) { return produce(channel, 10, sent, s); });
+    pipeline.add("consume", [&](StageStats& s) { return consume(channel, seen, sent, maxAhead, s); });
+    pipeline.run();
+    EXPECT_THROW(pipeline.run(), std::logic_error);
+    EXPECT_THROW(pipeline.add("late", [&](StageStats& s) { return produce(channel, 1, sent, s); }), std::logic_error);
+    EXPECT_EQ(seen.size(), 10u);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,101 @@
+#include "gtest/gtest.h"
+#include "DynamicArray.h"
+#include "GradeObserver.h"
+#include "Random.h"
+#include "StudentGenerator.h"
+
+#include <atomic>
+#include <climits>
+#include <set>
+#include <vector>
+
+using namespace oop;
+
+// Test equal seeds give equal sequences and default generators differ
+TEST(RandomTest, Seeding) {
+    Random a(123);
+    Random b(123);
+    for (int i = 0; i < 100; i++) {
+        EXPECT_EQ(a.getInt(0, 1'000'000), b.getInt(0, 1'000'000));
+    }
+    Random c;
+    Random d;
+    std::vector<int> fromC(20), fromD(20);
+    c.fillInts(fromC, 0, INT_MAX);
+    d.fillInts(fromD, 0, INT_MAX);
+    EXPECT_NE(fromC, fromD);
+}
+
+// Test values stay in range and cover it evenly
+TEST(RandomTest, Ranges) {
+    Random random(7);
+    std::vector<int> counts(8);
+    for (int i = 0; i < 80'000; i++) {
+        int value = random.getInt(18, 25);
+        ASSERT_GE(value, 18);
+        ASSERT_LE(value, 25);
+        counts[value - 18]++;
+    }
+    for (int count : counts) {
+        EXPECT_NEAR(count, 10'000, 500);
+    }
+    EXPECT_EQ(random.getInt(5, 5), 5);
+    int full = random.getInt(INT_MIN, INT_MAX);
+    EXPECT_GE(full, INT_MIN);
+
+    DynamicArray<double> doubles(10'000, defaultInit);
+    random.fillDoubles(doubles, -1.0, 1.0);
+    double total = 0;
+    for (double value : doubles) {
+        ASSERT_GE(value, -1.0);
+        ASSERT_LT(value, 1.0);
+        total += value;
+    }
+    EXPECT_NEAR(total / doubles.size(), 0.0, 0.05);
+}
+
+// Test generated populations depend on the seed only, not on the number of threads
+TEST(GenerateStudentsTest, ReproducibleAcrossThreadCounts) {
+    std::size_t n = 3 * studentBlockSize + 17;
+    std::vector<Student> serial = generateStudents(n, 1, 99);
+    std::vector<Student> parallel = generateStudents(n, 4, 99);
+    std::vector<Student> other = generateStudents(n, 4, 100);
+    ASSERT_EQ(serial.size(), n);
+    ASSERT_EQ(parallel.size(), n);
+    std::set<std::string_view> names;
+    std::size_t differences = 0;
+    for (std::size_t i = 0; i < n; i++) {
+        ASSERT_EQ(serial[i].getNameId(), parallel[i].getNameId());
+        ASSERT_EQ(serial[i].getAge(), parallel[i].getAge());
+        ASSERT_EQ(serial[i].getGrade(), parallel[i].getGrade());
+        ASSERT_GE(serial[i].getAge(), 18);
+        ASSERT_LE(serial[i].getAge(), 25);
+        names.insert(serial[i].getName());
+        differences += serial[i].getGrade() != other[i].getGrade();
+    }
+    EXPECT_EQ(names.size(), static_cast<std::size_t>(Student::randomNameCount));
+    EXPECT_GT(differences, n / 2);
+    EXPECT_TRUE(generateStudents(0, 2).empty());
+}
+
+// Test generated students are each constructed once with their final grade, without grade change events
+TEST(GenerateStudentsTest, NoGradeChanges) {
+    struct Events : GradeObserver {
+        std::atomic<long> added{0}, removed{0}, changed{0};
+        void onStudentAdded(const Student&) override { added++; }
+        void onGradeChanged(const Student&, double, double) override { changed++; }
+        void onStudentRemoved(const Student&) override { removed++; }
+    } events;
+    GradeObserverRegistry::add(&events);
+    std::size_t n = 2 * studentBlockSize + 5;
+    std::vector<Student> students = generateStudents(n, 3, 7);
+    GradeObserverRegistry::remove(&events);
+
+    EXPECT_EQ(events.changed.load(), 0);
+    EXPECT_EQ(events.added.load() - events.removed.load(), static_cast<long>(n));
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,95 @@
+#include "gtest/gtest.h"
+#include "SegmentedArray.h"
+#include "DynamicArray.h"
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <utility>
+
+using namespace oop;
+
+// Test appending adds chunks and never moves the elements already stored
+TEST(SegmentedArrayTest, StableReferences) {
+    SegmentedArray<int, 8> a;
+    a.push_back(1);
+    int* first = &a[0];
+    auto it = a.begin();
+    for (int i = 1; i < 100; i++) a.push_back(i + 1);
+
+    EXPECT_EQ(a.size(), 100u);
+    EXPECT_EQ(a.capacity(), 104u);
+    EXPECT_EQ(&a[0], first);
+    EXPECT_EQ(*it, 1);
+    EXPECT_EQ(a[99], 100);
+    EXPECT_EQ(std::accumulate(a.begin(), a.end(), 0), 5050);
+    EXPECT_EQ(a.end() - a.begin(), 100);
+    EXPECT_THROW(a.at(100), std::out_of_range);
+}
+
+// Test a chunk size that is not a power of two indexes correctly too
+TEST(SegmentedArrayTest, NonPowerOfTwoChunks) {
+    SegmentedArray<int, 7> a;
+    for (int i = 0; i < 50; i++) a.push_back(i);
+    for (int i = 0; i < 50; i++) EXPECT_EQ(a[i], i);
+    EXPECT_EQ(a.capacity(), 56u);
+    a.pop_back();
+    a.shrink_to_fit();
+    EXPECT_EQ(a.capacity(), 49u);
+    a.clear();
+    a.shrink_to_fit();
+    EXPECT_EQ(a.capacity(), 0u);
+}
+
+// Test copy, move, operator+, flatten and operator<< match DynamicArray
+TEST(SegmentedArrayTest, SameSurfaceAsDynamicArray) {
+    SegmentedArray<int, 4> a{1, 2, 3, 4, 5, 6};
+    SegmentedArray<int, 4> copy = a;
+    copy[0] = 10;
+    EXPECT_EQ(a[0], 1);
+
+    SegmentedArray<int, 4> moved = std::move(copy);
+    EXPECT_EQ(moved[0], 10);
+    EXPECT_TRUE(copy.empty());
+    copy = moved;
+    EXPECT_EQ(copy.size(), 6u);
+
+    DynamicArray<int> b{7, 8};
+    DynamicArray<int> c = a + b;
+    SegmentedArray<int, 4> d = b + a;
+    std::ostringstream os;
+    os << c << " " << d << " " << a;
+    EXPECT_EQ(os.str(), "[1, 2, 3, 4, 5, 6, 7, 8] [7, 8, 1, 2, 3, 4, 5, 6] [1, 2, 3, 4, 5, 6]");
+
+    DynamicArray<int> flat = a.flatten();
+    EXPECT_EQ(flat.size(), 6u);
+    EXPECT_TRUE(std::equal(flat.begin(), flat.end(), a.begin()));
+
+    std::sort(d.begin(), d.end());
+    EXPECT_EQ(d[0], 1);
+    EXPECT_EQ(d[7], 8);
+}
+
+// Test non-trivial elements are constructed, moved and destroyed exactly once
+TEST(SegmentedArrayTest, NonTrivialElements) {
+    auto shared = std::make_shared<int>(5);
+    {
+        SegmentedArray<std::shared_ptr<int>, 4> a;
+        for (int i = 0; i < 10; i++) a.push_back(shared);
+        EXPECT_EQ(shared.use_count(), 11);
+        SegmentedArray<std::shared_ptr<int>, 4> b = a;
+        EXPECT_EQ(shared.use_count(), 21);
+        b.pop_back();
+        EXPECT_EQ(shared.use_count(), 20);
+        SegmentedArray<std::string, 4> words(9, "word");
+        EXPECT_EQ(words.flatten()[8], "word");
+    }
+    EXPECT_EQ(shared.use_count(), 1);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
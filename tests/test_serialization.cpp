@@ -0,0 +1,177 @@
+#include "gtest/gtest.h"
+#include "ArraySerialization.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <sstream>
+
+using namespace oop;
+
+template<typename A>
+std::string streamed(const A& a) {
+    std::ostringstream os;
+    os << a;
+    return os.str();
+}
+
+// Test the formatter writes the same text as operator<< for integers
+TEST(ArrayFormatterTest, MatchesStreamOperator) {
+    DynamicArray<int> a = {1, -2, 300, std::numeric_limits<int>::min(), std::numeric_limits<int>::max()};
+    ArrayFormatter formatter;
+    EXPECT_EQ(formatter.format(a), streamed(a));
+    EXPECT_EQ(formatter.format(DynamicArray<int>()), "[]");
+    EXPECT_EQ(formatArray(DynamicArray<int>{7}), "[7]");
+
+    DynamicArrayVector v(4);
+    EXPECT_EQ(formatArray(v), streamed(v));
+}
+
+// Test streaming in blocks gives the same text as formatting at once
+TEST(ArrayFormatterTest, WriteLargeArray) {
+    std::mt19937 rng(3);
+    DynamicArray<long long> a(100'000, defaultInit);
+    for (long long& value : a) value = static_cast<long long>(rng()) * (rng() % 2 ? 1 : -1);
+    ArrayFormatter formatter;
+    std::ostringstream os;
+    formatter.write(os, a);
+    EXPECT_EQ(os.str(), streamed(a));
+    EXPECT_EQ(os.str(), formatter.format(a));
+}
+
+// Test text written by the formatter parses back to the same array
+TEST(ParseArrayTest, RoundTrip) {
+    DynamicArray<double> d = {0.1, -2.5, 1e300, std::numeric_limits<double>::denorm_min(), 3.0};
+    DynamicArray<double> parsed = parseArray<double>(formatArray(d));
+    ASSERT_EQ(parsed.size(), d.size());
+    for (std::size_t i = 0; i < d.size(); i++) {
+        EXPECT_EQ(parsed[i], d[i]);
+    }
+
+    DynamicArray<int> a = {5, -6, 7};
+    std::stringstream ss;
+    ss << a << " [ 8 ,9 ]";
+    DynamicArray<int> first = readArray<int>(ss);
+    DynamicArray<int> second = readArray<int>(ss);
+    EXPECT_EQ(formatArray(first), "[5, -6, 7]");
+    EXPECT_EQ(formatArray(second), "[8, 9]");
+    EXPECT_EQ(parseArray<int>("  [ ]  ").size(), 0u);
+}
+
+// Test malformed text is rejected
+TEST(ParseArrayTest, RejectsMalformedText) {
+    EXPECT_THROW(parseArray<int>(""), std::invalid_argument);
+    EXPECT_THROW(parseArray<int>("1, 2]"), std::invalid_argument);
+    EXPECT_THROW(parseArray<int>("[1, 2"), std::invalid_argument);
+    EXPECT_THROW(parseArray<int>("[1,, 2]"), std::invalid_argument);
+    EXPECT_THROW(parseArray<int>("[1, x]"), std::invalid_argument);
+    EXPECT_THROW(parseArray<int>("[1] 2"), std::invalid_argument);
+    EXPECT_THROW(parseArray<std::int8_t>("[300]"), std::invalid_argument);
+}
+
+// Test binary save and load round-trip and keep the header layout
+TEST(BinaryFormatTest, RoundTrip) {
+    DynamicArray<int> a(1000, defaultInit);
+    for (int i = 0; i < 1000; i++) a[i] = i * i - 500;
+    std::stringstream ss;
+    save(ss, a);
+    EXPECT_EQ(ss.str().size(), binary::headerSize + 1000 * sizeof(int));
+    EXPECT_EQ(ss.str().substr(0, 4), "OOPA");
+
+    DynamicArray<int> loaded = load<int>(ss);
+    ASSERT_EQ(loaded.size(), a.size());
+    EXPECT_EQ(std::memcmp(loaded.data(), a.data(), 1000 * sizeof(int)), 0);
+
+    std::stringstream empty;
+    save(empty, DynamicArray<double>());
+    EXPECT_EQ(load<double>(empty).size(), 0u);
+}
+
+// Test files from a machine of the other byte order are swapped on load
+TEST(BinaryFormatTest, ForeignByteOrder) {
+    DynamicArray<std::uint32_t> a = {0x01020304u, 0xAABBCCDDu};
+    std::stringstream ss;
+    save(ss, a);
+    std::string bytes = ss.str();
+    bytes[7] = static_cast<char>(binary::nativeOrder == binary::ByteOrder::Little ? binary::ByteOrder::Big
+                                                                                  : binary::ByteOrder::Little);
+    for (std::size_t i = 0; i < a.size(); i++) {
+        std::reverse(bytes.begin() + binary::headerSize + 4 * i, bytes.begin() + binary::headerSize + 4 * i + 4);
+    }
+    std::stringstream foreign(bytes);
+    DynamicArray<std::uint32_t> loaded = load<std::uint32_t>(foreign);
+    EXPECT_EQ(loaded[0], 0x01020304u);
+    EXPECT_EQ(loaded[1], 0xAABBCCDDu);
+}
+
+// Test invalid or mismatched files are rejected
+TEST(BinaryFormatTest, RejectsInvalidInput) {
+    DynamicArray<int> a = {1, 2, 3};
+    std::stringstream ss;
+    save(ss, a);
+    std::string bytes = ss.str();
+
+    std::stringstream wrongType(bytes);
+    EXPECT_THROW(load<float>(wrongType), std::runtime_error);
+
+    std::stringstream truncated(bytes.substr(0, bytes.size() - 1));
+    EXPECT_THROW(load<int>(truncated), std::runtime_error);
+
+    std::string badMagic = bytes;
+    badMagic[0] = 'X';
+    std::stringstream bad(badMagic);
+    EXPECT_THROW(load<int>(bad), std::runtime_error);
+
+    std::stringstream noHeader("OOP");
+    EXPECT_THROW(load<int>(noHeader), std::runtime_error);
+}
+
+// Test a corrupt element count fails on the missing payload instead of allocating it
+TEST(BinaryFormatTest, CorruptCount) {
+    DynamicArray<int> a = {1, 2, 3};
+    std::stringstream ss;
+    save(ss, a);
+    std::string bytes = ss.str();
+    bytes[8 + 5] = 0x10; // count 2^44 + 3
+    std::stringstream corrupt(bytes);
+    EXPECT_THROW(load<int>(corrupt), std::runtime_error);
+
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "oop_test_corrupt_count.bin";
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << bytes;
+    }
+    EXPECT_THROW(load<int>(path), std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+// Test arrays larger than the first chunk grow while the payload is read
+TEST(BinaryFormatTest, LargeStream) {
+    DynamicArray<double> a(600'000, 0.0);
+    for (std::size_t i = 0; i < a.size(); i++) a[i] = static_cast<double>(i) * 0.5;
+    std::stringstream ss;
+    save(ss, a);
+    DynamicArray<double> loaded = load<double>(ss);
+    ASSERT_EQ(loaded.size(), a.size());
+    EXPECT_DOUBLE_EQ(loaded[599'999], 599'999 * 0.5);
+    EXPECT_TRUE(std::equal(a.begin(), a.end(), loaded.begin()));
+}
+
+// Test saving to and loading from a file
+TEST(BinaryFormatTest, Files) {
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "oop_test_serialization.bin";
+    DynamicArray<double> a = {1.5, 2.5, -3.25};
+    save(path, a);
+    DynamicArray<double> loaded = load<double>(path);
+    std::filesystem::remove(path);
+    EXPECT_EQ(formatArray(loaded), formatArray(a));
+    EXPECT_THROW(load<double>(path), std::runtime_error);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
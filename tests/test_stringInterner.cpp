@@ -0,0 +1,71 @@
+#include "gtest/gtest.h"
+#include "Student.h"
+#include "StringInterner.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace oop;
+
+// Test equal strings get the same ID and views outlive later insertions
+TEST(StringInternerTest, InternAndView) {
+    StringInterner interner;
+    StringInterner::Id alice = interner.intern("Alice");
+    StringInterner::Id bob = interner.intern("Bob");
+    EXPECT_NE(alice, bob);
+    EXPECT_EQ(interner.intern(std::string("Alice")), alice);
+    EXPECT_EQ(interner.size(), 2u);
+
+    std::string_view view = interner.view(alice);
+    for (int i = 0; i < 10'000; i++) {
+        interner.intern("name" + std::to_string(i)); // fills several blocks
+    }
+    EXPECT_EQ(view, "Alice");
+    EXPECT_EQ(view.data(), interner.view(alice).data());
+    EXPECT_EQ(interner.view(interner.intern("name9999")), "name9999");
+    EXPECT_EQ(interner.find("Bob"), bob);
+    EXPECT_FALSE(interner.find("Carol").has_value());
+    EXPECT_EQ(interner.intern(""), interner.intern(""));
+}
+
+// Test threads interning the same strings agree on the IDs
+TEST(StringInternerTest, ConcurrentIntern) {
+    StringInterner interner;
+    std::vector<std::vector<StringInterner::Id>> ids(4);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < 2'000; i++) {
+                ids[t].push_back(interner.intern("s" + std::to_string(i)));
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    EXPECT_EQ(interner.size(), 2'000u);
+    for (int t = 1; t < 4; t++) {
+        EXPECT_EQ(ids[t], ids[0]);
+    }
+    for (int i = 0; i < 2'000; i++) {
+        EXPECT_EQ(interner.view(ids[0][i]), "s" + std::to_string(i));
+    }
+}
+
+// Test students share the storage of equal names
+TEST(StudentNameTest, NamesAreInterned) {
+    Student a("Alice", 20, 8.0);
+    Student b("Alice", 21, 7.0);
+    Student c("Bob", 22, 6.0);
+    EXPECT_TRUE(sameName(a, b));
+    EXPECT_FALSE(sameName(a, c));
+    EXPECT_EQ(a.getName().data(), b.getName().data());
+
+    c.setName("Alice");
+    EXPECT_TRUE(sameName(a, c));
+    EXPECT_EQ(c.getName(), "Alice");
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
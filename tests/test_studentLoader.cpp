@@ -0,0 +1,158 @@
+#include "gtest/gtest.h"
+#include "StudentLoader.h"
+#include "TempFile.h"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace oop;
+
+using StudentLoaderTest = TempFileTest;
+
+// Test the Student constructor rejects invalid values instead of creating the student
+TEST(StudentValidationTest, ConstructorThrows) {
+    EXPECT_THROW(Student("", 20, 5.0), std::invalid_argument);
+    EXPECT_THROW(Student("Ana", -1, 5.0), std::invalid_argument);
+    EXPECT_THROW(Student("Ana", 121, 5.0), std::invalid_argument);
+    EXPECT_THROW(Student("Ana", 20, 10.5), std::invalid_argument);
+    EXPECT_NO_THROW(Student("Ana", 120, 10.0));
+}
+
+// Test a CSV file is loaded with its header, blank lines and CRLF endings, and bad rows are reported by line
+TEST_F(StudentLoaderTest, CsvWithRejections) {
+    write("name,age,grade\n"
+          "Alice,20,8.5\n"
+          "Bob, 22 , 7\r\n"
+          "\n"
+          "Carol,abc,9\n"
+          "Dave,30\n"
+          ",25,5\n"
+          "Eve,200,5\n"
+          "Frank,21,11\n"
+          "Grace,19,6,extra\n"
+          "Heidi,23,4.25");
+    StudentLoader loader(path);
+    EXPECT_EQ(loader.format(), StudentLoader::Format::Csv);
+
+    std::vector<Student> students;
+    RejectionReport report = loader.load(students);
+    ASSERT_EQ(students.size(), 3u);
+    EXPECT_EQ(students[0].getName(), "Alice");
+    EXPECT_EQ(students[1].getName(), "Bob");
+    EXPECT_EQ(students[1].getAge(), 22);
+    EXPECT_DOUBLE_EQ(students[2].getGrade(), 4.25);
+
+    EXPECT_EQ(report.accepted, 3u);
+    ASSERT_EQ(report.rejected(), 6u);
+    EXPECT_EQ(report.rejections[0].line, 5u);
+    EXPECT_EQ(report.rejections[0].reason, RejectReason::BadAge);
+    EXPECT_EQ(report.rejections[0].text, "Carol,abc,9");
+    EXPECT_EQ(report.rejections[1].reason, RejectReason::MissingField);
+    EXPECT_EQ(report.rejections[2].reason, RejectReason::EmptyName);
+    EXPECT_EQ(report.rejections[3].line, 8u);
+    EXPECT_EQ(report.rejections[3].reason, RejectReason::AgeOutOfRange);
+    EXPECT_EQ(report.rejections[4].reason, RejectReason::GradeOutOfRange);
+    EXPECT_EQ(report.rejections[5].reason, RejectReason::ExtraField);
+    EXPECT_EQ(report.count(RejectReason::AgeOutOfRange), 1u);
+
+    std::ostringstream out;
+    out << report;
+    EXPECT_NE(out.str().find("line 8: age out of range: Eve,200,5"), std::string::npos);
+}
+
+// Test many small chunks parsed on several threads give the same rows, in order, with correct line numbers
+TEST_F(StudentLoaderTest, ChunkedParallelParse) {
+    std::string csv;
+    std::size_t gradesTooHigh = 0;
+    for (int i = 0; i < 20'000; i++) {
+        if (i % 1000 == 999) {
+            csv += "Bad" + std::to_string(i) + ",x,1\n";
+        } else {
+            gradesTooHigh += i % 11 == 10; // a grade of 10.5
+            csv += "Student" + std::to_string(i) + "," + std::to_string(18 + i % 10) + "," + std::to_string(i % 11) + ".5\n";
+        }
+    }
+    write(csv);
+    StudentLoader loader(path);
+    ThreadPool pool(4);
+
+    StudentTable table;
+    RejectionReport report = loader.load(table, pool, 4096);
+    EXPECT_EQ(report.count(RejectReason::BadAge), 20u);
+    EXPECT_EQ(report.count(RejectReason::GradeOutOfRange), gradesTooHigh);
+    ASSERT_EQ(table.size(), 20'000u - 20u - gradesTooHigh);
+    EXPECT_EQ(report.accepted, table.size());
+    for (std::size_t i = 1; i < report.rejections.size(); i++) {
+        ASSERT_LT(report.rejections[i - 1].line, report.rejections[i].line);
+    }
+    for (const Rejection& r : report.rejections) {
+        if (r.reason == RejectReason::BadAge) {
+            EXPECT_EQ(r.text, "Bad" + std::to_string(r.line - 1) + ",x,1");
+        }
+    }
+
+    std::size_t rows = 0;
+    loader.forEachBatch([&](const StudentColumns& batch) {
+        for (std::size_t i = 0; i < batch.size(); i++) {
+            ASSERT_EQ(batch.names[i], table.getName(table.getNameIds()[rows + i]));
+        }
+        rows += batch.size();
+    }, pool, 4096);
+    EXPECT_EQ(rows, table.size());
+}
+
+// Test students saved in the binary format load back through the same path, with bad records reported
+TEST_F(StudentLoaderTest, BinaryRoundTrip) {
+    StudentTable table;
+    table.append("Alice", 20, 8.5);
+    table.append("Bob", 22, 7.0);
+    table.append("Carol", 24, 9.75);
+    saveStudentsBinary(path, table);
+
+    StudentLoader loader(path);
+    EXPECT_EQ(loader.format(), StudentLoader::Format::Binary);
+    StudentTable loaded;
+    RejectionReport report = loader.load(loaded);
+    EXPECT_TRUE(report.clean());
+    ASSERT_EQ(loaded.size(), 3u);
+    EXPECT_EQ(loaded[2].getName(), "Carol");
+    EXPECT_DOUBLE_EQ(loaded[2].getGrade(), 9.75);
+
+    // Corrupt the grade of the second record and the name offset of the third
+    std::string bytes;
+    {
+        std::ifstream file(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    studentBinary::store<double>(42.0, bytes.data() + studentBinary::headerSize + studentBinary::recordSize + 16);
+    studentBinary::store<std::uint32_t>(1000, bytes.data() + studentBinary::headerSize + 2 * studentBinary::recordSize);
+    std::vector<Student> students;
+    report = StudentLoader(std::string_view(bytes)).load(students);
+    ASSERT_EQ(students.size(), 1u);
+    ASSERT_EQ(report.rejected(), 2u);
+    EXPECT_EQ(report.rejections[0].line, 2u);
+    EXPECT_EQ(report.rejections[0].reason, RejectReason::GradeOutOfRange);
+    EXPECT_EQ(report.rejections[1].reason, RejectReason::BadRecord);
+
+    bytes.resize(bytes.size() - 40); // cut into the records
+    EXPECT_THROW(StudentLoader{std::string_view(bytes)}, std::runtime_error);
+}
+
+// Test empty inputs load nothing
+TEST_F(StudentLoaderTest, EmptyFile) {
+    write("");
+    std::vector<Student> students;
+    RejectionReport report = StudentLoader(path).load(students);
+    EXPECT_TRUE(students.empty());
+    EXPECT_EQ(report.accepted, 0u);
+    EXPECT_TRUE(report.clean());
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
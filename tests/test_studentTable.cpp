@@ -0,0 +1,175 @@
+#include "gtest/gtest.h"
+#include "StudentTable.h"
+
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+using namespace oop;
+
+StudentTable sampleTable(StringInterner& interner = StringInterner::global()) {
+    StudentTable table(interner);
+    table.append("Rodrigo", 18, 9.0);
+    table.append("Ricardo", 22, 6.0);
+    table.append("Rodrigo", 25, 3.0);
+    table.append("Raul", 30, 7.5);
+    return table;
+}
+
+// Test rows expose the values and names are stored once in the interner of the table
+TEST(StudentTableTest, AppendAndRows) {
+    StringInterner interner;
+    StudentTable table = sampleTable(interner);
+    EXPECT_EQ(table.size(), 4u);
+    EXPECT_EQ(interner.size(), 3u);
+    EXPECT_EQ(table[0].getName(), "Rodrigo");
+    EXPECT_EQ(table[0].getNameId(), table[2].getNameId());
+    EXPECT_EQ(table[1].getAge(), 22);
+    EXPECT_DOUBLE_EQ(table[3].getGrade(), 7.5);
+
+    StudentTable::Row row = table[1];
+    row.setName("Andres");
+    row.setAge(23);
+    row.setGrade(8.0);
+    row.setAge(999); // rejected like Student::setAge
+    EXPECT_EQ(table[1].getName(), "Andres");
+    EXPECT_EQ(table[1].getAge(), 23);
+    EXPECT_DOUBLE_EQ(table[1].getGrade(), 8.0);
+
+    const StudentTable& constTable = table;
+    StudentTable::ConstRow constRow = constTable[3];
+    EXPECT_EQ(constRow.getName(), "Raul");
+}
+
+// Test the scans and aggregates
+TEST(StudentTableTest, Aggregates) {
+    StudentTable table = sampleTable();
+    EXPECT_DOUBLE_EQ(table.averageGrade(), 25.5 / 4);
+    EXPECT_EQ(table.countAgeInRange(18, 25), 3u);
+    EXPECT_EQ(table.countAgeInRange(26, 100), 1u);
+    EXPECT_EQ(table.countAgeInRange(25, 18), 0u);
+    EXPECT_DOUBLE_EQ(table.averageGradeForAges(20, 30), 16.5 / 3);
+    EXPECT_DOUBLE_EQ(table.averageGradeForAges(40, 50), 0.0);
+    EXPECT_EQ(table.countGradeAtLeast(7.0), 2u);
+    EXPECT_EQ(table.countName("Rodrigo"), 2u);
+    EXPECT_EQ(table.countName("Nobody"), 0u);
+    EXPECT_DOUBLE_EQ(StudentTable().averageGrade(), 0.0);
+}
+
+// Test the unrolled aggregates on a table longer than one block
+TEST(StudentTableTest, LargeTable) {
+    StudentTable table;
+    std::vector<std::string_view> names;
+    std::vector<int> ages;
+    std::vector<double> grades;
+    for (int i = 0; i < 100'003; i++) {
+        names.push_back(i % 2 ? "Odd" : "Even");
+        ages.push_back(18 + i % 10);
+        grades.push_back(i % 11);
+    }
+    table.appendColumns(names, ages, grades);
+    double total = 0;
+    for (double grade : grades) total += grade;
+    EXPECT_DOUBLE_EQ(table.averageGrade(), total / grades.size());
+    EXPECT_EQ(table.countAgeInRange(18, 19), 20'002u);
+    EXPECT_EQ(table.countName("Odd"), 50'001u);
+    EXPECT_THROW(table.appendColumns(names, ages, std::vector<double>{}), std::invalid_argument);
+}
+
+// Test conversion to and from Student objects, sharing the global name IDs
+TEST(StudentTableTest, ConvertsStudents) {
+    std::vector<Student> students;
+    students.emplace_back("Alice", 20, 8.0);
+    students.emplace_back("Bob", 21, 5.5);
+    students.emplace_back("Alice", 22, 9.5);
+
+    StudentTable table(students);
+    EXPECT_EQ(table.size(), 3u);
+    EXPECT_EQ(table[0].getNameId(), table[2].getNameId());
+    EXPECT_EQ(table[0].getNameId(), students[0].getNameId());
+
+    std::vector<Student> back = table.toStudents();
+    ASSERT_EQ(back.size(), 3u);
+    for (std::size_t i = 0; i < back.size(); i++) {
+        EXPECT_EQ(back[i].getName(), students[i].getName());
+        EXPECT_EQ(back[i].getAge(), students[i].getAge());
+        EXPECT_DOUBLE_EQ(back[i].getGrade(), students[i].getGrade());
+    }
+    EXPECT_EQ(table[1].toStudent().getName(), "Bob");
+}
+
+// Test copies keep their rows when the original is cleared
+TEST(StudentTableTest, CopyAndMove) {
+    StudentTable table = sampleTable();
+    StudentTable copy = table;
+    table.clear();
+    EXPECT_EQ(copy.countName("Rodrigo"), 2u);
+    copy.append("Rodrigo", 20, 5.0);
+
+    StudentTable moved = std::move(copy);
+    EXPECT_EQ(moved.countName("Rodrigo"), 3u);
+    table = moved;
+    EXPECT_EQ(table.countName("Raul"), 1u);
+}
+
+// Test appending one invalid row throws like the Student constructor and leaves the table unchanged
+TEST(StudentTableTest, AppendRejectsInvalidRow) {
+    StudentTable table = sampleTable();
+    EXPECT_THROW(table.append("", -5, 42.0), std::invalid_argument);
+    EXPECT_THROW(table.append("Ana", 121, 5.0), std::invalid_argument);
+    EXPECT_THROW(table.append("Ana", 20, 10.5), std::invalid_argument);
+    EXPECT_EQ(table.size(), 4u);
+    EXPECT_DOUBLE_EQ(table.averageGrade(), 6.375);
+    EXPECT_EQ(table.toStudents().size(), 4u);
+}
+
+// Test appending columns with an invalid row throws and appends none of the rows
+TEST(StudentTableTest, AppendColumnsRejectsInvalidRow) {
+    StudentTable table = sampleTable();
+    std::vector<std::string_view> names{"Ana", "Bea", ""};
+    std::vector<int> ages{20, 21, 22};
+    std::vector<double> grades{5.0, 6.0, 7.0};
+    EXPECT_THROW(table.appendColumns(names, ages, grades), std::invalid_argument);
+    names[2] = "Carla";
+    grades[1] = -1.0;
+    EXPECT_THROW(table.appendColumns(names, ages, grades), std::invalid_argument);
+    EXPECT_EQ(table.size(), 4u);
+    grades[1] = 6.0;
+    table.appendColumns(names, ages, grades);
+    EXPECT_EQ(table.size(), 7u);
+}
+
+// Test batch setters apply the valid updates and report the others in the error mask
+TEST(StudentTableTest, BatchUpdates) {
+    StudentTable table = sampleTable();
+    std::vector<std::size_t> rows{0, 1, 7, 2, 1};
+    std::vector<int> ages{19, -3, 20, 121, 24};
+    UpdateReport report = table.setAges(rows, ages);
+    EXPECT_EQ(report.applied, 2u);
+    EXPECT_EQ(report.badIndices, 1u);
+    EXPECT_EQ(report.badValues, 2u);
+    EXPECT_EQ(report.refusedUpdates(), (std::vector<std::size_t>{1, 2, 3}));
+    EXPECT_EQ(table[0].getAge(), 19);
+    EXPECT_EQ(table[1].getAge(), 24); // the later update of the same row wins
+    EXPECT_EQ(table[2].getAge(), 25);
+
+    std::vector<double> grades(rows.size(), 10.5);
+    grades[4] = 4.0;
+    report = table.setGrades(rows, grades);
+    EXPECT_EQ(report.applied, 1u);
+    EXPECT_DOUBLE_EQ(table[1].getGrade(), 4.0);
+
+    std::vector<std::string_view> names{"Ana", "", "Bea", "Carla", "Dora"};
+    report = table.setNames(rows, names);
+    EXPECT_EQ(report.applied, 3u);
+    EXPECT_TRUE(report.isRefused(1));
+    EXPECT_EQ(table[2].getName(), "Carla");
+    EXPECT_EQ(table[1].getName(), "Dora");
+
+    EXPECT_THROW(table.setAges(rows, std::vector<int>{1}), std::invalid_argument);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}